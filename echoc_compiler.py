@@ -5,17 +5,30 @@ import os
 # The list of our C source files, in the correct order
 C_SOURCE_FILES = [
     "src_c/header.c",
+    "src_c/intern.c", # Process-wide interned names and keys
     "src_c/lexer.c",
+    "src_c/source_unit.c", # Parse-once token cache per module
+    "src_c/unit_cache.c", # Persistent on-disk token cache
     "src_c/parser_utils.c",
     "src_c/scope.c",
+    "src_c/arena.c", # Statement-scoped scratch allocator
+    "src_c/object_shape.c", # Blueprint shapes and attribute inline caches
+    "src_c/coro_context.c", # Coroutine stacks (ucontext/fibers)
     "src_c/dictionary.c",
     "src_c/value_utils.c",
+    "src_c/string_value.c", # Length-prefixed, reference-counted string values
+    "src_c/string_template.c", # Precompiled %{...} interpolation templates
+    "src_c/packed_array.c", # Contiguous int64/double arrays
     "src_c/modules/builtins.c",
     "src_c/modules/weaver.c",
+    "src_c/modules/numeric.c", # Vectorized kernels over packed arrays
+    "src_c/modules/string_methods.c", # Native methods of string values
     "src_c/module_loader.c", # Added module loader
     "src_c/expression_parser.c",
+    "src_c/bytecode_vm.c", # Expression VM for --vm
     "src_c/statement_parser.c",
     "src_c/interpreter.c",  # Should be the 'clean' version after stubs are removed
+    "src_c/echoc_api.c", # Embedding API (echoc.h); main.c is its command-line client
     "src_c/main.c",
 ]
 
@@ -23,11 +36,13 @@ C_SOURCE_FILES = [
 DEBUG_MODE = True  # Set to False for release builds
 
 def main():
+    # --lib builds libechoc.a for embedding (see src_c/echoc.h) instead of the executable.
+    build_library = "--lib" in sys.argv[1:]
     executable_name = "EchoC"
     if sys.platform == "win32":
         executable_name += ".exe"
 
-    print(f"--- Building EchoC ---")
+    print(f"--- Building {'libechoc' if build_library else 'EchoC'} ---")
     
     object_files = []
 
@@ -35,6 +50,8 @@ def main():
     for c_file in C_SOURCE_FILES:
         obj_file = c_file.replace(".c", ".o")
         compile_command = ["gcc", "-std=c11", "-c", c_file, "-o", obj_file, "-I", "src_c", "-lm", "-D_POSIX_C_SOURCE=200809L", "-D_DEFAULT_SOURCE"]
+        if build_library:
+            compile_command.extend(["-DECHOC_LIBRARY", "-fPIC"])
         if DEBUG_MODE:
             print(f"    -> Compiling {c_file} in DEBUG mode.")
             compile_command.extend(["-g", "-DDEBUG_ECHOC", "-Wall", "-Wextra", "-Wpedantic", "-fsanitize=address"])
@@ -48,6 +65,23 @@ def main():
             print(f"Error: Compilation failed for {c_file}.")
             sys.exit(1)
 
+    if build_library:
+        # Hosts link with -lechoc -lm (plus -fsanitize=address for a DEBUG_MODE build).
+        print(f"[2] Archiving object files into 'libechoc.a'...")
+        if os.path.exists("libechoc.a"):
+            os.remove("libechoc.a")
+        try:
+            subprocess.run(["ar", "rcs", "libechoc.a"] + object_files, check=True)
+            print(f"    -> Success! 'libechoc.a' is ready. Include 'src_c/echoc.h'.")
+        except subprocess.CalledProcessError:
+            print("Error: Archiving failed.")
+            sys.exit(1)
+        for obj in object_files:
+            if os.path.exists(obj):
+                os.remove(obj)
+        print("\n--- Build complete ---")
+        return
+
     # Link all object files into the final executable.
     print(f"[2] Linking object files into '{executable_name}'...")
     link_command = ["gcc", "-std=c11"] + object_files + ["-o", executable_name, "-lm"]
@@ -0,0 +1,78 @@
+// src_c/arena.c
+#include "arena.h"
+#include <stddef.h> // For max_align_t
+
+#define ARENA_BLOCK_SIZE 4096 // Bytes per block including its header; bigger requests get their own block
+#define ARENA_ALIGN (sizeof(max_align_t))
+
+static size_t arena_align_up(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+void arena_init(Arena* arena) {
+    arena->head = NULL;
+    arena->spare = NULL;
+}
+
+static ArenaBlock* arena_new_block(Arena* arena, size_t size) {
+    ArenaBlock* block;
+    if (arena->spare && arena->spare->size >= size) {
+        block = arena->spare;
+        arena->spare = NULL;
+    } else {
+        size_t capacity = size > ARENA_BLOCK_SIZE - sizeof(ArenaBlock) ? size : ARENA_BLOCK_SIZE - sizeof(ArenaBlock);
+        block = malloc(sizeof(ArenaBlock) + capacity);
+        if (!block) report_error("System", "Failed to allocate memory for scratch arena.", NULL);
+        block->size = capacity;
+    }
+    block->used = 0;
+    block->next = arena->head;
+    arena->head = block;
+    return block;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = arena_align_up(size > 0 ? size : 1);
+    ArenaBlock* block = arena->head;
+    if (!block || block->size - block->used < size) block = arena_new_block(arena, size);
+    void* ptr = block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+char* arena_strdup(Arena* arena, const char* str) {
+    size_t len = strlen(str);
+    char* copy = arena_alloc(arena, len + 1);
+    memcpy(copy, str, len + 1);
+    return copy;
+}
+
+ArenaMark arena_mark(const Arena* arena) {
+    ArenaMark mark = { arena->head, arena->head ? arena->head->used : 0 };
+    return mark;
+}
+
+void arena_release(Arena* arena, ArenaMark mark) {
+    while (arena->head != mark.block) {
+        ArenaBlock* block = arena->head;
+        arena->head = block->next;
+        if (!arena->spare || arena->spare->size < block->size) { // Keep the biggest emptied block
+            free(arena->spare);
+            arena->spare = block;
+        } else {
+            free(block);
+        }
+    }
+    if (arena->head) arena->head->used = mark.used;
+}
+
+void arena_reset(Arena* arena) {
+    ArenaMark empty = { NULL, 0 };
+    arena_release(arena, empty);
+}
+
+void arena_free(Arena* arena) {
+    arena_reset(arena);
+    free(arena->spare);
+    arena->spare = NULL;
+}
@@ -0,0 +1,41 @@
+// src_c/arena.h
+#ifndef ECHOC_ARENA_H
+#define ECHOC_ARENA_H
+
+#include "header.h" // Provides Arena, ArenaBlock
+
+// Statement-scoped scratch memory. interpret_statement marks interpreter->scratch
+// on entry and releases back to the mark when the statement is done, so strings
+// that only live while one statement runs (names copied off the current token,
+// for instance) cost a pointer bump instead of a malloc/free pair. Anything that
+// can outlive the statement -- values, scopes, bound methods -- must still be
+// heap-allocated: a value stored from the arena would dangle after the release.
+// Releases are LIFO, which nested statements (function bodies run from inside an
+// expression) respect; coroutines interleave, so each one has its own arena.
+
+typedef struct {
+    ArenaBlock* block;
+    size_t used;
+} ArenaMark;
+
+// An all-zero Arena is empty and ready to use; arena_init just spells that out.
+void arena_init(Arena* arena);
+
+// 'size' bytes aligned for any type, valid until the arena is released past them.
+void* arena_alloc(Arena* arena, size_t size);
+
+// Copy of 'str' in the arena.
+char* arena_strdup(Arena* arena, const char* str);
+
+ArenaMark arena_mark(const Arena* arena);
+
+// Frees everything allocated since 'mark'. One emptied block is kept for reuse.
+void arena_release(Arena* arena, ArenaMark mark);
+
+// Releases everything, e.g. after a fatal error skipped the statements' releases.
+void arena_reset(Arena* arena);
+
+// Returns all blocks to the heap. The arena is empty afterwards.
+void arena_free(Arena* arena);
+
+#endif // ECHOC_ARENA_H
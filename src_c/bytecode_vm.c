@@ -0,0 +1,566 @@
+// src_c/bytecode_vm.c
+// Expression compiler and stack VM used by the --vm execution mode.
+//
+// Expressions are compiled once, straight from a SourceUnit's cached tokens, and the
+// chunk is cached on the unit by its first token index. Only side-effect-free
+// expressions over numbers, booleans and variables are compiled; everything else
+// (calls, strings, containers, attribute access, await) stays on the tree-walker.
+// At run time the VM bails out ("deopts") whenever an operand is not an int, float
+// or bool, or an operation would raise (e.g. division by zero). Because nothing has
+// been consumed at that point, the tree-walker then re-evaluates the expression and
+// reports exactly the error it always did.
+#include "bytecode_vm.h"
+#include "source_unit.h"
+#include "scope.h" // For symbol_table_get_token
+
+#define BYTECODE_MAX_STACK 64   // Deeper expressions are left to the tree-walker
+#define BYTECODE_MAX_DEOPTS 8   // After this many bailouts a chunk is retired
+
+// Marks a start token whose expression cannot (or should no longer) run on the VM.
+static BytecodeChunk bytecode_not_compilable;
+
+typedef struct {
+    SourceUnit* unit;
+    int pos;            // Index of the token being looked at
+    BytecodeChunk* chunk;
+    int code_capacity;
+    int const_capacity;
+    int name_capacity;
+    int stack_depth;
+    int op_count;       // Operators emitted; a lone operand is not worth compiling
+    bool failed;
+} ExprCompiler;
+
+void bytecode_chunk_free(BytecodeChunk* chunk) {
+    if (!chunk || chunk == &bytecode_not_compilable) return;
+    free(chunk->code);
+    free(chunk->consts);
+    free(chunk->names);
+    free(chunk);
+}
+
+// --- Compiler ---
+
+static const Token* compiler_peek(ExprCompiler* c) {
+    return &source_unit_token_at(c->unit, c->pos)->token;
+}
+
+static void compiler_advance(ExprCompiler* c) {
+    if (compiler_peek(c)->type != TOKEN_EOF) c->pos++;
+}
+
+static void compiler_adjust_stack(ExprCompiler* c, int delta) {
+    c->stack_depth += delta;
+    if (c->stack_depth > c->chunk->max_stack) c->chunk->max_stack = c->stack_depth;
+    if (c->chunk->max_stack > BYTECODE_MAX_STACK) c->failed = true;
+}
+
+static void compiler_emit(ExprCompiler* c, int word) {
+    BytecodeChunk* chunk = c->chunk;
+    if (chunk->code_length == c->code_capacity) {
+        c->code_capacity = c->code_capacity ? c->code_capacity * 2 : 16;
+        int* new_code = realloc(chunk->code, c->code_capacity * sizeof(int));
+        if (!new_code) report_error("System", "Failed to grow bytecode buffer", NULL);
+        chunk->code = new_code;
+    }
+    chunk->code[chunk->code_length++] = word;
+}
+
+static void compiler_emit_op(ExprCompiler* c, OpCode op) {
+    compiler_emit(c, op);
+    switch (op) {
+        case OP_NEG: case OP_NOT: break;                // pop 1, push 1
+        case OP_SELECT: compiler_adjust_stack(c, -2); break;
+        case OP_RETURN: break;
+        default: compiler_adjust_stack(c, -1); break;   // Binary operators: pop 2, push 1
+    }
+    if (op != OP_RETURN) c->op_count++;
+}
+
+static void compiler_emit_const(ExprCompiler* c, Value v) {
+    BytecodeChunk* chunk = c->chunk;
+    if (chunk->const_count == c->const_capacity) {
+        c->const_capacity = c->const_capacity ? c->const_capacity * 2 : 4;
+        Value* new_consts = realloc(chunk->consts, c->const_capacity * sizeof(Value));
+        if (!new_consts) report_error("System", "Failed to grow bytecode constant pool", NULL);
+        chunk->consts = new_consts;
+    }
+    chunk->consts[chunk->const_count] = v;
+    compiler_emit(c, OP_LOAD_CONST);
+    compiler_emit(c, chunk->const_count++);
+    compiler_adjust_stack(c, 1);
+}
+
+static void compiler_emit_name(ExprCompiler* c, const Token* name_token) {
+    BytecodeChunk* chunk = c->chunk;
+    int index = -1;
+    for (int i = 0; i < chunk->name_count; ++i) {
+        if (chunk->names[i]->value == name_token->value) { index = i; break; } // Token values are interned
+    }
+    if (index < 0) {
+        if (chunk->name_count == c->name_capacity) {
+            c->name_capacity = c->name_capacity ? c->name_capacity * 2 : 4;
+            const Token** new_names = realloc(chunk->names, c->name_capacity * sizeof(const Token*));
+            if (!new_names) report_error("System", "Failed to grow bytecode name table", NULL);
+            chunk->names = new_names;
+        }
+        index = chunk->name_count;
+        chunk->names[chunk->name_count++] = name_token;
+    }
+    compiler_emit(c, OP_LOAD_NAME);
+    compiler_emit(c, index);
+    compiler_adjust_stack(c, 1);
+}
+
+// The compile_* functions mirror the interpret_*_expr precedence chain token for
+// token, so a compiled expression ends exactly where the tree-walker's would.
+static void compile_conditional(ExprCompiler* c);
+
+static void compile_primary(ExprCompiler* c) {
+    const Token* tok = compiler_peek(c);
+    Value v;
+    switch (tok->type) {
+        case TOKEN_INTEGER:
+            v.type = VAL_INT; v.as.integer = atol(tok->value);
+            compiler_emit_const(c, v);
+            compiler_advance(c);
+            return;
+        case TOKEN_FLOAT:
+            v.type = VAL_FLOAT; v.as.floating = atof(tok->value);
+            compiler_emit_const(c, v);
+            compiler_advance(c);
+            return;
+        case TOKEN_TRUE:
+        case TOKEN_FALSE:
+            v.type = VAL_BOOL; v.as.bool_val = (tok->type == TOKEN_TRUE);
+            compiler_emit_const(c, v);
+            compiler_advance(c);
+            return;
+        case TOKEN_ID:
+            if (strcmp(tok->value, "super") == 0) { c->failed = true; return; }
+            compiler_emit_name(c, tok);
+            compiler_advance(c);
+            return;
+        case TOKEN_LPAREN:
+            compiler_advance(c);
+            if (compiler_peek(c)->type == TOKEN_RPAREN) { c->failed = true; return; } // Empty tuple
+            compile_conditional(c);
+            if (c->failed) return;
+            if (compiler_peek(c)->type != TOKEN_RPAREN) { c->failed = true; return; } // Tuple or syntax error
+            compiler_advance(c);
+            return;
+        default:
+            c->failed = true; // Strings, null, containers, super, ...
+            return;
+    }
+}
+
+static void compile_postfix(ExprCompiler* c) {
+    compile_primary(c);
+    if (c->failed) return;
+    TokenType next = compiler_peek(c)->type;
+    if (next == TOKEN_LBRACKET || next == TOKEN_DOT || next == TOKEN_LPAREN) c->failed = true;
+}
+
+static void compile_power(ExprCompiler* c) {
+    compile_postfix(c);
+    if (c->failed) return;
+    if (compiler_peek(c)->type == TOKEN_POWER) {
+        compiler_advance(c);
+        compile_power(c); // Right-associative
+        if (c->failed) return;
+        compiler_emit_op(c, OP_POW);
+    }
+}
+
+static void compile_unary(ExprCompiler* c) {
+    TokenType type = compiler_peek(c)->type;
+    if (type == TOKEN_NOT || type == TOKEN_MINUS) {
+        compiler_advance(c);
+        compile_unary(c);
+        if (c->failed) return;
+        compiler_emit_op(c, type == TOKEN_NOT ? OP_NOT : OP_NEG);
+        return;
+    }
+    compile_power(c);
+}
+
+static void compile_multiplicative(ExprCompiler* c) {
+    compile_unary(c);
+    while (!c->failed) {
+        TokenType type = compiler_peek(c)->type;
+        if (type != TOKEN_MUL && type != TOKEN_DIV && type != TOKEN_MOD) break;
+        compiler_advance(c);
+        compile_unary(c);
+        if (c->failed) return;
+        compiler_emit_op(c, type == TOKEN_MUL ? OP_MUL : (type == TOKEN_DIV ? OP_DIV : OP_MOD));
+    }
+}
+
+static void compile_additive(ExprCompiler* c) {
+    compile_multiplicative(c);
+    while (!c->failed) {
+        TokenType type = compiler_peek(c)->type;
+        if (type != TOKEN_PLUS && type != TOKEN_MINUS) break;
+        compiler_advance(c);
+        compile_multiplicative(c);
+        if (c->failed) return;
+        compiler_emit_op(c, type == TOKEN_PLUS ? OP_ADD : OP_SUB);
+    }
+}
+
+static void compile_comparison(ExprCompiler* c) {
+    compile_additive(c);
+    while (!c->failed) {
+        TokenType type = compiler_peek(c)->type;
+        OpCode op;
+        if (type == TOKEN_LT) op = OP_LT;
+        else if (type == TOKEN_GT) op = OP_GT;
+        else if (type == TOKEN_LTE) op = OP_LTE;
+        else if (type == TOKEN_GTE) op = OP_GTE;
+        else break;
+        compiler_advance(c);
+        compile_additive(c);
+        if (c->failed) return;
+        compiler_emit_op(c, op);
+    }
+}
+
+static void compile_identity(ExprCompiler* c) {
+    compile_comparison(c);
+    while (!c->failed && compiler_peek(c)->type == TOKEN_IS) {
+        compiler_advance(c);
+        bool is_not = false;
+        if (compiler_peek(c)->type == TOKEN_NOT) {
+            is_not = true;
+            compiler_advance(c);
+        }
+        compile_comparison(c);
+        if (c->failed) return;
+        compiler_emit_op(c, is_not ? OP_IS_NOT : OP_IS);
+    }
+}
+
+static void compile_equality(ExprCompiler* c) {
+    compile_identity(c);
+    while (!c->failed) {
+        TokenType type = compiler_peek(c)->type;
+        if (type != TOKEN_EQ && type != TOKEN_NEQ) break;
+        compiler_advance(c);
+        compile_identity(c);
+        if (c->failed) return;
+        compiler_emit_op(c, type == TOKEN_EQ ? OP_EQ : OP_NEQ);
+    }
+}
+
+// The tree-walker dry-runs the short-circuited side of and/or, which still evaluates
+// its operands (and still raises on bad ones). The VM therefore evaluates both sides
+// eagerly; with pure operands that yields the same result and the same bailouts.
+static void compile_logical_and(ExprCompiler* c) {
+    compile_equality(c);
+    while (!c->failed && compiler_peek(c)->type == TOKEN_AND) {
+        compiler_advance(c);
+        compile_equality(c);
+        if (c->failed) return;
+        compiler_emit_op(c, OP_AND);
+    }
+}
+
+static void compile_logical_or(ExprCompiler* c) {
+    compile_logical_and(c);
+    while (!c->failed && compiler_peek(c)->type == TOKEN_OR) {
+        compiler_advance(c);
+        compile_logical_and(c);
+        if (c->failed) return;
+        compiler_emit_op(c, OP_OR);
+    }
+}
+
+static void compile_await(ExprCompiler* c) {
+    if (compiler_peek(c)->type == TOKEN_AWAIT) { c->failed = true; return; }
+    compile_logical_or(c);
+}
+
+static void compile_conditional(ExprCompiler* c) {
+    compile_await(c);
+    if (c->failed || compiler_peek(c)->type != TOKEN_IF) return;
+    compiler_advance(c);
+    compile_await(c);
+    if (c->failed) return;
+    if (compiler_peek(c)->type != TOKEN_ELSE) { c->failed = true; return; }
+    compiler_advance(c);
+    compile_await(c);
+    if (c->failed) return;
+    compiler_emit_op(c, OP_SELECT);
+}
+
+static BytecodeChunk* bytecode_compile_expression(SourceUnit* unit, int start_index) {
+    ExprCompiler c;
+    memset(&c, 0, sizeof(c));
+    c.unit = unit;
+    c.pos = start_index;
+    c.chunk = calloc(1, sizeof(BytecodeChunk));
+    if (!c.chunk) report_error("System", "Failed to allocate bytecode chunk", NULL);
+
+    compile_conditional(&c);
+    if (c.failed || c.op_count == 0) {
+        bytecode_chunk_free(c.chunk);
+        return &bytecode_not_compilable;
+    }
+    compiler_emit(&c, OP_RETURN);
+    c.chunk->end_token_index = c.pos;
+    DEBUG_PRINTF("BYTECODE_COMPILE: tokens [%d, %d) -> %d words, %d consts, %d names, max stack %d",
+                 start_index, c.pos, c.chunk->code_length, c.chunk->const_count, c.chunk->name_count, c.chunk->max_stack);
+    return c.chunk;
+}
+
+// --- VM ---
+
+#define VM_IS_NUMBER(v) ((v).type == VAL_INT || (v).type == VAL_FLOAT)
+#define VM_AS_DOUBLE(v) ((v).type == VAL_INT ? (double)(v).as.integer : (v).as.floating)
+
+static bool vm_is_truthy(Value v) {
+    if (v.type == VAL_BOOL) return v.as.bool_val;
+    if (v.type == VAL_INT) return v.as.integer != 0;
+    return v.as.floating != 0.0;
+}
+
+// Equality of two int/float/bool values, as values_are_deep_equal defines it.
+static bool vm_values_equal(Value a, Value b) {
+    if (a.type != b.type) {
+        if (VM_IS_NUMBER(a) && VM_IS_NUMBER(b)) return VM_AS_DOUBLE(a) == VM_AS_DOUBLE(b);
+        return false;
+    }
+    if (a.type == VAL_INT) return a.as.integer == b.as.integer;
+    if (a.type == VAL_FLOAT) return a.as.floating == b.as.floating;
+    return a.as.bool_val == b.as.bool_val;
+}
+
+// Identity of two int/float/bool values, as values_are_identical defines it.
+static bool vm_values_identical(Value a, Value b) {
+    if (a.type != b.type) return false;
+    return vm_values_equal(a, b);
+}
+
+// Runs a chunk. Returns false (deopt) if the tree-walker must take over.
+static bool bytecode_run(Interpreter* interpreter, const BytecodeChunk* chunk, Value* out) {
+    Value stack[BYTECODE_MAX_STACK];
+    Value* sp = stack;
+    const int* ip = chunk->code;
+    Value a, b;
+
+#if defined(__GNUC__)
+    // Direct-threaded dispatch: each handler jumps straight to the next one.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+    static void* dispatch_table[OP_COUNT_] = {
+        [OP_LOAD_CONST] = &&do_load_const, [OP_LOAD_NAME] = &&do_load_name,
+        [OP_ADD] = &&do_add, [OP_SUB] = &&do_sub, [OP_MUL] = &&do_mul,
+        [OP_DIV] = &&do_div, [OP_MOD] = &&do_mod, [OP_POW] = &&do_pow,
+        [OP_NEG] = &&do_neg, [OP_NOT] = &&do_not,
+        [OP_LT] = &&do_lt, [OP_GT] = &&do_gt, [OP_LTE] = &&do_lte, [OP_GTE] = &&do_gte,
+        [OP_EQ] = &&do_eq, [OP_NEQ] = &&do_neq, [OP_IS] = &&do_is, [OP_IS_NOT] = &&do_is_not,
+        [OP_AND] = &&do_and, [OP_OR] = &&do_or, [OP_SELECT] = &&do_select,
+        [OP_RETURN] = &&do_return,
+    };
+#define VM_DISPATCH() goto *dispatch_table[*ip++]
+#define VM_CASE(op, label) label:
+    VM_DISPATCH();
+#else
+#define VM_DISPATCH() break
+#define VM_CASE(op, label) case op:
+    for (;;) switch (*ip++) {
+#endif
+
+    VM_CASE(OP_LOAD_CONST, do_load_const) {
+        *sp++ = chunk->consts[*ip++];
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_LOAD_NAME, do_load_name) {
+        Value* var = symbol_table_get_token(interpreter->current_scope, chunk->names[*ip++]);
+        if (!var || (var->type != VAL_INT && var->type != VAL_FLOAT && var->type != VAL_BOOL)) return false;
+        *sp++ = *var;
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_ADD, do_add) {
+        b = *--sp; a = sp[-1];
+        if (!VM_IS_NUMBER(a) || !VM_IS_NUMBER(b)) return false;
+        if (a.type == VAL_INT && b.type == VAL_INT) {
+            sp[-1].as.integer = a.as.integer + b.as.integer;
+        } else {
+            sp[-1].type = VAL_FLOAT;
+            sp[-1].as.floating = VM_AS_DOUBLE(a) + VM_AS_DOUBLE(b);
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_SUB, do_sub) {
+        b = *--sp; a = sp[-1];
+        if (!VM_IS_NUMBER(a) || !VM_IS_NUMBER(b)) return false;
+        if (a.type == VAL_INT && b.type == VAL_INT) {
+            sp[-1].as.integer = (long)(VM_AS_DOUBLE(a) - VM_AS_DOUBLE(b)); // Same double round-trip as the tree-walker
+        } else {
+            sp[-1].type = VAL_FLOAT;
+            sp[-1].as.floating = VM_AS_DOUBLE(a) - VM_AS_DOUBLE(b);
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_MUL, do_mul) {
+        b = *--sp; a = sp[-1];
+        if (!VM_IS_NUMBER(a) || !VM_IS_NUMBER(b)) return false;
+        if (a.type == VAL_INT && b.type == VAL_INT) {
+            sp[-1].as.integer = (long)(VM_AS_DOUBLE(a) * VM_AS_DOUBLE(b));
+        } else {
+            sp[-1].type = VAL_FLOAT;
+            sp[-1].as.floating = VM_AS_DOUBLE(a) * VM_AS_DOUBLE(b);
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_DIV, do_div) {
+        b = *--sp; a = sp[-1];
+        if (!VM_IS_NUMBER(a) || !VM_IS_NUMBER(b) || VM_AS_DOUBLE(b) == 0) return false;
+        sp[-1].type = VAL_FLOAT; // '/' always yields a float
+        sp[-1].as.floating = VM_AS_DOUBLE(a) / VM_AS_DOUBLE(b);
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_MOD, do_mod) {
+        b = *--sp; a = sp[-1];
+        if (a.type != VAL_INT || b.type != VAL_INT || b.as.integer == 0) return false;
+        sp[-1].as.integer = a.as.integer % b.as.integer;
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_POW, do_pow) {
+        b = *--sp; a = sp[-1];
+        if (!VM_IS_NUMBER(a) || !VM_IS_NUMBER(b)) return false;
+        sp[-1].type = VAL_FLOAT;
+        sp[-1].as.floating = pow(VM_AS_DOUBLE(a), VM_AS_DOUBLE(b));
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_NEG, do_neg) {
+        if (sp[-1].type == VAL_INT) sp[-1].as.integer = -sp[-1].as.integer;
+        else if (sp[-1].type == VAL_FLOAT) sp[-1].as.floating = -sp[-1].as.floating;
+        else return false;
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_NOT, do_not) {
+        bool truthy = vm_is_truthy(sp[-1]);
+        sp[-1].type = VAL_BOOL;
+        sp[-1].as.bool_val = !truthy;
+        VM_DISPATCH();
+    }
+#define VM_COMPARE(op_symbol) \
+        b = *--sp; a = sp[-1]; \
+        if (!VM_IS_NUMBER(a) || !VM_IS_NUMBER(b)) return false; \
+        sp[-1].type = VAL_BOOL; \
+        sp[-1].as.bool_val = VM_AS_DOUBLE(a) op_symbol VM_AS_DOUBLE(b); \
+        VM_DISPATCH();
+    VM_CASE(OP_LT, do_lt) { VM_COMPARE(<) }
+    VM_CASE(OP_GT, do_gt) { VM_COMPARE(>) }
+    VM_CASE(OP_LTE, do_lte) { VM_COMPARE(<=) }
+    VM_CASE(OP_GTE, do_gte) { VM_COMPARE(>=) }
+#undef VM_COMPARE
+    VM_CASE(OP_EQ, do_eq) {
+        b = *--sp; a = sp[-1];
+        sp[-1].type = VAL_BOOL;
+        sp[-1].as.bool_val = vm_values_equal(a, b);
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_NEQ, do_neq) {
+        b = *--sp; a = sp[-1];
+        sp[-1].type = VAL_BOOL;
+        sp[-1].as.bool_val = !vm_values_equal(a, b);
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_IS, do_is) {
+        b = *--sp; a = sp[-1];
+        sp[-1].type = VAL_BOOL;
+        sp[-1].as.bool_val = vm_values_identical(a, b);
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_IS_NOT, do_is_not) {
+        b = *--sp; a = sp[-1];
+        sp[-1].type = VAL_BOOL;
+        sp[-1].as.bool_val = !vm_values_identical(a, b);
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_AND, do_and) {
+        b = *--sp;
+        if (vm_is_truthy(sp[-1])) sp[-1] = b; // 'and' yields the falsy left operand or the right one
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_OR, do_or) {
+        b = *--sp;
+        if (!vm_is_truthy(sp[-1])) sp[-1] = b; // 'or' yields the truthy left operand or the right one
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_SELECT, do_select) {
+        b = *--sp;          // false branch
+        a = *--sp;          // condition
+        if (!vm_is_truthy(a)) sp[-1] = b;
+        VM_DISPATCH();
+    }
+    VM_CASE(OP_RETURN, do_return) {
+        *out = sp[-1];
+        return true;
+    }
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#else
+    default:
+        return false;
+    }
+#endif
+#undef VM_DISPATCH
+#undef VM_CASE
+}
+
+bool bytecode_try_eval_expression(Interpreter* interpreter, ExprResult* result) {
+    // Dry runs (skipped branches, await fast-forward) keep the tree-walker's exact behaviour.
+    if (interpreter->prevent_side_effects) return false;
+    Lexer* lexer = interpreter->lexer;
+    SourceUnit* unit = lexer->unit;
+    if (!unit || lexer->token_index <= 0) return false;
+
+    // The lexer cursor sits one token past interpreter->current_token.
+    int start_index = lexer->token_index - 1;
+    const Token* start_tok = &SOURCE_UNIT_ENTRY(unit, start_index)->token;
+    if (start_tok->line != interpreter->current_token->line || start_tok->col != interpreter->current_token->col) {
+        return false;
+    }
+
+    if (start_index >= unit->expr_chunks_capacity) {
+        int new_capacity = unit->expr_chunks_capacity ? unit->expr_chunks_capacity * 2 : unit->token_count;
+        if (new_capacity <= start_index) new_capacity = start_index + 1;
+        BytecodeChunk** new_chunks = realloc(unit->expr_chunks, new_capacity * sizeof(BytecodeChunk*));
+        if (!new_chunks) report_error("System", "Failed to grow bytecode cache", NULL);
+        memset(new_chunks + unit->expr_chunks_capacity, 0, (new_capacity - unit->expr_chunks_capacity) * sizeof(BytecodeChunk*));
+        unit->expr_chunks = new_chunks;
+        unit->expr_chunks_capacity = new_capacity;
+    }
+    BytecodeChunk* chunk = unit->expr_chunks[start_index];
+    if (!chunk) {
+        chunk = bytecode_compile_expression(unit, start_index);
+        unit->expr_chunks[start_index] = chunk;
+    }
+    if (chunk == &bytecode_not_compilable) return false;
+
+    Value value;
+    if (!bytecode_run(interpreter, chunk, &value)) {
+        if (++chunk->deopt_count >= BYTECODE_MAX_DEOPTS) {
+            // Operands here are usually not numbers; stop trying.
+            bytecode_chunk_free(chunk);
+            unit->expr_chunks[start_index] = &bytecode_not_compilable;
+        }
+        return false;
+    }
+
+    // Move the token stream past the expression, as the tree-walker would have.
+    free_token(interpreter->current_token);
+    lexer->token_index = chunk->end_token_index;
+    interpreter->current_token = get_next_token(lexer);
+
+    result->value = value;
+    result->is_freshly_created_container = false;
+    result->is_standalone_primary_id = false;
+    return true;
+}
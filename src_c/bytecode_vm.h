@@ -0,0 +1,44 @@
+// src_c/bytecode_vm.h
+#ifndef ECHOC_BYTECODE_VM_H
+#define ECHOC_BYTECODE_VM_H
+
+#include "header.h"            // Provides Interpreter, Value, SourceUnit
+#include "expression_parser.h" // Provides ExprResult
+
+// Opcodes of the expression VM. Operands follow LOAD_CONST/LOAD_NAME inline.
+typedef enum {
+    OP_LOAD_CONST,  // push consts[arg]
+    OP_LOAD_NAME,   // push value of names[arg] via its frame slot or name (deopts unless int/float/bool)
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_POW,
+    OP_NEG, OP_NOT,
+    OP_LT, OP_GT, OP_LTE, OP_GTE,
+    OP_EQ, OP_NEQ, OP_IS, OP_IS_NOT,
+    OP_AND, OP_OR,  // pop r, l; push l or r following EchoC's value-returning and/or
+    OP_SELECT,      // pop f, c, t; push c ? t : f (the "t if c else f" form)
+    OP_RETURN,
+    OP_COUNT_
+} OpCode;
+
+// An expression compiled from a SourceUnit's token stream.
+typedef struct BytecodeChunk {
+    int* code;
+    int code_length;
+    Value* consts;       // Only int/float/bool constants
+    int const_count;
+    const Token** names; // Cached identifier tokens (borrowed); carry their frame slots
+    int name_count;
+    int max_stack;
+    int end_token_index; // First token after the expression
+    int deopt_count;     // Runtime bailouts to the tree-walker so far
+} BytecodeChunk;
+
+// Tries to evaluate the expression starting at interpreter->current_token on the VM.
+// Returns true and fills 'result' (advancing the token stream past the expression) on success.
+// Returns false without consuming anything when the expression is not VM-eligible or
+// the VM had to bail out; the caller then evaluates it with the tree-walker, which
+// produces the exact same value or error.
+bool bytecode_try_eval_expression(Interpreter* interpreter, ExprResult* result);
+
+void bytecode_chunk_free(BytecodeChunk* chunk);
+
+#endif // ECHOC_BYTECODE_VM_H
@@ -0,0 +1,188 @@
+// src_c/coro_context.c
+#include "coro_context.h"
+#include "header.h" // For report_error
+#include <stdlib.h> // For malloc, free
+
+#ifdef _WIN32
+#include <windows.h> // For CreateFiber, SwitchToFiber
+#else
+#include <ucontext.h> // For getcontext, makecontext, swapcontext
+#include <sys/mman.h> // For mmap, munmap, mprotect
+#include <unistd.h>   // For sysconf
+#endif
+
+// The interpreter recurses several kilobytes of C stack per EchoC call, so a
+// coroutine gets as much as a small thread. Pages are only committed when touched.
+#define CORO_STACK_SIZE (4u * 1024u * 1024u)
+#define CORO_STACK_POOL_MAX 64
+
+// AddressSanitizer tracks one stack per thread unless told about switches.
+#if defined(__SANITIZE_ADDRESS__)
+#define CORO_CONTEXT_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define CORO_CONTEXT_ASAN 1
+#endif
+#endif
+
+#ifdef CORO_CONTEXT_ASAN
+#include <sanitizer/asan_interface.h> // Also declares the fiber switch annotations
+#define ASAN_START_SWITCH(fake_stack_save, bottom, size) __sanitizer_start_switch_fiber((fake_stack_save), (bottom), (size))
+#define ASAN_FINISH_SWITCH(fake_stack, bottom_old, size_old) __sanitizer_finish_switch_fiber((fake_stack), (bottom_old), (size_old))
+#define ASAN_UNPOISON(addr, size) __asan_unpoison_memory_region((addr), (size))
+#else
+#define ASAN_START_SWITCH(fake_stack_save, bottom, size) ((void)(fake_stack_save), (void)(bottom), (void)(size))
+#define ASAN_FINISH_SWITCH(fake_stack, bottom_old, size_old) ((void)(fake_stack), (void)(bottom_old), (void)(size_old))
+#define ASAN_UNPOISON(addr, size) ((void)(addr), (void)(size))
+#endif
+
+struct CoroContext {
+    CoroContextEntry entry;
+    void* arg;
+    bool started;
+    bool finished;
+#ifdef _WIN32
+    LPVOID fiber;
+    LPVOID caller_fiber;
+#else
+    ucontext_t context;
+    ucontext_t caller_context;
+    char* mapping;        // Guard page followed by the usable stack
+    size_t mapping_size;
+#endif
+    // Stack bounds for AddressSanitizer's fiber annotations
+    const void* stack_bottom;
+    size_t stack_size;
+    const void* caller_stack_bottom;
+    size_t caller_stack_size;
+    void* fake_stack;
+};
+
+#ifndef _WIN32
+typedef struct PooledStack {
+    char* mapping;
+    size_t mapping_size;
+} PooledStack;
+
+static PooledStack stack_pool[CORO_STACK_POOL_MAX];
+static int stack_pool_count = 0;
+#endif
+
+// makecontext can only pass int arguments portably, so the context being
+// started is handed to the trampoline through this variable.
+static CoroContext* starting_context = NULL;
+
+#ifdef _WIN32
+static void WINAPI coro_context_trampoline(LPVOID param) {
+    CoroContext* ctx = (CoroContext*)param;
+#else
+static void coro_context_trampoline(void) {
+    CoroContext* ctx = starting_context;
+#endif
+    starting_context = NULL;
+    ASAN_FINISH_SWITCH(NULL, &ctx->caller_stack_bottom, &ctx->caller_stack_size);
+    ctx->entry(ctx->arg);
+    ctx->finished = true;
+    // Leave for good; a NULL save slot lets AddressSanitizer drop this stack's fake frames.
+    ASAN_START_SWITCH(NULL, ctx->caller_stack_bottom, ctx->caller_stack_size);
+#ifdef _WIN32
+    SwitchToFiber(ctx->caller_fiber);
+#else
+    setcontext(&ctx->caller_context);
+#endif
+}
+
+CoroContext* coro_context_create(CoroContextEntry entry, void* arg) {
+    CoroContext* ctx = calloc(1, sizeof(CoroContext));
+    if (!ctx) report_error("System", "Failed to allocate coroutine context.", NULL);
+    ctx->entry = entry;
+    ctx->arg = arg;
+#ifdef _WIN32
+    ctx->fiber = CreateFiber(CORO_STACK_SIZE, coro_context_trampoline, ctx);
+    if (!ctx->fiber) report_error("System", "Failed to create coroutine fiber.", NULL);
+    ctx->stack_bottom = NULL; // Fibers are not annotated
+    ctx->stack_size = 0;
+#else
+    size_t guard_size = (size_t)sysconf(_SC_PAGESIZE);
+    if (stack_pool_count > 0) {
+        PooledStack reused = stack_pool[--stack_pool_count];
+        ctx->mapping = reused.mapping;
+        ctx->mapping_size = reused.mapping_size;
+    } else {
+        ctx->mapping_size = CORO_STACK_SIZE + guard_size;
+        ctx->mapping = mmap(NULL, ctx->mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (ctx->mapping == MAP_FAILED) report_error("System", "Failed to map a coroutine stack.", NULL);
+        // Stacks grow down: an overflow runs into the guard page instead of the heap.
+        mprotect(ctx->mapping, guard_size, PROT_NONE);
+    }
+    ctx->stack_bottom = ctx->mapping + guard_size;
+    ctx->stack_size = ctx->mapping_size - guard_size;
+
+    if (getcontext(&ctx->context) != 0) report_error("System", "getcontext failed for coroutine.", NULL);
+    ctx->context.uc_stack.ss_sp = (void*)ctx->stack_bottom;
+    ctx->context.uc_stack.ss_size = ctx->stack_size;
+    ctx->context.uc_link = NULL; // The trampoline switches away itself and never returns
+    makecontext(&ctx->context, coro_context_trampoline, 0);
+#endif
+    return ctx;
+}
+
+void coro_context_resume(CoroContext* ctx) {
+    if (ctx->finished) report_error("Internal", "Attempted to resume a finished coroutine context.", NULL);
+    void* fake_stack = NULL;
+    if (!ctx->started) {
+        ctx->started = true;
+        starting_context = ctx;
+    }
+    ASAN_START_SWITCH(&fake_stack, ctx->stack_bottom, ctx->stack_size);
+#ifdef _WIN32
+    if (!IsThreadAFiber()) ConvertThreadToFiber(NULL);
+    ctx->caller_fiber = GetCurrentFiber();
+    SwitchToFiber(ctx->fiber);
+#else
+    swapcontext(&ctx->caller_context, &ctx->context);
+#endif
+    ASAN_FINISH_SWITCH(fake_stack, NULL, NULL);
+}
+
+void coro_context_yield(CoroContext* ctx) {
+    ASAN_START_SWITCH(&ctx->fake_stack, ctx->caller_stack_bottom, ctx->caller_stack_size);
+#ifdef _WIN32
+    SwitchToFiber(ctx->caller_fiber);
+#else
+    swapcontext(&ctx->context, &ctx->caller_context);
+#endif
+    // Resumed, possibly by a different caller than last time.
+    ASAN_FINISH_SWITCH(ctx->fake_stack, &ctx->caller_stack_bottom, &ctx->caller_stack_size);
+}
+
+bool coro_context_finished(const CoroContext* ctx) {
+    return ctx->finished;
+}
+
+void coro_context_free(CoroContext* ctx) {
+    if (!ctx) return;
+#ifdef _WIN32
+    DeleteFiber(ctx->fiber);
+#else
+    // Frames abandoned on the stack leave redzones behind; clear them before reuse.
+    ASAN_UNPOISON(ctx->stack_bottom, ctx->stack_size);
+    if (stack_pool_count < CORO_STACK_POOL_MAX) {
+        stack_pool[stack_pool_count].mapping = ctx->mapping;
+        stack_pool[stack_pool_count].mapping_size = ctx->mapping_size;
+        stack_pool_count++;
+    } else {
+        munmap(ctx->mapping, ctx->mapping_size);
+    }
+#endif
+    free(ctx);
+}
+
+void coro_context_release_pool(void) {
+#ifndef _WIN32
+    while (stack_pool_count > 0) {
+        PooledStack pooled = stack_pool[--stack_pool_count];
+        munmap(pooled.mapping, pooled.mapping_size);
+    }
+#endif
+}
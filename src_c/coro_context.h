@@ -0,0 +1,37 @@
+// src_c/coro_context.h
+#ifndef ECHOC_CORO_CONTEXT_H
+#define ECHOC_CORO_CONTEXT_H
+
+#include <stdbool.h>
+
+// A machine-level continuation: a private C stack plus the saved registers of
+// whatever is running on it. The tree-walker recurses on the C stack, so a
+// coroutine whose body runs on its own stack can suspend in the middle of any
+// statement or expression and later continue from exactly that point.
+// Backed by ucontext on POSIX and by fibers on Windows.
+typedef struct CoroContext CoroContext;
+
+typedef void (*CoroContextEntry)(void* arg);
+
+// Creates a context that will run entry(arg) on a fresh stack the first time it
+// is resumed. Stacks come from a small pool of previously released ones.
+CoroContext* coro_context_create(CoroContextEntry entry, void* arg);
+
+// Switches into 'ctx' and returns once it yields or its entry function returns.
+void coro_context_resume(CoroContext* ctx);
+
+// Called from code running on 'ctx': switches back to whoever resumed it.
+// Returns when the context is resumed again.
+void coro_context_yield(CoroContext* ctx);
+
+// True once the entry function has returned. A finished context must not be resumed.
+bool coro_context_finished(const CoroContext* ctx);
+
+// Releases the context. Must not be called from code running on 'ctx'.
+// A context that never finished is dropped together with its stack.
+void coro_context_free(CoroContext* ctx);
+
+// Unmaps the pooled stacks (at interpreter shutdown).
+void coro_context_release_pool(void);
+
+#endif // ECHOC_CORO_CONTEXT_H
@@ -1,93 +1,137 @@
 // src_c/dictionary.c
 #include "dictionary.h"
-#include <string.h> // For strcmp, strdup, strcpy
-#include <stdlib.h> // For malloc, free, calloc
+#include "intern.h" // Keys are interned: they compare by pointer and carry their hash
+#include <string.h> // For memcpy, memset
+#include <stdlib.h> // For malloc, free, realloc
 #include <stdio.h>  // For snprintf
 
-// Simple hash function for strings (djb2)
+#define DICT_MIN_INDEX_CAPACITY 8
+
+// FNV-1a with a murmur3-style finalizer, so short keys that differ only in
+// their last characters still spread across the whole index table.
 unsigned long hash_string(const char* str) {
-    unsigned long hash = 5381;
-    int c;
-    while ((c = *str++)) hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+    uint32_t hash = 2166136261u;
+    for (; *str; ++str) {
+        hash ^= (unsigned char)*str;
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
     return hash;
 }
 
-static void dictionary_resize(Dictionary* dict, Token* error_token); // Forward declaration
+// Returns the index-table slot that holds interned 'key', or the empty slot where it would go.
+static int dictionary_find_slot(const Dictionary* dict, const char* key, uint32_t hash) {
+    uint32_t mask = (uint32_t)dict->index_capacity - 1;
+    uint32_t slot = hash & mask;
+    while (1) {
+        int entry_index = dict->index[slot];
+        if (entry_index < 0) return (int)slot;
+        const DictEntry* entry = &dict->entries[entry_index];
+        if (entry->key == key) return (int)slot;
+        slot = (slot + 1) & mask;
+    }
+}
+
+// Allocates an index table of 'index_capacity' empty slots and rebuilds it from the
+// entries using their cached hashes. Entries and their values are never copied.
+static void dictionary_rebuild_index(Dictionary* dict, int index_capacity, Token* error_token) {
+    int* index = malloc(index_capacity * sizeof(int));
+    if (!index) report_error("System", "Failed to allocate memory for dictionary index", error_token);
+    memset(index, 0xff, index_capacity * sizeof(int)); // All slots -1
+    free(dict->index);
+    dict->index = index;
+    dict->index_capacity = index_capacity;
+    uint32_t mask = (uint32_t)index_capacity - 1;
+    for (int i = 0; i < dict->count; ++i) {
+        uint32_t slot = dict->entries[i].hash & mask;
+        while (index[slot] >= 0) slot = (slot + 1) & mask;
+        index[slot] = i;
+    }
+}
+
+// Doubles the table. Entries move with one realloc and keep their insertion order.
+static void dictionary_grow(Dictionary* dict, Token* error_token) {
+    int new_index_capacity = dict->index_capacity * 2;
+    int new_entry_capacity = new_index_capacity / 4 * 3;
+    DictEntry* new_entries = realloc(dict->entries, new_entry_capacity * sizeof(DictEntry));
+    if (!new_entries) report_error("System", "Failed to allocate memory for resized dictionary entries", error_token);
+    dict->entries = new_entries;
+    dict->entry_capacity = new_entry_capacity;
+    dictionary_rebuild_index(dict, new_index_capacity, error_token);
+}
 
-Dictionary* dictionary_create(int initial_buckets, Token* error_token) {
+Dictionary* dictionary_create(int initial_capacity, Token* error_token) {
     Dictionary* dict = malloc(sizeof(Dictionary));
     if (!dict) report_error("System", "Failed to allocate memory for dictionary", error_token);
     dict->id = next_dictionary_id++;
-    dict->num_buckets = initial_buckets > 0 ? initial_buckets : 16; // Default to 16 buckets
     dict->count = 0;
-    dict->buckets = calloc(dict->num_buckets, sizeof(DictEntry*)); // Initialize all bucket pointers to NULL
-    if (!dict->buckets) { free(dict); report_error("System", "Failed to allocate memory for dictionary buckets", error_token); }
+    dict->ref_count = 1;
+    int index_capacity = DICT_MIN_INDEX_CAPACITY;
+    while (index_capacity < initial_capacity) index_capacity *= 2;
+    dict->entry_capacity = index_capacity / 4 * 3;
+    dict->entries = malloc(dict->entry_capacity * sizeof(DictEntry));
+    dict->index = NULL;
+    if (!dict->entries) { free(dict); report_error("System", "Failed to allocate memory for dictionary entries", error_token); }
+    dictionary_rebuild_index(dict, index_capacity, error_token);
     DEBUG_PRINTF("DICTIONARY_CREATE: Created [Dict #%llu] at %p", dict->id, (void*)dict);
     return dict;
 }
 
-// Helper to create a dictionary entry (used internally for optimized copying and set)
-DictEntry* dictionary_create_entry(const char* key, Value value, Token* error_token) {
-    DictEntry* new_entry = malloc(sizeof(DictEntry));
-    if (!new_entry) {
-        report_error("System", "Failed to allocate memory for dictionary entry", error_token);
+Dictionary* dictionary_copy(const Dictionary* dict, Token* error_token) {
+    Dictionary* copy = malloc(sizeof(Dictionary));
+    if (!copy) report_error("System", "Failed to allocate memory for dictionary copy", error_token);
+    copy->id = next_dictionary_id++;
+    copy->count = dict->count;
+    copy->ref_count = 1;
+    copy->entry_capacity = dict->entry_capacity;
+    copy->index_capacity = dict->index_capacity;
+    copy->entries = malloc(dict->entry_capacity * sizeof(DictEntry));
+    copy->index = malloc(dict->index_capacity * sizeof(int));
+    if (!copy->entries || !copy->index) report_error("System", "Failed to allocate memory for dictionary copy", error_token);
+    memcpy(copy->index, dict->index, dict->index_capacity * sizeof(int)); // Same hashes, same layout
+    for (int i = 0; i < dict->count; ++i) {
+        copy->entries[i].key = intern_retain(dict->entries[i].key);
+        copy->entries[i].value = value_deep_copy(dict->entries[i].value);
+        copy->entries[i].hash = dict->entries[i].hash;
     }
-    new_entry->key = strdup(key);
-    if (!new_entry->key) {
-        free(new_entry);
-        report_error("System", "Failed to allocate memory for dictionary key", error_token);
-    }
-    new_entry->value = value_deep_copy(value); // Deep copy the value
-    new_entry->next = NULL;
-
-    return new_entry;
+    return copy;
 }
 
 void dictionary_set(Dictionary* dict, const char* key_str, Value value, Token* error_token) {
-    unsigned long hash = hash_string(key_str);
-    int index = hash % dict->num_buckets;
-
-    DictEntry* current_entry = dict->buckets[index];
-    DictEntry* prev_entry = NULL;
-
-    // Check if key already exists in the chain
-    while (current_entry != NULL) {
-        if (strcmp(current_entry->key, key_str) == 0) {
-            free_value_contents(current_entry->value); // Free old value
-            current_entry->value = value_deep_copy(value); // Set new value (deep copy)
-            return; // Key updated
-        }
-        prev_entry = current_entry;
-        current_entry = current_entry->next;
-    }
-
-    // Key does not exist, create new entry
-    DictEntry* new_entry = dictionary_create_entry(key_str, value, error_token);
+    dictionary_set_hashed(dict, key_str, (uint32_t)hash_string(key_str), value, error_token);
+}
 
-    if (prev_entry == NULL) { // Bucket was empty
-        dict->buckets[index] = new_entry;
-    } else { // Add to end of chain in this bucket
-        prev_entry->next = new_entry;
+void dictionary_set_hashed(Dictionary* dict, const char* key_str, uint32_t key_hash, Value value, Token* error_token) {
+    const char* key = intern_acquire_hashed(key_str, key_hash);
+    uint32_t hash = intern_hash(key);
+    int slot = dictionary_find_slot(dict, key, hash);
+    if (dict->index[slot] >= 0) { // Key already exists: replace the value in place
+        intern_release(key); // The entry already holds a reference
+        DictEntry* entry = &dict->entries[dict->index[slot]];
+        Value new_value = value_deep_copy(value); // Copy first in case 'value' lives in the old one
+        free_value_contents(entry->value);
+        entry->value = new_value;
+        return;
     }
-    dict->count++;
 
-    // Check load factor and resize if necessary
-    if ((double)dict->count / dict->num_buckets > 0.75) {
-        dictionary_resize(dict, error_token);
+    if (dict->count == dict->entry_capacity) {
+        dictionary_grow(dict, error_token);
+        slot = dictionary_find_slot(dict, key, hash);
     }
+    DictEntry* entry = &dict->entries[dict->count];
+    entry->key = key;
+    entry->value = value_deep_copy(value);
+    entry->hash = hash;
+    dict->index[slot] = dict->count++;
 }
 
 Value dictionary_get(Dictionary* dict, const char* key_str, Token* error_token) {
-    unsigned long hash = hash_string(key_str);
-    int index = hash % dict->num_buckets;
-
-    DictEntry* current_entry = dict->buckets[index];
-    while (current_entry != NULL) {
-        if (strcmp(current_entry->key, key_str) == 0) {
-            return value_deep_copy(current_entry->value); // Return a deep copy
-        }
-        current_entry = current_entry->next;
-    }
+    Value* stored = dictionary_try_get_value_ptr(dict, key_str);
+    if (stored) return value_deep_copy(*stored);
 
     char err_msg[300];
     snprintf(err_msg, sizeof(err_msg), "Key '%s' not found in dictionary.", key_str);
@@ -96,91 +140,39 @@ Value dictionary_get(Dictionary* dict, const char* key_str, Token* error_token)
     Value not_found_val; not_found_val.type = VAL_BOOL; not_found_val.as.bool_val = 0; /* Placeholder */ return not_found_val;
 }
 
-// Helper to rehash a dictionary into a new set of buckets
-static void dictionary_resize(Dictionary* dict, Token* error_token) {
-    int old_num_buckets = dict->num_buckets;
-    DictEntry** old_buckets = dict->buckets;
-
-    dict->num_buckets *= 2; // Double the number of buckets
-    dict->buckets = calloc(dict->num_buckets, sizeof(DictEntry*));
-    if (!dict->buckets) {
-        // Attempt to restore old state if new allocation fails (though program might be unstable)
-        dict->num_buckets = old_num_buckets;
-        dict->buckets = old_buckets; // This is risky as old_buckets will be freed if we don't exit
-        report_error("System", "Failed to allocate memory for resized dictionary buckets", error_token);
-    }
-    dict->count = 0; // Reset count, will be incremented as items are re-inserted
-
-    for (int i = 0; i < old_num_buckets; ++i) {
-        DictEntry* entry = old_buckets[i];
-        while (entry) {
-            DictEntry* next_entry = entry->next;
-            // Re-insert entry into the new buckets. dictionary_set will make a deep copy
-            // of entry->value.
-            dictionary_set(dict, entry->key, entry->value, error_token); 
-            free(entry->key); // Free old key
-            // The value within 'entry' was copied by dictionary_set.
-            // If dictionary_set reuses the value object, this free_value_contents might be an issue.
-            // However, dictionary_set does value_deep_copy, so the original entry->value is safe to free.
-            free_value_contents(entry->value); // Free old value contents
-            free(entry); // Free old entry struct
-            entry = next_entry;
-        }
-    }
-    free(old_buckets); // Free the old array of bucket pointers
-}
-
 bool dictionary_try_get(Dictionary* dict, const char* key_str, Value* out_val, bool create_deep_copy_of_value_contents) {
-    if (!dict || !key_str || !out_val) return false; // Basic safety
-    unsigned long hash = hash_string(key_str);
-    int index = hash % dict->num_buckets;
-
-    DictEntry* current_entry = dict->buckets[index];
-    while (current_entry != NULL) {
-        if (strcmp(current_entry->key, key_str) == 0) {
-            if (create_deep_copy_of_value_contents) {
-                *out_val = value_deep_copy(current_entry->value); // Populate with a deep copy
-            } else {
-                *out_val = current_entry->value; // Shallow copy of Value struct, shares internal pointers for complex types
-            }
-            return true; // Found
-        }
-        current_entry = current_entry->next;
+    if (!out_val) return false; // Basic safety
+    Value* stored = dictionary_try_get_value_ptr(dict, key_str);
+    if (!stored) return false;
+    if (create_deep_copy_of_value_contents) {
+        *out_val = value_deep_copy(*stored); // Populate with a deep copy
+    } else {
+        *out_val = *stored; // Shallow copy of Value struct, shares internal pointers for complex types
     }
-    return false; // Not found
+    return true;
 }
 
 Value* dictionary_try_get_value_ptr(Dictionary* dict, const char* key_str) {
     if (!dict || !key_str) return NULL;
-    unsigned long hash = hash_string(key_str);
-    int index = hash % dict->num_buckets;
-
-    DictEntry* current_entry = dict->buckets[index];
-    while (current_entry != NULL) {
-        if (strcmp(current_entry->key, key_str) == 0) {
-            return &(current_entry->value);
-        }
-        current_entry = current_entry->next;
-    }
-    return NULL; // Not found
+    return dictionary_try_get_value_ptr_hashed(dict, key_str, (uint32_t)hash_string(key_str));
+}
+
+Value* dictionary_try_get_value_ptr_hashed(Dictionary* dict, const char* key_str, uint32_t key_hash) {
+    if (!dict || !key_str) return NULL;
+    const char* key = intern_find_hashed(key_str, key_hash);
+    if (!key) return NULL; // Never interned, so no dictionary has this key
+    int slot = dictionary_find_slot(dict, key, intern_hash(key));
+    int entry_index = dict->index[slot];
+    return entry_index >= 0 ? &dict->entries[entry_index].value : NULL;
 }
 
 void dictionary_free(Dictionary* dict, int free_keys, int free_values_contents) {
     if (!dict) return;
-    for (int i = 0; i < dict->num_buckets; ++i) {
-        DictEntry* entry = dict->buckets[i];
-        while (entry) {
-            DictEntry* next_entry = entry->next;
-            if (free_keys && entry->key) {
-                free(entry->key);
-            }
-            if (free_values_contents) {
-                free_value_contents(entry->value);
-            }
-            free(entry);
-            entry = next_entry;
-        }
+    for (int i = 0; i < dict->count; ++i) {
+        if (free_keys) intern_release(dict->entries[i].key);
+        if (free_values_contents) free_value_contents(dict->entries[i].value);
     }
-    free(dict->buckets);
+    free(dict->entries);
+    free(dict->index);
     free(dict);
 }
\ No newline at end of file
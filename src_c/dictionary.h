@@ -4,16 +4,26 @@
 
 #include "header.h" // Provides Value, Dictionary, Token, report_error, value_deep_copy, free_value_contents
 
-// A simple and widely used hash function for strings (djb2).
+// String hash used for dictionary keys (FNV-1a with an avalanche finalizer).
+// Keys are interned (see intern.h) with this hash, so a lookup hashes its key
+// string once to find the interned pointer and then compares entries by pointer.
 unsigned long hash_string(const char* str);
 
-// Creates a new dictionary.
-Dictionary* dictionary_create(int initial_buckets, Token* error_token);
+// Creates a new dictionary with room for about 'initial_capacity' keys before it grows.
+Dictionary* dictionary_create(int initial_capacity, Token* error_token);
+
+// Returns a new dictionary with the same keys in the same order; values are copied with
+// value_deep_copy. The index table is copied as-is, so nothing is rehashed.
+Dictionary* dictionary_copy(const Dictionary* dict, Token* error_token);
 
 // Sets a key-value pair in the dictionary. Handles new keys and updates to existing keys.
-// Makes a deep copy of the value.
+// Makes a deep copy of the value. New keys are appended to the iteration order.
+// May move the entries, invalidating pointers from dictionary_try_get_value_ptr.
 void dictionary_set(Dictionary* dict, const char* key_str, Value value, Token* error_token);
 
+// dictionary_set with a precomputed hash_string(key_str), e.g. the cached hash of a string value.
+void dictionary_set_hashed(Dictionary* dict, const char* key_str, uint32_t key_hash, Value value, Token* error_token);
+
 // Gets a value from the dictionary by key. Reports an error if the key is not found.
 // Returns a deep copy of the value.
 Value dictionary_get(Dictionary* dict, const char* key_str, Token* error_token);
@@ -24,10 +34,13 @@ Value dictionary_get(Dictionary* dict, const char* key_str, Token* error_token);
 // If false, out_val is a shallow copy of the Value struct (internal pointers for complex types are shared).
 bool dictionary_try_get(Dictionary* dict, const char* key_str, Value* out_val, bool create_deep_copy_of_value_contents);
 
+// Returns a pointer to the stored value for 'key_str' (for in-place updates), or NULL if absent.
+Value* dictionary_try_get_value_ptr(Dictionary* dict, const char* key_str);
+
+// dictionary_try_get_value_ptr with a precomputed hash_string(key_str).
+Value* dictionary_try_get_value_ptr_hashed(Dictionary* dict, const char* key_str, uint32_t key_hash);
+
 // Frees the dictionary, its entries, and optionally the keys and values if specified.
 void dictionary_free(Dictionary* dict, int free_keys, int free_values_contents);
 
-// Helper to create a dictionary entry (used internally for optimized copying)
-DictEntry* dictionary_create_entry(const char* key, Value value, Token* error_token);
-
 #endif // ECHOC_DICTIONARY_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+// src_c/echoc.h
+#ifndef ECHOC_H
+#define ECHOC_H
+
+#include <stdbool.h>
+
+// Embedding API (libechoc). An engine is a long-lived interpreter: its module
+// cache, loaded module scopes and pooled coroutine stacks survive between runs.
+// A script is compiled once into a reusable handle that keeps its token cache,
+// resolved function frames and (with ECHOC_ENGINE_VM) compiled expressions, and
+// can then be run any number of times with different input bindings.
+//
+// Each run executes the script in a fresh global scope. Its globals stay readable
+// through echoc_get_global until the next run starts or the engine is destroyed.
+// The runtime keeps process-wide state, so only one engine may run at a time.
+
+typedef struct EchoCEngine EchoCEngine;
+typedef struct EchoCScript EchoCScript;
+
+// Flags for echoc_engine_create
+#define ECHOC_ENGINE_VM 0x1 // Run arithmetic and logic expressions on the bytecode VM (--vm)
+// A syntax or runtime error during a run prints its message to stderr and exits the
+// process on the spot, as a one-shot command line wants, instead of returning
+// ECHOC_ERROR_FATAL. The aborted run is never unwound, so nothing it held is lost.
+#define ECHOC_ENGINE_EXIT_ON_ERROR 0x2
+
+typedef enum {
+    ECHOC_OK = 0,
+    ECHOC_ERROR_IO,        // The script file could not be read
+    ECHOC_ERROR_EXCEPTION, // The run ended with an unhandled EchoC exception
+    ECHOC_ERROR_FATAL      // A syntax or runtime error aborted compilation or the run
+} EchoCStatus;
+
+typedef enum {
+    ECHOC_TYPE_NULL,
+    ECHOC_TYPE_BOOL,
+    ECHOC_TYPE_INT,
+    ECHOC_TYPE_FLOAT,
+    ECHOC_TYPE_STRING,
+    ECHOC_TYPE_OTHER // Read-only: containers, objects, functions (as.string holds their representation)
+} EchoCType;
+
+typedef struct EchoCValue {
+    EchoCType type;
+    union {
+        bool boolean;
+        long integer;
+        double floating;
+        const char* string;
+    } as;
+} EchoCValue;
+
+// A global defined in the run's scope before the script starts.
+typedef struct EchoCBinding {
+    const char* name;
+    EchoCValue value; // Copied; the caller keeps ownership of strings
+} EchoCBinding;
+
+EchoCEngine* echoc_engine_create(unsigned flags);
+
+// Frees the engine, its last run's globals and its module cache.
+// Scripts compiled by the engine may be freed before or after it.
+void echoc_engine_destroy(EchoCEngine* engine);
+
+// Reads and tokenizes a script file. Lexical errors are reported here rather
+// than during the first run. Returns NULL on failure (see echoc_last_error).
+EchoCScript* echoc_compile_file(EchoCEngine* engine, const char* path);
+
+// Like echoc_compile_file for source held in memory (copied). 'name' is used in
+// error messages; modules it loads are resolved from the working directory.
+EchoCScript* echoc_compile_string(EchoCEngine* engine, const char* source, const char* name);
+
+void echoc_script_free(EchoCScript* script);
+
+// Runs 'script' in a fresh global scope holding 'bindings', including any
+// weaver event loop it starts. After ECHOC_ERROR_FATAL the engine stays usable, also
+// when the error was raised inside a coroutine, but memory held by the aborted run
+// may not be reclaimed.
+EchoCStatus echoc_run(EchoCEngine* engine, EchoCScript* script, const EchoCBinding* bindings, int binding_count);
+
+// Looks up a global of the last run. Strings point into the engine and stay
+// valid until the next run, lookup or engine destruction.
+bool echoc_get_global(EchoCEngine* engine, const char* name, EchoCValue* out);
+
+// Message for the last failed compile or run, or "" if the last one succeeded. An
+// unhandled exception is preceded by one line per weaver.weave() root that ended with
+// an exception. The library itself writes nothing to stderr for either.
+const char* echoc_last_error(const EchoCEngine* engine);
+
+#endif // ECHOC_H
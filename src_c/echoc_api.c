@@ -0,0 +1,379 @@
+// src_c/echoc_api.c
+#include "echoc.h"
+#include "header.h"
+#include "interpreter.h"   // For interpret, robust_free_coroutine_queue, robust_free_sleep_queue
+#include "module_loader.h" // For initialize_module_system, cleanup_module_system
+#include "value_utils.h"   // For value_to_string_representation
+#include "scope.h"         // For symbol_table_define, symbol_table_get_local
+#include "source_unit.h"   // For source_unit_create, source_unit_token_at
+#include "unit_cache.h"    // For unit_cache_store
+#include "coro_context.h"  // For coro_context_release_pool
+#include "object_shape.h"  // For shape_free_tree
+#include "arena.h"         // For the interpreter's scratch arena
+#include "string_value.h"  // For string_value_create
+#include <sys/stat.h>      // For stat() to check file type
+#include <errno.h>
+
+struct EchoCEngine {
+    Interpreter interpreter;
+    Scope* run_scope;                       // Globals of the last run, kept for echoc_get_global
+    BlueprintListNode* blueprints_before_run; // all_blueprints_head when the last run started
+    char* last_error;
+    char* lookup_repr;                      // Representation returned by the last echoc_get_global
+    bool exit_on_error;                     // ECHOC_ENGINE_EXIT_ON_ERROR
+};
+
+struct EchoCScript {
+    SourceUnit* unit;
+    char* path;      // Absolute path, or the name given to echoc_compile_string
+    char* directory; // Base for resolving the script's relative module loads
+};
+
+static void echoc_set_error(EchoCEngine* engine, const char* message) {
+    free(engine->last_error);
+    engine->last_error = message ? strdup(message) : NULL;
+}
+
+// Blueprints are freed in two passes over a list: class scopes may hold instances
+// of other blueprints in the list, and freeing those still reads their shapes.
+static void echoc_free_blueprint_scope(Blueprint* bp) {
+    DEBUG_PRINTF("ECHOC_API: Freeing class scope of Blueprint '%s'.", bp->name);
+    // class_attributes_and_methods scope contains symbols (let vars, functs).
+    // free_scope will handle freeing those symbols and their values.
+    if (bp->class_attributes_and_methods) free_scope(bp->class_attributes_and_methods);
+    bp->class_attributes_and_methods = NULL;
+}
+
+static void echoc_free_blueprint(Blueprint* bp) {
+    DEBUG_PRINTF("ECHOC_API: Freeing Blueprint '%s'.", bp->name);
+    if (bp->name) free(bp->name);
+    shape_free_tree(bp->root_shape);
+    free(bp);
+}
+
+static void echoc_free_blueprint_list(BlueprintListNode* head) {
+    for (BlueprintListNode* node = head; node; node = node->next) {
+        if (node->blueprint) echoc_free_blueprint_scope(node->blueprint);
+    }
+    while (head) {
+        BlueprintListNode* next = head->next;
+        if (head->blueprint) echoc_free_blueprint(head->blueprint);
+        free(head);
+        head = next;
+    }
+}
+
+// Blueprints a module defines at its top level live as long as the module cache.
+static bool echoc_blueprint_owned_by_module(Interpreter* interpreter, Blueprint* bp) {
+    for (ScopeListNode* node = interpreter->active_module_scopes_head; node; node = node->next) {
+        for (SymbolNode* symbol = node->scope->symbols; symbol; symbol = symbol->next) {
+            if (symbol->value.type == VAL_BLUEPRINT && symbol->value.as.blueprint_val == bp) return true;
+        }
+    }
+    return false;
+}
+
+// Frees the last run's globals together with the blueprints its script defined.
+static void echoc_release_run(EchoCEngine* engine) {
+    if (!engine->run_scope) return;
+    Interpreter* interpreter = &engine->interpreter;
+    free_scope(engine->run_scope);
+    engine->run_scope = NULL;
+
+    BlueprintListNode* released = NULL;
+    BlueprintListNode** link = &interpreter->all_blueprints_head;
+    while (*link && *link != engine->blueprints_before_run) { // New blueprints are prepended
+        BlueprintListNode* node = *link;
+        if (node->blueprint && echoc_blueprint_owned_by_module(interpreter, node->blueprint)) {
+            link = &node->next;
+            continue;
+        }
+        *link = node->next;
+        node->next = released;
+        released = node;
+    }
+    echoc_free_blueprint_list(released);
+    free(engine->lookup_repr);
+    engine->lookup_repr = NULL;
+}
+
+// Puts the interpreter back into its between-runs state. After a fatal error this
+// abandons whatever scopes, try frames and coroutine stacks the run still had open.
+static void echoc_end_run(EchoCEngine* engine) {
+    Interpreter* interpreter = &engine->interpreter;
+    // Coroutines nobody awaited are dropped, as at the end of a CLI run.
+    while (interpreter->async_ready_queue_head || interpreter->async_sleep_count > 0) {
+        if (interpreter->async_ready_queue_head) {
+            robust_free_coroutine_queue(interpreter, &interpreter->async_ready_queue_head, &interpreter->async_ready_queue_tail);
+        }
+        if (interpreter->async_sleep_count > 0) {
+            robust_free_sleep_queue(interpreter);
+        }
+    }
+
+    free_token(interpreter->current_token);
+    interpreter->current_token = NULL;
+    interpreter->lexer = NULL;
+    interpreter->current_scope = NULL;
+    free(interpreter->current_executing_file_path);
+    interpreter->current_executing_file_path = NULL;
+    free(interpreter->current_executing_file_directory);
+    interpreter->current_executing_file_directory = NULL;
+    free_value_contents(interpreter->current_function_return_value);
+    interpreter->current_function_return_value = create_null_value();
+    free_value_contents(interpreter->current_exception);
+    interpreter->current_exception = create_null_value();
+    if (interpreter->error_token) free_token(interpreter->error_token);
+    interpreter->error_token = NULL;
+
+    interpreter->loop_depth = 0;
+    interpreter->break_flag = 0;
+    interpreter->continue_flag = 0;
+    interpreter->function_nesting_level = 0;
+    interpreter->return_flag = 0;
+    interpreter->exception_is_active = 0;
+    interpreter->unhandled_error_occured = 0;
+    free(interpreter->unhandled_async_errors);
+    interpreter->unhandled_async_errors = NULL;
+    interpreter->current_self_object = NULL;
+    interpreter->try_catch_stack_top = NULL;
+    interpreter->in_try_catch_finally_block_definition = 0;
+    interpreter->current_executing_coroutine = NULL;
+    interpreter->async_event_loop_active = 0;
+    interpreter->repr_depth_count = 0;
+    interpreter->prevent_side_effects = false;
+    interpreter->gather_last_return_exceptions_flag = false;
+    interpreter->scratch = &interpreter->main_scratch;
+    arena_reset(&interpreter->main_scratch);
+}
+
+EchoCEngine* echoc_engine_create(unsigned flags) {
+    EchoCEngine* engine = calloc(1, sizeof(EchoCEngine));
+    if (!engine) return NULL;
+    Interpreter* interpreter = &engine->interpreter;
+    interpreter->current_function_return_value = create_null_value();
+    interpreter->current_exception = create_null_value();
+    interpreter->vm_enabled = (flags & ECHOC_ENGINE_VM) != 0;
+    engine->exit_on_error = (flags & ECHOC_ENGINE_EXIT_ON_ERROR) != 0;
+    arena_init(&interpreter->main_scratch);
+    interpreter->scratch = &interpreter->main_scratch;
+    g_interpreter_for_error_reporting = interpreter;
+    initialize_module_system(interpreter);
+    return engine;
+}
+
+void echoc_engine_destroy(EchoCEngine* engine) {
+    if (!engine) return;
+    Interpreter* interpreter = &engine->interpreter;
+    echoc_release_run(engine);
+
+    free(interpreter->async_sleep_heap); // Storage left allocated after the last sleeper woke
+    free_value_contents(interpreter->current_function_return_value);
+    free_value_contents(interpreter->current_exception);
+    cleanup_module_system(interpreter); // Clean up module cache and related resources
+
+    // Whatever is left belongs to cached modules. Freed after the module scopes,
+    // whose objects still need their blueprint's shapes.
+    echoc_free_blueprint_list(interpreter->all_blueprints_head);
+    interpreter->all_blueprints_head = NULL;
+    arena_free(&interpreter->main_scratch);
+    coro_context_release_pool();
+    if (g_interpreter_for_error_reporting == interpreter) g_interpreter_for_error_reporting = NULL;
+    free(engine->last_error);
+    free(engine);
+}
+
+// Takes ownership of 'unit'. Lexes the whole text up front so the cache is
+// complete and lexical errors are reported at compile time.
+static EchoCScript* echoc_compile_unit(EchoCEngine* engine, SourceUnit* unit, char* path, char* directory) {
+    Interpreter* interpreter = &engine->interpreter;
+    EchoCScript* volatile script = calloc(1, sizeof(EchoCScript)); // volatile: read after longjmp
+    if (!script) {
+        source_unit_decref(unit); free(path); free(directory);
+        echoc_set_error(engine, "Error: Could not allocate memory for script.");
+        return NULL;
+    }
+    script->unit = unit;
+    script->path = path;
+    script->directory = directory;
+
+    g_interpreter_for_error_reporting = interpreter;
+    interpreter->current_executing_file_path = script->path; // Borrowed for error messages
+    jmp_buf recovery;
+    g_error_recovery_point = &recovery;
+    if (setjmp(recovery) != 0) {
+        g_error_recovery_point = NULL;
+        interpreter->current_executing_file_path = NULL;
+        echoc_set_error(engine, g_error_recovery_message);
+        echoc_script_free(script);
+        return NULL;
+    }
+    int token_index = 0;
+    while (source_unit_token_at(script->unit, token_index)->token.type != TOKEN_EOF) token_index++;
+    unit_cache_store(script->unit);
+    g_error_recovery_point = NULL;
+    interpreter->current_executing_file_path = NULL;
+    echoc_set_error(engine, NULL);
+    return script;
+}
+
+EchoCScript* echoc_compile_file(EchoCEngine* engine, const char* path) {
+    char err_msg[600];
+    struct stat path_stat;
+    if (stat(path, &path_stat) != 0) {
+        snprintf(err_msg, sizeof(err_msg), "Error: Cannot access path '%s'.", path);
+        echoc_set_error(engine, err_msg);
+        return NULL;
+    }
+    if (S_ISDIR(path_stat.st_mode)) {
+        snprintf(err_msg, sizeof(err_msg), "Error: Expected a file, but '%s' is a directory.", path);
+        echoc_set_error(engine, err_msg);
+        return NULL;
+    }
+
+    char load_error[512];
+    SourceUnit* unit = source_unit_load_file(path, load_error, sizeof(load_error));
+    if (!unit) {
+        snprintf(err_msg, sizeof(err_msg), "Error: %s", load_error);
+        echoc_set_error(engine, err_msg);
+        return NULL;
+    }
+
+    char* absolute_path = realpath(path, NULL);
+    if (!absolute_path) {
+        snprintf(err_msg, sizeof(err_msg), "Error: Could not resolve absolute path for input file '%s'", path);
+        echoc_set_error(engine, err_msg);
+        source_unit_decref(unit);
+        return NULL;
+    }
+    return echoc_compile_unit(engine, unit, absolute_path, get_directory_from_path(absolute_path));
+}
+
+EchoCScript* echoc_compile_string(EchoCEngine* engine, const char* source, const char* name) {
+    size_t length = strlen(source);
+    char* source_copy = malloc(length + 1);
+    if (!source_copy) {
+        echoc_set_error(engine, "Error: Could not allocate memory for script source.");
+        return NULL;
+    }
+    memcpy(source_copy, source, length + 1);
+
+    char* directory = NULL;
+    char* cwd = getcwd(NULL, 0);
+    if (cwd) {
+        directory = malloc(strlen(cwd) + 2);
+        if (directory) sprintf(directory, "%s/", cwd);
+        free(cwd);
+    }
+    return echoc_compile_unit(engine, source_unit_create(source_copy, length), strdup(name ? name : "<string>"), directory ? directory : strdup("./"));
+}
+
+void echoc_script_free(EchoCScript* script) {
+    if (!script) return;
+    source_unit_decref(script->unit); // Functions still defined from it keep their own reference
+    free(script->path);
+    free(script->directory);
+    free(script);
+}
+
+static Value echoc_value_to_value(const EchoCValue* in) {
+    Value val = create_null_value();
+    switch (in->type) {
+        case ECHOC_TYPE_BOOL: val.type = VAL_BOOL; val.as.bool_val = in->as.boolean; break;
+        case ECHOC_TYPE_INT: val.type = VAL_INT; val.as.integer = in->as.integer; break;
+        case ECHOC_TYPE_FLOAT: val.type = VAL_FLOAT; val.as.floating = in->as.floating; break;
+        case ECHOC_TYPE_STRING:
+            val.type = VAL_STRING;
+            val.as.string_val = string_value_create(in->as.string ? in->as.string : "");
+            break;
+        default: break; // NULL, and OTHER which cannot be passed in
+    }
+    return val;
+}
+
+EchoCStatus echoc_run(EchoCEngine* engine, EchoCScript* script, const EchoCBinding* bindings, int binding_count) {
+    Interpreter* interpreter = &engine->interpreter;
+    volatile EchoCStatus status = ECHOC_OK; // volatile: set on both sides of setjmp
+    echoc_release_run(engine);
+    echoc_set_error(engine, NULL);
+    g_interpreter_for_error_reporting = interpreter;
+
+    Lexer lexer;
+    source_unit_init_lexer(script->unit, &lexer);
+    interpreter->lexer = &lexer;
+    interpreter->current_executing_file_path = strdup(script->path);
+    interpreter->current_executing_file_directory = strdup(script->directory);
+
+    jmp_buf recovery;
+    g_error_recovery_point = engine->exit_on_error ? NULL : &recovery; // NULL: report_error exits
+    if (setjmp(recovery) == 0) {
+        // Each run gets its own global scope, like a fresh process would
+        Scope* run_scope = calloc(1, sizeof(Scope));
+        if (!run_scope) report_error("System", "Failed to allocate memory for global scope", NULL);
+        run_scope->id = next_scope_id++;
+        engine->run_scope = run_scope;
+        engine->blueprints_before_run = interpreter->all_blueprints_head;
+        interpreter->current_scope = run_scope;
+        for (int i = 0; i < binding_count; ++i) {
+            Value val = echoc_value_to_value(&bindings[i].value);
+            symbol_table_define(run_scope, bindings[i].name, val);
+            free_value_contents(val);
+        }
+
+        interpreter->current_token = get_next_token(&lexer);
+        interpret(interpreter);
+
+        if (interpreter->unhandled_error_occured) {
+            #ifdef DEBUG_ECHOC
+            print_recent_logs_to_stderr_internal();
+            #endif
+            char* err_str = value_to_string_representation(interpreter->current_exception, interpreter, interpreter->error_token);
+            const char* file_path = interpreter->current_executing_file_path ? interpreter->current_executing_file_path : "unknown file";
+            // Failed weave() roots come first, one line each
+            const char* async_errors = interpreter->unhandled_async_errors ? interpreter->unhandled_async_errors : "";
+            size_t message_size = strlen(async_errors) + strlen(err_str) + strlen(file_path) + 96;
+            char* message = malloc(message_size);
+            if (!message) report_error("System", "Failed to allocate memory for error message.", NULL);
+            if (interpreter->error_token) {
+                snprintf(message, message_size, "%s[EchoC Unhandled Exception] in %s at line %d, col %d: %s", async_errors, file_path, interpreter->error_token->line, interpreter->error_token->col, err_str);
+            } else {
+                snprintf(message, message_size, "%s[EchoC Unhandled Exception] in %s (unknown location): %s", async_errors, file_path, err_str);
+            }
+            free(err_str);
+            free(engine->last_error);
+            engine->last_error = message;
+            status = ECHOC_ERROR_EXCEPTION;
+        }
+    } else {
+        echoc_set_error(engine, g_error_recovery_message);
+        status = ECHOC_ERROR_FATAL;
+    }
+    g_error_recovery_point = NULL;
+    echoc_end_run(engine);
+    return status;
+}
+
+bool echoc_get_global(EchoCEngine* engine, const char* name, EchoCValue* out) {
+    if (!engine->run_scope || !name || !out) return false;
+    Value* val = symbol_table_get_local(engine->run_scope, name);
+    if (!val) return false;
+    free(engine->lookup_repr);
+    engine->lookup_repr = NULL;
+    switch (val->type) {
+        case VAL_NULL: out->type = ECHOC_TYPE_NULL; break;
+        case VAL_BOOL: out->type = ECHOC_TYPE_BOOL; out->as.boolean = val->as.bool_val != 0; break;
+        case VAL_INT: out->type = ECHOC_TYPE_INT; out->as.integer = val->as.integer; break;
+        case VAL_FLOAT: out->type = ECHOC_TYPE_FLOAT; out->as.floating = val->as.floating; break;
+        case VAL_STRING: out->type = ECHOC_TYPE_STRING; out->as.string = val->as.string_val; break;
+        default:
+            out->type = ECHOC_TYPE_OTHER;
+            engine->lookup_repr = value_to_string_representation(*val, &engine->interpreter, NULL);
+            out->as.string = engine->lookup_repr;
+            break;
+    }
+    return true;
+}
+
+const char* echoc_last_error(const EchoCEngine* engine) {
+    return engine->last_error ? engine->last_error : "";
+}
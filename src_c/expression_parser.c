@@ -1,12 +1,19 @@
 #include "expression_parser.h"
 #include "statement_parser.h" // For interpret_statement declaration
 #include "parser_utils.h"     // For interpreter_eat
-#include "scope.h"            // For symbol_table_get
+#include "scope.h"            // For symbol_table_get, symbol_table_get_token
 #include "value_utils.h"      // For DynamicString helpers (ds_init, ds_append_str, ds_finalize)
 #include "dictionary.h"       // For dictionary_create, dictionary_set, dictionary_get
 #include "modules/builtins.h" // For builtin_slice
+#include "modules/string_methods.h" // For string_method_lookup (s.split(), s.find(), ...)
 #include "module_loader.h"    // Added: for resolve_module_path and load_module_from_path
 #include "interpreter.h"      // For add_to_ready_queue
+#include "bytecode_vm.h"      // For bytecode_try_eval_expression (--vm)
+#include "object_shape.h"     // For object fields and attribute inline caches
+#include "packed_array.h"     // For packed_array_get, packed_array_equal
+#include "arena.h"            // For arena_strdup (statement-scoped names)
+#include "intern.h"           // For the interned 'self' symbol name
+#include "string_value.h"     // For string values (length, hash, equality, concatenation)
 
 #include <string.h>
 #include <stdlib.h>
@@ -33,13 +40,17 @@ bool value_is_truthy(Value v); // Declaration for use within this file
 Value interpret_dictionary_literal(Interpreter* interpreter);
 static void parse_call_arguments_with_named(Interpreter* interpreter, ParsedArgument args_out[], int* arg_count_out, int max_args, Token* call_site_token_for_errors);
 
-// Helper to check if a function name is a built-in
-static bool is_builtin_function(const char* name) {
+// Helper to check if a function name is a built-in. 'range' came later than scripts that
+// define their own, so it is only a fallback: any visible binding of that name wins.
+static bool is_builtin_function(Interpreter* interpreter, const char* name) {
     if (strcmp(name, "slice") == 0 ||
         strcmp(name, "show") == 0 ||
         strcmp(name, "type") == 0) {
         return true;
     }
+    if (strcmp(name, "range") == 0) {
+        return symbol_table_get(interpreter->current_scope, name) == NULL;
+    }
     return false;
 }
 
@@ -73,22 +84,19 @@ static bool dictionary_deep_equal(Interpreter* interpreter, Dictionary* dict1, D
     if (!dict1 || !dict2) return false; // One is null
     if (dict1->count != dict2->count) return false;
 
-    for (int i = 0; i < dict1->num_buckets; ++i) {
-        DictEntry* entry1 = dict1->buckets[i];
-        while (entry1) {
-            Value val2;
-            // dictionary_try_get with false for deep_copy as we only need to compare
-            if (!dictionary_try_get(dict2, entry1->key, &val2, false)) {
-                return false; // Key from dict1 not in dict2
-            }
-            // Now val2 holds a shallow copy of the value from dict2.
-            // We need to recursively compare entry1->value and val2.
-            if (!values_are_deep_equal(interpreter, entry1->value, val2, error_token)) {
-                // Note: if val2 was a complex type and dictionary_try_get did not deep copy,
-                // its contents are not owned by val2 here. This is fine for comparison.
-                return false;
-            }
-            entry1 = entry1->next;
+    for (int i = 0; i < dict1->count; ++i) {
+        DictEntry* entry1 = &dict1->entries[i];
+        Value val2;
+        // dictionary_try_get with false for deep_copy as we only need to compare
+        if (!dictionary_try_get(dict2, entry1->key, &val2, false)) {
+            return false; // Key from dict1 not in dict2
+        }
+        // Now val2 holds a shallow copy of the value from dict2.
+        // We need to recursively compare entry1->value and val2.
+        if (!values_are_deep_equal(interpreter, entry1->value, val2, error_token)) {
+            // Note: if val2 was a complex type and dictionary_try_get did not deep copy,
+            // its contents are not owned by val2 here. This is fine for comparison.
+            return false;
         }
     }
     return true;
@@ -102,6 +110,9 @@ static bool values_are_deep_equal(Interpreter* interpreter, Value v1, Value v2,
             double d2 = (v2.type == VAL_INT) ? (double)v2.as.integer : v2.as.floating;
             return d1 == d2;
         }
+        // A packed array equals a generic array holding the same numbers
+        if (v1.type == VAL_PACKED_ARRAY && v2.type == VAL_ARRAY) return packed_array_equals_array(v1.as.packed_array_val, v2.as.array_val);
+        if (v1.type == VAL_ARRAY && v2.type == VAL_PACKED_ARRAY) return packed_array_equals_array(v2.as.packed_array_val, v1.as.array_val);
         return false; // Different types are generally not equal
     }
 
@@ -113,7 +124,7 @@ static bool values_are_deep_equal(Interpreter* interpreter, Value v1, Value v2,
         case VAL_STRING:
             if (v1.as.string_val == NULL && v2.as.string_val == NULL) return true;
             if (v1.as.string_val == NULL || v2.as.string_val == NULL) return false;
-            return strcmp(v1.as.string_val, v2.as.string_val) == 0;
+            return string_value_equal(v1.as.string_val, v2.as.string_val);
         case VAL_BOOL:
             return v1.as.bool_val == v2.as.bool_val;
         case VAL_NULL:
@@ -124,6 +135,16 @@ static bool values_are_deep_equal(Interpreter* interpreter, Value v1, Value v2,
             return tuple_deep_equal(interpreter, v1.as.tuple_val, v2.as.tuple_val, error_token);
         case VAL_DICT:
             return dictionary_deep_equal(interpreter, v1.as.dict_val, v2.as.dict_val, error_token);
+        case VAL_PACKED_ARRAY:
+            return packed_array_equal(v1.as.packed_array_val, v2.as.packed_array_val);
+        case VAL_RANGE: {
+            // Ranges are equal if they yield the same integers.
+            const Range* r1 = v1.as.range_val;
+            const Range* r2 = v2.as.range_val;
+            long len = range_length(r1);
+            if (len != range_length(r2)) return false;
+            return len == 0 || (r1->start == r2->start && (len == 1 || r1->step == r2->step));
+        }
         case VAL_FUNCTION:
             // Functions are equal if they are the same instance (pointer equality)
             return v1.as.function_val == v2.as.function_val;
@@ -143,6 +164,16 @@ static bool values_are_deep_equal(Interpreter* interpreter, Value v1, Value v2,
     }
 }
 
+// Longest index/key chain tracked for copy-on-write in interpret_postfix_expr.
+#define ECHOC_COW_PATH_MAX 16
+
+// Extends a copy-on-write slot path by one step; a broken or too deep path is dropped (0).
+static int cow_path_extend(Value** slots, int depth, Value* slot) {
+    if (depth <= 0 || depth >= ECHOC_COW_PATH_MAX) return 0;
+    slots[depth] = slot;
+    return depth + 1;
+}
+
 static bool values_are_identical(Value v1, Value v2) {
     if (v1.type != v2.type) {
         return false;
@@ -165,6 +196,10 @@ static bool values_are_identical(Value v1, Value v2) {
             return v1.as.tuple_val == v2.as.tuple_val;
         case VAL_DICT:
             return v1.as.dict_val == v2.as.dict_val;
+        case VAL_PACKED_ARRAY:
+            return v1.as.packed_array_val == v2.as.packed_array_val;
+        case VAL_RANGE:
+            return v1.as.range_val == v2.as.range_val;
         case VAL_FUNCTION:
             return v1.as.function_val == v2.as.function_val;
         case VAL_BLUEPRINT:
@@ -199,6 +234,10 @@ bool value_is_truthy(Value v) {
             return v.as.tuple_val->count > 0;
         case VAL_DICT:
             return v.as.dict_val->count > 0;
+        case VAL_PACKED_ARRAY:
+            return v.as.packed_array_val->count > 0;
+        case VAL_RANGE:
+            return range_length(v.as.range_val) > 0;
         // All other types are considered "truthy" by default
         case VAL_FUNCTION:
         case VAL_BLUEPRINT:
@@ -272,7 +311,7 @@ Value interpret_dictionary_literal(Interpreter* interpreter) {
 				free_value_contents(temp_dict_val_to_free);
 				return create_null_value();
 			}
-			dictionary_set(dict, key.as.string_val, value_res.value, interpreter->current_token);
+			dictionary_set_hashed(dict, key.as.string_val, string_value_hash(key.as.string_val), value_res.value, interpreter->current_token);
 			if (key_res.is_freshly_created_container) free_value_contents(key);
 			if (value_res.is_freshly_created_container) free_value_contents(value_res.value);
 			if (interpreter->current_token->type == TOKEN_RBRACE) break;
@@ -324,7 +363,7 @@ static void parse_call_arguments_with_named(
                 args_out[*arg_count_out].value = arg_expr_res.value;
                 args_out[*arg_count_out].is_fresh = arg_expr_res.is_freshly_created_container;
                 // START FIX: Check for exception or yield during argument evaluation
-                if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+                if (interpreter->exception_is_active) {
                     // An exception occurred while evaluating an argument.
                     // The argument value might be a partial/dummy value.
                     // The caller (interpret_any_function_call) will see the exception flag and handle cleanup.
@@ -345,7 +384,7 @@ static void parse_call_arguments_with_named(
                 args_out[*arg_count_out].is_fresh = arg_expr_res.is_freshly_created_container;
 
                 // START FIX: Check for exception or yield during argument evaluation
-                if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+                if (interpreter->exception_is_active) {
                     // An exception occurred while evaluating an argument.
                     // The argument value might be a partial/dummy value.
                     // The caller (interpret_any_function_call) will see the exception flag and handle cleanup.
@@ -408,7 +447,7 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
 
     // If an argument expression yielded or raised an exception, we must stop and propagate.
     // The arguments that were parsed will be re-evaluated on resume (for yield) or are now irrelevant (for exception).
-    if ((interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) || interpreter->exception_is_active) {
+    if (interpreter->exception_is_active) {
         // Clean up any arguments that were successfully parsed before the yield/exception.
         for (int i = 0; i < arg_count; ++i) {
             if (parsed_args[i].name) free(parsed_args[i].name);
@@ -422,15 +461,15 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
 
     if (bound_method_val_or_null && bound_method_val_or_null->type == VAL_BOUND_METHOD) {
         BoundMethod* bm = bound_method_val_or_null->as.bound_method_val;
-        if (bm->type == FUNC_TYPE_C_BUILTIN && bm->func_ptr.c_builtin == builtin_append) {
+        if (bm->type == FUNC_TYPE_C_BUILTIN) { // array.append, string methods
             // For C builtins, convert ParsedArgument to simple Value array and disallow named args.
             Value final_args_for_c_builtin[11]; // self + max 10 args
-            final_args_for_c_builtin[0] = bm->self_value; // Array is self
+            final_args_for_c_builtin[0] = bm->self_value; // The array or string is self
             for (int i = 0; i < arg_count; ++i) {
-                if (parsed_args[i].name) report_error("Runtime", "Built-in method 'append' does not support named arguments.", func_name_token_for_error_reporting);
+                if (parsed_args[i].name) report_error("Runtime", "Built-in methods do not support named arguments.", func_name_token_for_error_reporting);
                 final_args_for_c_builtin[i+1] = parsed_args[i].value;
             }
-            result = builtin_append(interpreter, final_args_for_c_builtin, arg_count + 1, func_name_token_for_error_reporting);
+            result = bm->func_ptr.c_builtin(interpreter, final_args_for_c_builtin, arg_count + 1, func_name_token_for_error_reporting);
             // Cleanup parsed_args
             for (int i = 0; i < arg_count; ++i) {
                 if (parsed_args[i].name) free(parsed_args[i].name);
@@ -465,19 +504,17 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
                 coro->creation_col = func_name_token_for_error_reporting->col;
                 coro->function_def = func_to_run;
                 coro->ref_count = 1;
-                coro->statement_resume_state = func_to_run->body_start_state;
-                coro->statement_resume_state.text = func_to_run->source_text_owned_copy;
-                coro->statement_resume_state.text_length = func_to_run->source_text_length;
 
                 Scope* old_interpreter_scope = interpreter->current_scope;
                 interpreter->current_scope = func_to_run->definition_scope;
                 enter_scope(interpreter);
                 coro->execution_scope = interpreter->current_scope;
+                scope_attach_frame(coro->execution_scope, func_to_run);
 
                 // Manually insert 'self' into the new coroutine's scope
                 SymbolNode* self_node = (SymbolNode*)malloc(sizeof(SymbolNode));
                 if (!self_node) { /* error handling */ }
-                self_node->name = strdup("self");
+                self_node->name = intern_acquire("self");
                 self_node->value.type = VAL_OBJECT;
                 self_node->value.as.object_val = self_obj_ptr;
                 self_node->next = coro->execution_scope->symbols;
@@ -534,8 +571,6 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
                 coro->value_from_await = create_null_value();
                 coro->gather_first_exception_idx = -1;
                 coro->try_catch_stack_top = NULL;
-                coro->has_yielding_await_state = false;
-                coro->yielding_await_token = NULL;
 
                 result.type = VAL_COROUTINE;
                 result.as.coroutine_val = coro;
@@ -568,15 +603,13 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
             coro->creation_col = func_name_token_for_error_reporting->col;
             coro->function_def = func_to_run;
             coro->ref_count = 1;
-            coro->statement_resume_state = func_to_run->body_start_state;
-            coro->statement_resume_state.text = func_to_run->source_text_owned_copy;
-            coro->statement_resume_state.text_length = func_to_run->source_text_length;
             DEBUG_PRINTF("CORO_CREATE (Resolved VAL_FUNCTION): Initialized ref_count for %s (%p) to 1", func_to_run->name, (void*)coro);
 
             Scope* old_interpreter_scope = interpreter->current_scope;
             interpreter->current_scope = func_to_run->definition_scope;
             enter_scope(interpreter);
             coro->execution_scope = interpreter->current_scope;
+            scope_attach_frame(coro->execution_scope, func_to_run);
 
             int min_required_args = 0;
             for (int i = 0; i < func_to_run->param_count; ++i) {
@@ -624,8 +657,6 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
             coro->value_from_await = create_null_value();
             coro->gather_first_exception_idx = -1;
             coro->try_catch_stack_top = NULL;
-            coro->has_yielding_await_state = false; // Initialize new field
-            coro->yielding_await_token = NULL;
 
             result.type = VAL_COROUTINE;
             result.as.coroutine_val = coro;
@@ -640,7 +671,7 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
         }
         const char* func_name_str = func_name_str_or_null_for_bound;
         
-        if (is_builtin_function(func_name_str)) {
+        if (is_builtin_function(interpreter, func_name_str)) {
             if (strcmp(func_name_str, "show") == 0) {
                 result = builtin_show(interpreter, parsed_args, arg_count, func_name_token_for_error_reporting);
             } else {
@@ -658,6 +689,8 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
                     result = builtin_slice(interpreter, simple_args, arg_count, func_name_token_for_error_reporting);
                 } else if (strcmp(func_name_str, "type") == 0) {
                     result = builtin_type(interpreter, simple_args, arg_count, func_name_token_for_error_reporting);
+                } else if (strcmp(func_name_str, "range") == 0) {
+                    result = builtin_range(interpreter, simple_args, arg_count, func_name_token_for_error_reporting);
                 }
             }
             // Centralized cleanup for ALL built-ins.
@@ -685,15 +718,13 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
                     coro->creation_col = func_name_token_for_error_reporting->col;
                     coro->function_def = func_to_run;
                     coro->ref_count = 1;
-                    coro->statement_resume_state = func_to_run->body_start_state;
-                    coro->statement_resume_state.text = func_to_run->source_text_owned_copy;
-                    coro->statement_resume_state.text_length = func_to_run->source_text_length;
                     DEBUG_PRINTF("CORO_CREATE (EchoC): Initialized ref_count for %s (%p) to 1", func_to_run->name, (void*)coro);
 
                     Scope* old_interpreter_scope = interpreter->current_scope;
                     interpreter->current_scope = func_to_run->definition_scope;
                     enter_scope(interpreter);
                     coro->execution_scope = interpreter->current_scope;
+                    scope_attach_frame(coro->execution_scope, func_to_run);
 
                     int min_required_args = 0;
                     for (int i = 0; i < func_to_run->param_count; ++i) {
@@ -741,8 +772,6 @@ Value interpret_any_function_call(Interpreter* interpreter, const char* func_nam
                     coro->value_from_await = create_null_value();
                     coro->gather_first_exception_idx = -1;
                     coro->try_catch_stack_top = NULL;
-                    coro->has_yielding_await_state = false; // Initialize new field
-                    coro->yielding_await_token = NULL;
 
                     result.type = VAL_COROUTINE;
                     result.as.coroutine_val = coro;
@@ -784,10 +813,9 @@ Value interpret_instance_creation(Interpreter* interpreter, Blueprint* bp_to_ins
     DEBUG_PRINTF("INSTANCE_CREATE: Created [Object #%llu] of blueprint '%s' at %p", new_obj->id, bp_to_instantiate->name, (void*)new_obj);
     new_obj->ref_count = 1; // Initialize ref_count
     new_obj->blueprint = bp_to_instantiate;
-    new_obj->instance_attributes = malloc(sizeof(Scope));
-    if (!new_obj->instance_attributes) { free(new_obj); report_error("System", "Failed to allocate instance attributes scope.", call_site_token); }
-    new_obj->instance_attributes->symbols = NULL;
-    new_obj->instance_attributes->outer = NULL; // Instance scope is isolated
+    new_obj->shape = blueprint_root_shape(bp_to_instantiate);
+    new_obj->fields = NULL; // Allocated when init adds the first field
+    new_obj->field_capacity = 0;
 
     Value instance_val;
     instance_val.type = VAL_OBJECT;
@@ -809,7 +837,7 @@ Value interpret_instance_creation(Interpreter* interpreter, Blueprint* bp_to_ins
             // EchoC's 'run:' or an internal mechanism would be needed to execute this async init.
             // For now, we'll disallow async init or treat it as an error.
             // Free allocated object and its attributes before reporting error.
-            free_scope(new_obj->instance_attributes); // This frees the scope struct and its symbols
+            object_free_fields(new_obj);
             free(new_obj); // Free the object struct
             report_error("Runtime", "'init' method cannot be 'async'.", call_site_token);
             for (int i = 0; i < arg_count; ++i) {
@@ -827,9 +855,7 @@ Value interpret_instance_creation(Interpreter* interpreter, Blueprint* bp_to_ins
         // No explicit init. Check if any arguments were passed.
         if (arg_count > 0) { // Arguments were parsed by parse_call_arguments
             // Free allocated object and its attributes before reporting error.
-            if (new_obj->instance_attributes) {
-                free_scope(new_obj->instance_attributes); // This frees the scope struct and its symbols
-            }
+            object_free_fields(new_obj);
             free(new_obj); // Free the object struct
             for (int i = 0; i < arg_count; ++i) {
                 if (parsed_args[i].name) free(parsed_args[i].name);
@@ -848,6 +874,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
     ExprResult expr_res;
     expr_res.is_standalone_primary_id = false; // Default for most primaries
     expr_res.is_freshly_created_container = false; // Default
+    expr_res.source_slot = NULL;
 
     if (token->type == TOKEN_LBRACE) { 
         expr_res.value = interpret_dictionary_literal(interpreter);
@@ -880,7 +907,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
         interpreter_eat(interpreter, TOKEN_STRING);
  
         // Now, handle the result.
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             // If an error occurred, the value from evaluate_interpolated_string is a dummy VAL_NULL, so no need to free it here.
             DEBUG_PRINTF("PRIMARY_EXPR: Exception or Yield propagated from string interpolation. Cleaning up.%s", "");
             // The returned value is a dummy. Mark it as not fresh.
@@ -915,6 +942,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
             Tuple* tuple = malloc(sizeof(Tuple));
             if (!tuple) report_error("System", "Failed to allocate memory for empty tuple struct", lparen_token_for_error_context);
             tuple->count = 0;
+            tuple->ref_count = 1;
             tuple->elements = NULL;
             val.type = VAL_TUPLE;
             val.as.tuple_val = tuple;
@@ -922,7 +950,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
             return expr_res;
         } else { 
             ExprResult first_element_res = interpret_expression(interpreter);
-            if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+            if (interpreter->exception_is_active) {
                 // If the very first item in a potential tuple yields, just propagate.
                 // No tuple has been allocated yet. The caller will handle freeing first_element_res if needed.
                 return first_element_res;
@@ -932,13 +960,14 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
                 
                 Tuple* tuple = malloc(sizeof(Tuple));
                 if (!tuple) report_error("System", "Failed to allocate memory for tuple struct", lparen_token_for_error_context);
+                tuple->ref_count = 1;
                 
                 int capacity = 8;
                 tuple->elements = malloc(capacity * sizeof(Value));
                 if (!tuple->elements) { free(tuple); report_error("System", "Failed to allocate memory for tuple elements", lparen_token_for_error_context); }
                 
                 tuple->count = 0;
-                tuple->elements[tuple->count++] = first_element_res.value; // Store Value part
+                tuple->elements[tuple->count++] = first_element_res.is_freshly_created_container ? first_element_res.value : value_deep_copy(first_element_res.value);
 
                 while (interpreter->current_token->type != TOKEN_RPAREN && interpreter->current_token->type != TOKEN_EOF) {
                     if (tuple->count >= capacity) {
@@ -948,16 +977,14 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
                     }
                     ExprResult next_elem_res = interpret_expression(interpreter);
                     
-                    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+                    if (interpreter->exception_is_active) {
                         // An element's expression yielded. We must clean up the partial tuple.
                         if (next_elem_res.is_freshly_created_container) free_value_contents(next_elem_res.value);
-                        // Also free the first element that was stored
-                        if (first_element_res.is_freshly_created_container) free_value_contents(first_element_res.value);
                         Value temp_tuple_val = {.type = VAL_TUPLE, .as.tuple_val = tuple};
                         free_value_contents(temp_tuple_val); // This will free the tuple and its elements
                         return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
                     }
-                    tuple->elements[tuple->count++] = next_elem_res.value;
+                    tuple->elements[tuple->count++] = next_elem_res.is_freshly_created_container ? next_elem_res.value : value_deep_copy(next_elem_res.value);
                     if (interpreter->current_token->type == TOKEN_COMMA) {
                         interpreter_eat(interpreter, TOKEN_COMMA);
                     } else {
@@ -976,7 +1003,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
         }
         report_error("Internal", "Reached end of TOKEN_LPAREN block in interpret_primary_expr unexpectedly.", lparen_token_for_error_context);
     } else if (token->type == TOKEN_ID) {
-        char* id_name = strdup(interpreter->current_token->value);
+        char* id_name = arena_strdup(interpreter->scratch, interpreter->current_token->value);
         DEBUG_PRINTF("PRIMARY_EXPR_ID_START: Current token before eat: %s ('%s'), id_name: '%s'",
                      token_type_to_string(interpreter->current_token->type),
                      interpreter->current_token->value, id_name);
@@ -991,7 +1018,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
 
         if (interpreter->current_token->type == TOKEN_LPAREN) { // It's a call expression
             // First, check if it's a built-in function call.
-            if (is_builtin_function(id_name)) {
+            if (is_builtin_function(interpreter, id_name)) {
                 expr_res.value = interpret_any_function_call(interpreter, id_name, id_token_for_reporting, NULL);
                 // Mark the result as a fresh container if it is one
                 if (expr_res.value.type >= VAL_STRING && expr_res.value.type <= VAL_GATHER_TASK) {
@@ -999,7 +1026,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
                 }
             } else {
                 // If not a built-in, look it up in the symbol table.
-                Value* id_val_ptr = symbol_table_get(interpreter->current_scope, id_name);
+                Value* id_val_ptr = symbol_table_get_token(interpreter->current_scope, id_token_for_reporting);
 
                 if (id_val_ptr && id_val_ptr->type == VAL_BLUEPRINT) {
                     // It's a blueprint instantiation.
@@ -1018,7 +1045,6 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
                     // If it's not a built-in, not a blueprint, and not a user function, it's an error.
                     char err_msg[300];
                     snprintf(err_msg, sizeof(err_msg), "Identifier '%s' is not a callable function or instantiable blueprint.", id_name);
-                    free(id_name);
                     free_token(id_token_for_reporting);
                     report_error("Runtime", err_msg, id_token_for_reporting);
                 }
@@ -1028,7 +1054,6 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
         // If not a call, it's a variable or super
         else if (strcmp(id_name, "super") == 0) { // Changed to else if
             if (!interpreter->current_self_object) {
-                free(id_name);
                 free_token(id_token_for_reporting);
                 report_error("Runtime", "'super' can only be used within an instance method.", id_token_for_reporting);
             }
@@ -1047,7 +1072,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
             // No data needed in val.as for VAL_SUPER_PROXY
             expr_res.value = val; expr_res.is_standalone_primary_id = false;
         } else {
-            Value* var_val_ptr = symbol_table_get(interpreter->current_scope, id_name); // Regular variable lookup
+            Value* var_val_ptr = symbol_table_get_token(interpreter->current_scope, id_token_for_reporting); // Slot or name lookup
             // Add this debug log to check the scope's head just before the lookup
             DEBUG_PRINTF("PRIMARY_EXPR_ID_LOOKUP: Var '%s'. Scope %p. Scope symbols head: %s. Outer: %p",
                          id_name, (void*)interpreter->current_scope, 
@@ -1067,11 +1092,10 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
             if (var_val_ptr == NULL) {
                 char err_msg[100];
                 snprintf(err_msg, sizeof(err_msg), "Undefined variable '%s'", id_name);
-                free(id_name);
                 interpreter->exception_is_active = 1;
                 free_value_contents(interpreter->current_exception);
                 interpreter->current_exception.type = VAL_STRING;
-                interpreter->current_exception.as.string_val = strdup(err_msg);
+                interpreter->current_exception.as.string_val = string_value_create(err_msg);
                 if (interpreter->error_token) free_token(interpreter->error_token);
                 interpreter->error_token = id_token_for_reporting; // Transfer ownership of the token
                 expr_res.value = create_null_value(); // Return a dummy value
@@ -1083,16 +1107,19 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
             // When a container is retrieved by name, we want a "view" (shallow copy of the Value struct)
             // not a deep copy, so that subsequent operations like indexing work on the original data.
             // This prevents the original container from being freed prematurely by the postfix expression handler.
-            if (var_val_ptr->type == VAL_OBJECT || var_val_ptr->type == VAL_ARRAY || var_val_ptr->type == VAL_DICT || var_val_ptr->type == VAL_TUPLE) {
+            if (var_val_ptr->type == VAL_OBJECT || var_val_ptr->type == VAL_ARRAY || var_val_ptr->type == VAL_DICT || var_val_ptr->type == VAL_TUPLE ||
+                var_val_ptr->type == VAL_PACKED_ARRAY || var_val_ptr->type == VAL_RANGE) {
                 expr_res.value = *var_val_ptr; // Shallow copy of Value struct; shares the data pointer.
                 expr_res.is_freshly_created_container = false;
                 expr_res.is_standalone_primary_id = true; // This is a standalone ID lookup
+                expr_res.source_slot = var_val_ptr;
             } else {
                 expr_res.value = value_deep_copy(*var_val_ptr);
                 // If value_deep_copy created a new container (string, array, dict, tuple, object, function, coroutine)
                 // or a new reference-counted handle (coroutine), it's considered "fresh" in terms of this Value wrapper.
                 if (expr_res.value.type == VAL_STRING || expr_res.value.type == VAL_ARRAY ||
-                    expr_res.value.type == VAL_DICT || expr_res.value.type == VAL_TUPLE ||
+                    expr_res.value.type == VAL_DICT || expr_res.value.type == VAL_TUPLE || expr_res.value.type == VAL_PACKED_ARRAY ||
+                    expr_res.value.type == VAL_RANGE ||
                     expr_res.value.type == VAL_FUNCTION || // Functions are still copied (new Function struct)
                     expr_res.value.type == VAL_COROUTINE || expr_res.value.type == VAL_GATHER_TASK) { // Coroutines are ref-counted
                     expr_res.is_freshly_created_container = true;
@@ -1107,7 +1134,6 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
                 }
             }
         }
-        free(id_name); // Free the strdup'd name
         free_token(id_token_for_reporting); // Free the deep-copied token
         DEBUG_PRINTF("PRIMARY_EXPR_ID_END: Current token before return: %s ('%s')",
                      token_type_to_string(interpreter->current_token->type),
@@ -1128,6 +1154,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
         if (!array) report_error("System", "Failed to allocate memory for array struct", token);
         array->count = 0;
         array->capacity = 8;
+        array->ref_count = 1;
         array->elements = malloc(array->capacity * sizeof(Value));
         if (!array->elements) {
             free(array);
@@ -1154,7 +1181,8 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
                     return error_res;
                 }
 
-                array->elements[array->count++] = elem_res.value;
+                // A view of a variable's container takes its own reference (O(1) for shared containers).
+                array->elements[array->count++] = elem_res.is_freshly_created_container ? elem_res.value : value_deep_copy(elem_res.value);
                 if (interpreter->current_token->type == TOKEN_COMMA) {
                     interpreter_eat(interpreter, TOKEN_COMMA);
                 } else {
@@ -1176,7 +1204,7 @@ ExprResult interpret_primary_expr(Interpreter* interpreter) {
 ExprResult interpret_postfix_expr(Interpreter* interpreter) {
     ExprResult current_expr_res = interpret_primary_expr(interpreter);
     // If the primary expression itself yielded or had an error, propagate immediately.
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return current_expr_res;
     }
 
@@ -1184,7 +1212,17 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
     // is_freshly_created_container applies to this initial 'result'
     bool result_is_freshly_created = current_expr_res.is_freshly_created_container;
     bool is_still_standalone_id = current_expr_res.is_standalone_primary_id;
-    
+
+    // While 'result' is a view: the slot of the variable (or object attribute) it came
+    // from, followed by one slot per index/key step. array.append un-shares every
+    // container along this path before mutating (copy-on-write).
+    Value* cow_slots[ECHOC_COW_PATH_MAX];
+    int cow_depth = 0;
+    if (!result_is_freshly_created && is_still_standalone_id && current_expr_res.source_slot &&
+        current_expr_res.source_slot->type == result.type) {
+        cow_slots[cow_depth++] = current_expr_res.source_slot;
+    }
+
     while (interpreter->current_token->type == TOKEN_LBRACKET ||
            interpreter->current_token->type == TOKEN_DOT ||
            (result.type == VAL_FUNCTION && interpreter->current_token->type == TOKEN_LPAREN) || /* Function call on a resolved VAL_FUNCTION */
@@ -1194,6 +1232,8 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
           ) {
         Value next_derived_value; // This will become the new 'result'
         bool next_derived_is_fresh = false; // And its freshness
+        int base_cow_depth = cow_depth; // Path of the current 'result'
+        cow_depth = 0;
         is_still_standalone_id = false; // Any postfix operation means it's no longer a standalone ID
 
         if (result.type == VAL_FUNCTION && interpreter->current_token->type == TOKEN_LPAREN) {
@@ -1215,6 +1255,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
             if (next_derived_value.type == VAL_OBJECT || next_derived_value.type == VAL_ARRAY ||
                 next_derived_value.type == VAL_DICT || next_derived_value.type == VAL_STRING ||
                 next_derived_value.type == VAL_TUPLE || next_derived_value.type == VAL_BOUND_METHOD ||
+                next_derived_value.type == VAL_PACKED_ARRAY || next_derived_value.type == VAL_RANGE ||
                 next_derived_value.type == VAL_COROUTINE || next_derived_value.type == VAL_GATHER_TASK) {
                 next_derived_is_fresh = true;
             } else {
@@ -1261,7 +1302,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
             interpreter->exception_is_active = 1;
             free_value_contents(interpreter->current_exception);
             interpreter->current_exception.type = VAL_STRING;
-            interpreter->current_exception.as.string_val = strdup("Cannot call a coroutine object directly. Use 'await' or 'weaver.spawn_task'.");
+            interpreter->current_exception.as.string_val = string_value_create("Cannot call a coroutine object directly. Use 'await' or 'weaver.spawn_task'.");
             if (interpreter->error_token) free_token(interpreter->error_token);
             interpreter->error_token = token_deep_copy(interpreter->current_token); // Use current token (LPAREN) for error context
             // The loop will break and propagate this error.
@@ -1276,7 +1317,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
             Value index_val = index_expr_res.value;
             bool index_is_fresh = index_expr_res.is_freshly_created_container;
             
-            if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) { // Exception or YIELD during index expression parsing
+            if (interpreter->exception_is_active) { // Exception or YIELD during index expression parsing
                 if(result_is_freshly_created) free_value_contents(result); // Free base if it was fresh
                 if(index_expr_res.is_freshly_created_container) free_value_contents(index_val);
                 free_token(bracket_token);
@@ -1284,11 +1325,6 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false, .is_standalone_primary_id = false };
             }
 
-            char* base_str_for_debug = value_to_string_representation(result, interpreter, bracket_token);
-            char* index_str_for_debug = value_to_string_representation(index_val, interpreter, bracket_token);
-            free(base_str_for_debug);
-            free(index_str_for_debug);
-
             if (result.type == VAL_ARRAY) {
                 if (index_val.type != VAL_INT) {
                     if(result_is_freshly_created) free_value_contents(result); // Free the base
@@ -1297,7 +1333,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("Array index must be an integer.");
+                    interpreter->current_exception.as.string_val = string_value_create("Array index must be an integer.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
@@ -1314,7 +1350,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("Array index out of bounds.");
+                    interpreter->current_exception.as.string_val = string_value_create("Array index out of bounds.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
@@ -1324,6 +1360,56 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 // The caller (e.g., assignment) is responsible for deep copying if needed.
                 next_derived_value = arr_ptr->elements[effective_idx];
                 next_derived_is_fresh = false;
+                cow_depth = cow_path_extend(cow_slots, base_cow_depth, &arr_ptr->elements[effective_idx]);
+            } else if (result.type == VAL_PACKED_ARRAY) {
+                if (index_val.type != VAL_INT) {
+                    if(result_is_freshly_created) free_value_contents(result);
+                    if(index_is_fresh) free_value_contents(index_val);
+                    report_error("Runtime", "Array index must be an integer.", bracket_token);
+                }
+                PackedArray* packed_ptr = result.as.packed_array_val;
+                long effective_idx = index_val.as.integer;
+                if (effective_idx < 0) effective_idx += packed_ptr->count;
+
+                if (effective_idx < 0 || effective_idx >= packed_ptr->count) {
+                    if(result_is_freshly_created) free_value_contents(result);
+                    interpreter->exception_is_active = 1;
+                    free_value_contents(interpreter->current_exception);
+                    interpreter->current_exception.type = VAL_STRING;
+                    interpreter->current_exception.as.string_val = string_value_create("Array index out of bounds.");
+                    if (interpreter->error_token) free_token(interpreter->error_token);
+                    interpreter->error_token = token_deep_copy(bracket_token);
+                    free_token(bracket_token);
+                    return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
+                }
+                // Elements are unboxed into a plain int or float; there is no slot to share.
+                next_derived_value = packed_array_get(packed_ptr, (int)effective_idx);
+                next_derived_is_fresh = false;
+            } else if (result.type == VAL_RANGE) {
+                if (index_val.type != VAL_INT) {
+                    if(result_is_freshly_created) free_value_contents(result);
+                    if(index_is_fresh) free_value_contents(index_val);
+                    report_error("Runtime", "Range index must be an integer.", bracket_token);
+                }
+                Range* range_ptr = result.as.range_val;
+                long range_len = range_length(range_ptr);
+                long effective_idx = index_val.as.integer;
+                if (effective_idx < 0) effective_idx += range_len;
+
+                if (effective_idx < 0 || effective_idx >= range_len) {
+                    if(result_is_freshly_created) free_value_contents(result);
+                    interpreter->exception_is_active = 1;
+                    free_value_contents(interpreter->current_exception);
+                    interpreter->current_exception.type = VAL_STRING;
+                    interpreter->current_exception.as.string_val = string_value_create("Range index out of bounds.");
+                    if (interpreter->error_token) free_token(interpreter->error_token);
+                    interpreter->error_token = token_deep_copy(bracket_token);
+                    free_token(bracket_token);
+                    return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
+                }
+                next_derived_value.type = VAL_INT;
+                next_derived_value.as.integer = range_ptr->start + effective_idx * range_ptr->step;
+                next_derived_is_fresh = false;
             } else if (result.type == VAL_DICT) {
                 if (index_val.type != VAL_STRING) {
                     if(result_is_freshly_created) free_value_contents(result);
@@ -1331,17 +1417,16 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("Dictionary key must be a string.");
+                    interpreter->current_exception.as.string_val = string_value_create("Dictionary key must be a string.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
                     return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
                 }
-                Value element;
-
                 // Get a view (shallow copy of Value struct) of the element.
                 // The caller (e.g., assignment) is responsible for deep copying if needed.
-                if (!dictionary_try_get(result.as.dict_val, index_val.as.string_val, &element, false)) {
+                Value* element_ptr = dictionary_try_get_value_ptr_hashed(result.as.dict_val, index_val.as.string_val, string_value_hash(index_val.as.string_val));
+                if (!element_ptr) {
                     char err_msg[150];
                     snprintf(err_msg, sizeof(err_msg), "Key '%s' not found in dictionary.", index_val.as.string_val);
                     if(result_is_freshly_created) free_value_contents(result); // Free the base
@@ -1349,15 +1434,16 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup(err_msg);
+                    interpreter->current_exception.as.string_val = string_value_create(err_msg);
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
 
                     free_token(bracket_token);
                     return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
                 }
-                next_derived_value = element; // 'element' is a shallow copy of the Value struct.
+                next_derived_value = *element_ptr; // A shallow copy of the Value struct.
                 next_derived_is_fresh = false; // It's a view, not a fresh container.
+                cow_depth = cow_path_extend(cow_slots, base_cow_depth, element_ptr);
             } else if (result.type == VAL_STRING) {
                 if (index_val.type != VAL_INT) {
                     if(result_is_freshly_created) free_value_contents(result);
@@ -1365,33 +1451,29 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("String index must be an integer.");
+                    interpreter->current_exception.as.string_val = string_value_create("String index must be an integer.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
                     return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
                 }
                 long idx = index_val.as.integer;
-                size_t str_len = strlen(result.as.string_val);
+                size_t str_len = string_value_length(result.as.string_val);
                 if (idx < 0) idx = (long)str_len + idx;
                 if (idx < 0 || (size_t)idx >= str_len) { // Cast idx to size_t for comparison
                     if(result_is_freshly_created) free_value_contents(result); // Free the base
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("String index out of bounds.");
+                    interpreter->current_exception.as.string_val = string_value_create("String index out of bounds.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
                     return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
                 }
-                char* charStr = malloc(2);
-                if (!charStr) report_error("System", "Memory allocation failed during string indexing.", bracket_token);
-                charStr[0] = result.as.string_val[idx];
-                charStr[1] = '\0';
                 // index_val (if int) has no complex contents.
-                next_derived_value.type = VAL_STRING; // This is a new string
-                next_derived_value.as.string_val = charStr;
+                next_derived_value.type = VAL_STRING; // A shared one-character string, nothing to allocate
+                next_derived_value.as.string_val = string_value_char((unsigned char)result.as.string_val[idx]);
                 next_derived_is_fresh = true; // New string
             } else if (result.type == VAL_TUPLE) {
                 if (index_val.type != VAL_INT) {
@@ -1400,7 +1482,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("Tuple index must be an integer.");
+                    interpreter->current_exception.as.string_val = string_value_create("Tuple index must be an integer.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
@@ -1416,7 +1498,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                     free_value_contents(interpreter->current_exception);
                     interpreter->current_exception.type = VAL_STRING;
-                    interpreter->current_exception.as.string_val = strdup("Tuple index out of bounds.");
+                    interpreter->current_exception.as.string_val = string_value_create("Tuple index out of bounds.");
                     if (interpreter->error_token) free_token(interpreter->error_token);
                     interpreter->error_token = token_deep_copy(bracket_token);
                     free_token(bracket_token);
@@ -1426,13 +1508,14 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 // The caller (e.g., assignment) is responsible for deep copying if needed.
                 next_derived_value = tuple_ptr->elements[effective_idx];
                 next_derived_is_fresh = false;
+                cow_depth = cow_path_extend(cow_slots, base_cow_depth, &tuple_ptr->elements[effective_idx]);
             } else {
                 if(result_is_freshly_created) free_value_contents(result);
                 if(index_is_fresh) free_value_contents(index_val);
                 interpreter->exception_is_active = 1; // This part is likely unreachable due to report_error exiting
                 free_value_contents(interpreter->current_exception);
                 interpreter->current_exception.type = VAL_STRING;
-                interpreter->current_exception.as.string_val = strdup("Can only index into arrays, strings, dictionaries, or tuples.");
+                interpreter->current_exception.as.string_val = string_value_create("Can only index into arrays, strings, dictionaries, or tuples.");
                 if (interpreter->error_token) free_token(interpreter->error_token);
                 interpreter->error_token = token_deep_copy(bracket_token);
                 free_token(bracket_token);
@@ -1462,8 +1545,9 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 report_error("Syntax", "Expected identifier or valid attribute keyword after '.' for attribute/method access.", dot_token);
                 free_token(dot_token); // Free the copy if report_error didn't exit (though it does)
             }
-            char* attr_name = strdup(attr_name_value);
-            /* Token* attr_name_token = token_deep_copy(interpreter->current_token); // Marked as unused */
+            char* attr_name = arena_strdup(interpreter->scratch, attr_name_value);
+            // Cached tokens outlive the eat below and hold the inline cache for obj.attr (see object_shape.h)
+            const Token* attr_site = interpreter->current_token->is_borrowed ? interpreter->current_token : NULL;
             interpreter_eat(interpreter, actual_token_type_after_dot); // Eat the token based on its actual type
 
             bool attribute_handled_by_special_case = false;
@@ -1476,7 +1560,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     attribute_handled_by_special_case = true;
                 } else if (result.type == VAL_STRING) {
                     next_derived_value.type = VAL_INT;
-                    next_derived_value.as.integer = (long)strlen(result.as.string_val);
+                    next_derived_value.as.integer = (long)string_value_length(result.as.string_val);
                     next_derived_is_fresh = false;
                     attribute_handled_by_special_case = true;
                 } else if (result.type == VAL_DICT) {
@@ -1489,6 +1573,16 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     next_derived_value.as.integer = result.as.tuple_val->count;
                     next_derived_is_fresh = false;
                     attribute_handled_by_special_case = true;
+                } else if (result.type == VAL_PACKED_ARRAY) {
+                    next_derived_value.type = VAL_INT;
+                    next_derived_value.as.integer = result.as.packed_array_val->count;
+                    next_derived_is_fresh = false;
+                    attribute_handled_by_special_case = true;
+                } else if (result.type == VAL_RANGE) {
+                    next_derived_value.type = VAL_INT;
+                    next_derived_value.as.integer = range_length(result.as.range_val);
+                    next_derived_is_fresh = false;
+                    attribute_handled_by_special_case = true;
                 } else {
                     // If not one of the above, let it fall through to standard attribute access
                     // which will likely fail if 'len' is not a defined field/method for VAL_OBJECT etc.
@@ -1513,20 +1607,12 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     // The 'result' will be freed by the caller if it was a temporary.
                     // No need to set attribute_handled_by_special_case here as it's the end of VAL_OBJECT specific logic for "blueprint"
                 } else {
-                    Value* attr_val_ptr = symbol_table_get_local(obj->instance_attributes, attr_name); // Check instance attributes first
-                    if (!attr_val_ptr) { // Not in instance, check class attributes/methods
-                        Blueprint* current_bp = obj->blueprint;
-                        while (current_bp) {
-                            attr_val_ptr = symbol_table_get_local(current_bp->class_attributes_and_methods, attr_name);
-                            if (attr_val_ptr) break;
-                            current_bp = current_bp->parent_blueprint;
-                        }
-                    }
+                    Value* attr_val_ptr = object_find_attribute(obj, attr_site, attr_name); // Instance fields, then class attributes/methods
 
                     if (!attr_val_ptr) {
                         char err_msg[150];
                         snprintf(err_msg, sizeof(err_msg), "Object of blueprint '%s' has no attribute or method '%s'.", obj->blueprint->name, attr_name);
-                        free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                        if(result_is_freshly_created) free_value_contents(result);
                         report_error("Runtime", err_msg, dot_token);
                         free_token(dot_token);
                     }
@@ -1534,7 +1620,6 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     if (attr_val_ptr->type == VAL_FUNCTION) {
                         BoundMethod* bm = malloc(sizeof(BoundMethod));
                         if (!bm) {
-                            free(attr_name);
                             free_token(dot_token);
                             if(result_is_freshly_created) free_value_contents(result);
                             report_error("System", "Failed to allocate memory for bound method for object attribute.", dot_token);
@@ -1550,17 +1635,21 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                         next_derived_is_fresh = true; // BoundMethod is a new container struct
                     } else { // Regular attribute
                         if (!result_is_freshly_created &&
-                            (attr_val_ptr->type == VAL_OBJECT || attr_val_ptr->type == VAL_ARRAY || attr_val_ptr->type == VAL_DICT)) {
+                            (attr_val_ptr->type == VAL_OBJECT || attr_val_ptr->type == VAL_ARRAY || attr_val_ptr->type == VAL_DICT ||
+                             attr_val_ptr->type == VAL_PACKED_ARRAY)) {
                             // If the base object 'result' is not fresh (e.g., it's 'self' or a variable),
                             // and the attribute is a container, get a shallow copy (view) of the attribute.
                             next_derived_value = *attr_val_ptr; // Shallow copy of Value struct
                             next_derived_is_fresh = false;      // This view is not a fresh container
+                            cow_slots[0] = attr_val_ptr;        // Objects are shared by design; the path restarts here
+                            cow_depth = 1;
                         } else {
                             // If base object 'result' IS fresh, or attribute is not a container, deep copy the attribute.
                             next_derived_value = value_deep_copy(*attr_val_ptr);
                             // Mark as fresh if it's a container type that value_deep_copy creates anew
                             if (next_derived_value.type == VAL_STRING || next_derived_value.type == VAL_ARRAY ||
                                 next_derived_value.type == VAL_DICT || next_derived_value.type == VAL_TUPLE ||
+                                next_derived_value.type == VAL_PACKED_ARRAY || next_derived_value.type == VAL_RANGE ||
                                 next_derived_value.type == VAL_OBJECT || next_derived_value.type == VAL_FUNCTION ||
                                 next_derived_value.type == VAL_COROUTINE || next_derived_value.type == VAL_GATHER_TASK) {
                                 next_derived_is_fresh = true;
@@ -1577,9 +1666,8 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 Blueprint* bp = result.as.blueprint_val;
                 if (strcmp(attr_name, "name") == 0) { // Special case for blueprint.name
                     next_derived_value.type = VAL_STRING;
-                    next_derived_value.as.string_val = strdup(bp->name);
+                    next_derived_value.as.string_val = string_value_create(bp->name);
                     if (!next_derived_value.as.string_val) {
-                        free(attr_name);
                         report_error("System", "Failed to strdup blueprint name for .name access", dot_token); // dot_token will be freed by caller or error handler
                         free_token(dot_token);
                     }
@@ -1597,7 +1685,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     if (!class_attr_ptr) {
                         char err_msg[150];
                         snprintf(err_msg, sizeof(err_msg), "Blueprint '%s' (and its parents) has no class attribute or static method '%s'.", bp->name, attr_name);
-                        free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                        if(result_is_freshly_created) free_value_contents(result);
                         report_error("Runtime", err_msg, dot_token);
                         free_token(dot_token);
                     }
@@ -1605,6 +1693,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     // Mark as fresh if it's a container type that value_deep_copy creates anew
                     if (next_derived_value.type == VAL_STRING || next_derived_value.type == VAL_ARRAY ||
                         next_derived_value.type == VAL_DICT || next_derived_value.type == VAL_TUPLE ||
+                        next_derived_value.type == VAL_PACKED_ARRAY || next_derived_value.type == VAL_RANGE ||
                         next_derived_value.type == VAL_OBJECT || next_derived_value.type == VAL_FUNCTION ||
                         next_derived_value.type == VAL_COROUTINE || next_derived_value.type == VAL_GATHER_TASK) {
                         next_derived_is_fresh = true;
@@ -1616,13 +1705,19 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 if (strcmp(attr_name, "append") == 0) {
                     BoundMethod* bm = malloc(sizeof(BoundMethod));
                     if (!bm) {
-                        free(attr_name); free_token(dot_token);
+                        free_token(dot_token);
                         if(result_is_freshly_created) free_value_contents(result);
                         report_error("System", "Failed to allocate memory for array.append bound method.", dot_token);
                     }
                     bm->ref_count = 1; // Initialize ref count
                     bm->type = FUNC_TYPE_C_BUILTIN;
                     bm->func_ptr.c_builtin = builtin_append;
+                    // append mutates in place: un-share the array (and whatever holds it) first.
+                    if (result_is_freshly_created) {
+                        value_make_unique(&result);
+                    } else if (base_cow_depth > 0) {
+                        result = *value_make_slots_unique(cow_slots, base_cow_depth);
+                    }
                     bm->self_value = result; // The array itself. If result was fresh, bm takes ownership.
                     bm->self_is_owned_copy = result_is_freshly_created;
 
@@ -1632,28 +1727,53 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                 } else {
                     char err_msg[150];
                     snprintf(err_msg, sizeof(err_msg), "Array has no attribute or method '%s'.", attr_name);
-                    free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                    if(result_is_freshly_created) free_value_contents(result);
+                    report_error("Runtime", err_msg, dot_token);
+                    free_token(dot_token);
+                }
+            } else if (result.type == VAL_STRING) {
+                CBuiltinFunction method = string_method_lookup(attr_name);
+                if (!method) {
+                    char err_msg[150];
+                    snprintf(err_msg, sizeof(err_msg), "String has no attribute or method '%s'.", attr_name);
+                    if(result_is_freshly_created) free_value_contents(result);
                     report_error("Runtime", err_msg, dot_token);
                     free_token(dot_token);
                 }
+                BoundMethod* bm = malloc(sizeof(BoundMethod));
+                if (!bm) {
+                    free_token(dot_token);
+                    if(result_is_freshly_created) free_value_contents(result);
+                    report_error("System", "Failed to allocate memory for string method.", dot_token);
+                }
+                bm->ref_count = 1;
+                bm->type = FUNC_TYPE_C_BUILTIN;
+                bm->func_ptr.c_builtin = method;
+                bm->self_value = value_deep_copy(result); // Strings are immutable: take a reference
+                bm->self_is_owned_copy = 1;
+
+                next_derived_value.type = VAL_BOUND_METHOD;
+                next_derived_value.as.bound_method_val = bm;
+                next_derived_is_fresh = true;
             } else if (result.type == VAL_DICT) { // Handle dict.key access
                 Dictionary* dict = result.as.dict_val;
-                Value val_from_dict;
                 // Get a view (shallow copy) to be consistent with dict["key"] access.
-                if (dictionary_try_get(dict, attr_name, &val_from_dict, false)) {
-                    next_derived_value = val_from_dict; // val_from_dict is a view.
-                    next_derived_is_fresh = false;      // A view is not a fresh container.
+                Value* val_from_dict_ptr = dictionary_try_get_value_ptr(dict, attr_name);
+                if (val_from_dict_ptr) {
+                    next_derived_value = *val_from_dict_ptr; // A view.
+                    next_derived_is_fresh = false;           // A view is not a fresh container.
+                    cow_depth = cow_path_extend(cow_slots, base_cow_depth, val_from_dict_ptr);
                 } else { // Key not found
                     char err_msg[150];
                     snprintf(err_msg, sizeof(err_msg), "Key '%s' not found in dictionary.", attr_name);
-                    free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                    if(result_is_freshly_created) free_value_contents(result);
                     report_error("Runtime", err_msg, dot_token);
                     free_token(dot_token); // Free if report_error didn't exit
                 }
             } else if (result.type == VAL_SUPER_PROXY) { // super.method_name
                 Object* self_obj_for_super = interpreter->current_self_object;
                 if (!self_obj_for_super || !self_obj_for_super->blueprint->parent_blueprint) {
-                    free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                    if(result_is_freshly_created) free_value_contents(result);
                     report_error("Runtime", "'super' used incorrectly or in a class with no parent.", dot_token);
                     free_token(dot_token);
                 }
@@ -1665,7 +1785,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
                     else
                         snprintf(err_msg, sizeof(err_msg), "Attribute '%s' in parent blueprint of '%s' is not a method.", attr_name, self_obj_for_super->blueprint->name);
 
-                    free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                    if(result_is_freshly_created) free_value_contents(result);
                     report_error("Runtime", err_msg, dot_token);
                     free_token(dot_token);
                 }
@@ -1683,12 +1803,11 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
             } else {
                 char err_msg[100];
                 snprintf(err_msg, sizeof(err_msg), "Cannot access attribute '%s' on non-object/blueprint/super_proxy type (got type %d).", attr_name, result.type);
-                free(attr_name); if(result_is_freshly_created) free_value_contents(result);
+                if(result_is_freshly_created) free_value_contents(result);
                 report_error("Runtime", err_msg, dot_token);
                 free_token(dot_token);
             }
             } // End of if (!attribute_handled_by_special_case)
-            free(attr_name);
             free_token(dot_token); // Free the copied dot_token after successful processing or if error didn't exit
 
             // If we created a new BoundMethod but there's an error later, ensure it gets freed
@@ -1735,7 +1854,7 @@ ExprResult interpret_postfix_expr(Interpreter* interpreter) {
 
 ExprResult interpret_power_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_postfix_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
     Value left = left_res.value;
@@ -1747,7 +1866,7 @@ ExprResult interpret_power_expr(Interpreter* interpreter) {
         interpreter_eat(interpreter, TOKEN_POWER);
         ExprResult right_res = interpret_power_expr(interpreter); // Right-associative
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (left_res.is_freshly_created_container) free_value_contents(left_res.value);
             if (right_res.is_freshly_created_container) free_value_contents(right_res.value);
             free_token(op_token_copy);
@@ -1844,7 +1963,7 @@ ExprResult interpret_unary_expr(Interpreter* interpreter) {
         return final_res;
     }
     ExprResult res = interpret_power_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return res;
     }
     return res;
@@ -1852,7 +1971,7 @@ ExprResult interpret_unary_expr(Interpreter* interpreter) {
 
 ExprResult interpret_multiplicative_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_unary_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
     Value left = left_res.value;
@@ -1870,7 +1989,7 @@ ExprResult interpret_multiplicative_expr(Interpreter* interpreter) {
         interpreter_eat(interpreter, op_type);
         ExprResult right_res = interpret_unary_expr(interpreter);
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (current_res_is_fresh) free_value_contents(left); // Free the left-side value if it was a temporary.
             if (right_res.is_freshly_created_container) free_value_contents(right_res.value);
             free_token(op_token_copy);
@@ -1901,13 +2020,12 @@ ExprResult interpret_multiplicative_expr(Interpreter* interpreter) {
                     report_error("Runtime", "Cannot repeat string a negative number of times.", op_token_copy);
                     free_token(op_token_copy); // Free before returning due to error (report_error exits)
                 }
-                size_t old_len = strlen(left.as.string_val);
-                char* new_str = malloc(old_len * times + 1);
-                if (!new_str) report_error("System", "Memory allocation failed for string repetition", op_token_copy);
-                new_str[0] = '\0';
-                for (long i = 0; i < times; i++) strcat(new_str, left.as.string_val);
+                if (times > 0 && string_value_length(left.as.string_val) > SIZE_MAX / (size_t)times) {
+                    if(current_res_is_fresh) free_value_contents(left);
+                    report_error("Runtime", "Repeated string is too long.", op_token_copy);
+                }
                 result_val.type = VAL_STRING;
-                result_val.as.string_val = new_str;
+                result_val.as.string_val = string_value_repeat(left.as.string_val, (size_t)times);
                 new_op_res_is_fresh = true; // New string
             } else if (left.type == VAL_INT && right.type == VAL_STRING) {
                 long times = left.as.integer;
@@ -1917,13 +2035,12 @@ ExprResult interpret_multiplicative_expr(Interpreter* interpreter) {
                     report_error("Runtime", "Cannot repeat string a negative number of times.", op_token_copy);
                     free_token(op_token_copy); // Free before returning due to error (report_error exits)
                 }
-                size_t str_len = strlen(right.as.string_val);
-                char* new_str = malloc(str_len * times + 1);
-                if (!new_str) report_error("System", "Memory allocation failed for string repetition", op_token_copy);
-                new_str[0] = '\0';
-                for (long i = 0; i < times; i++) strcat(new_str, right.as.string_val);
+                if (times > 0 && string_value_length(right.as.string_val) > SIZE_MAX / (size_t)times) {
+                    if(right_is_fresh) free_value_contents(right);
+                    report_error("Runtime", "Repeated string is too long.", op_token_copy);
+                }
                 result_val.type = VAL_STRING;
-                result_val.as.string_val = new_str;
+                result_val.as.string_val = string_value_repeat(right.as.string_val, (size_t)times);
                 new_op_res_is_fresh = true; // New string
             } else {
                 if(current_res_is_fresh) free_value_contents(left);
@@ -1999,7 +2116,7 @@ ExprResult interpret_multiplicative_expr(Interpreter* interpreter) {
 
 ExprResult interpret_additive_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_multiplicative_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
 
@@ -2019,7 +2136,7 @@ ExprResult interpret_additive_expr(Interpreter* interpreter) {
         interpreter_eat(interpreter, op_type);
         ExprResult right_res = interpret_multiplicative_expr(interpreter);
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (current_res_is_fresh) free_value_contents(left); // Free the left-side value if it was a temporary.
             if (right_res.is_freshly_created_container) free_value_contents(right_res.value);
             free_token(op_token_copy);
@@ -2047,23 +2164,28 @@ ExprResult interpret_additive_expr(Interpreter* interpreter) {
                 new_op_res_is_fresh = false; // Numeric result
             } else if (left.type == VAL_STRING || right.type == VAL_STRING) {
                 char s1_buf[256], s2_buf[256];
-                const char *s1_ptr, *s2_ptr;
-
-                if (left.type == VAL_STRING) s1_ptr = left.as.string_val;
-                else if (left.type == VAL_INT) { snprintf(s1_buf, sizeof(s1_buf), "%ld", left.as.integer); s1_ptr = s1_buf; }
-                else { snprintf(s1_buf, sizeof(s1_buf), "%g", left.as.floating); s1_ptr = s1_buf; }
-
-                if (right.type == VAL_STRING) s2_ptr = right.as.string_val;
-                else if (right.type == VAL_INT) { snprintf(s2_buf, sizeof(s2_buf), "%ld", right.as.integer); s2_ptr = s2_buf; }
-                else { snprintf(s2_buf, sizeof(s2_buf), "%g", right.as.floating); s2_ptr = s2_buf; }
-
-                DynamicString ds_concat;
-                ds_init(&ds_concat, strlen(s1_ptr) + strlen(s2_ptr) + 1); // Initial capacity
-                ds_append_str(&ds_concat, s1_ptr);
-                ds_append_str(&ds_concat, s2_ptr);
+                size_t s1_len, s2_len;
+                const char* s1_ptr = value_concat_text(left, s1_buf, sizeof(s1_buf), &s1_len);
+                const char* s2_ptr = value_concat_text(right, s2_buf, sizeof(s2_buf), &s2_len);
+                if (!s1_ptr || !s2_ptr) {
+                    if(current_res_is_fresh) free_value_contents(left);
+                    if(right_is_fresh) free_value_contents(right);
+                    report_error("Runtime", "Unsupported operand types for '+' operator.", op_token_copy);
+                }
 
-                result_val.type = VAL_STRING;
-                result_val.as.string_val = ds_finalize(&ds_concat);
+                if (left.type == VAL_STRING && current_res_is_fresh) {
+                    // The left side is this chain's own temporary (the 'a + b' of 'a + b + c'):
+                    // grow it in place instead of copying it into yet another string.
+                    result_val = left;
+                    string_value_append(&result_val, s2_ptr, s2_len, false);
+                    current_res_is_fresh = false; // Ownership moved to result_val
+                } else {
+                    char* joined = string_value_alloc(s1_len + s2_len);
+                    memcpy(joined, s1_ptr, s1_len);
+                    memcpy(joined + s1_len, s2_ptr, s2_len);
+                    result_val.type = VAL_STRING;
+                    result_val.as.string_val = joined;
+                }
                 new_op_res_is_fresh = true; // New string
             } else {
                 if (left.type == VAL_OBJECT) { // op_add attempt
@@ -2222,6 +2344,7 @@ Value execute_echoc_function(Interpreter* interpreter, Function* func_to_call, O
 
     interpreter->current_scope = func_to_call->definition_scope;
     enter_scope(interpreter); // This new scope is now interpreter->current_scope
+    scope_attach_frame(interpreter->current_scope, func_to_call);
 
     if (self_obj) {
         interpreter->current_self_object = self_obj;
@@ -2229,8 +2352,7 @@ Value execute_echoc_function(Interpreter* interpreter, Function* func_to_call, O
         SymbolNode* self_node = (SymbolNode*)malloc(sizeof(SymbolNode));
         if (!self_node) report_error("System", "Failed to allocate memory for 'self' symbol node in method scope", call_site_token);
         
-        self_node->name = strdup("self");
-        if (!self_node->name) { free(self_node); report_error("System", "Failed to strdup 'self' name for method scope", call_site_token); }
+        self_node->name = intern_acquire("self");
         
         self_node->value.type = VAL_OBJECT;
         self_node->value.as.object_val = self_obj; // Direct pointer assignment
@@ -2339,10 +2461,8 @@ Value execute_echoc_function(Interpreter* interpreter, Function* func_to_call, O
 
 
     // Prepare and set lexer state for function body execution
-    LexerState effective_body_start_state = func_to_call->body_start_state;
-    effective_body_start_state.text = func_to_call->source_text_owned_copy;
-    effective_body_start_state.text_length = func_to_call->source_text_length;
-    set_lexer_state(interpreter->lexer, effective_body_start_state);
+    // body_start_state points into the function's shared source unit.
+    set_lexer_state(interpreter->lexer, func_to_call->body_start_state);
 
     free_token(interpreter->current_token);
     interpreter->current_token = get_next_token(interpreter->lexer);
@@ -2392,7 +2512,7 @@ ExprResult interpret_comparison_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_additive_expr(interpreter);
     if (interpreter->exception_is_active) return left_res; // Propagate error result up
 
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
 
@@ -2406,7 +2526,7 @@ ExprResult interpret_comparison_expr(Interpreter* interpreter) {
         interpreter_eat(interpreter, op_type);
         ExprResult right_res = interpret_additive_expr(interpreter);
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (left_res.is_freshly_created_container) free_value_contents(left_res.value); // Free the left-side value if it was a temporary.
             if (right_res.is_freshly_created_container) free_value_contents(right_res.value);
             free_token(op_token_copy);
@@ -2455,7 +2575,7 @@ ExprResult interpret_comparison_expr(Interpreter* interpreter) {
 
 ExprResult interpret_identity_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_comparison_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
 
@@ -2471,7 +2591,7 @@ ExprResult interpret_identity_expr(Interpreter* interpreter) {
 
         ExprResult right_res = interpret_comparison_expr(interpreter);
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (left_res.is_freshly_created_container) free_value_contents(left_res.value);
             if (right_res.is_freshly_created_container) free_value_contents(right_res.value);
             free_token(op_token_copy);
@@ -2500,7 +2620,7 @@ ExprResult interpret_identity_expr(Interpreter* interpreter) {
 
 ExprResult interpret_equality_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_identity_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
 
@@ -2515,7 +2635,7 @@ ExprResult interpret_equality_expr(Interpreter* interpreter) {
         interpreter_eat(interpreter, op_type);
         ExprResult right_res = interpret_identity_expr(interpreter); // This will be the token for error reporting if types mismatch badly
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (left_res.is_freshly_created_container) free_value_contents(left_res.value); // Free the left-side value if it was a temporary.
             if (right_res.is_freshly_created_container) {
                 free_value_contents(right_res.value);
@@ -2555,7 +2675,7 @@ ExprResult interpret_equality_expr(Interpreter* interpreter) {
 }
 ExprResult interpret_logical_and_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_equality_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
 
@@ -2581,7 +2701,7 @@ ExprResult interpret_logical_and_expr(Interpreter* interpreter) {
             // We must evaluate the RHS normally.
             if (left_res.is_freshly_created_container) free_value_contents(left_res.value); // Free the old truthy LHS value
             ExprResult right_res = interpret_equality_expr(interpreter);
-            if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+            if (interpreter->exception_is_active) {
                 // RHS yielded/errored. The LHS was already freed. Just propagate the dummy result.
                 free_token(op_token_copy);
                 return right_res;
@@ -2597,7 +2717,7 @@ ExprResult interpret_logical_and_expr(Interpreter* interpreter) {
 
 ExprResult interpret_logical_or_expr(Interpreter* interpreter) {
     ExprResult left_res = interpret_logical_and_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return left_res;
     }
 
@@ -2623,7 +2743,7 @@ ExprResult interpret_logical_or_expr(Interpreter* interpreter) {
             // We must evaluate the RHS normally.
             if (left_res.is_freshly_created_container) free_value_contents(left_res.value); // Free the old falsy LHS value
             ExprResult right_res = interpret_logical_and_expr(interpreter);
-            if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+            if (interpreter->exception_is_active) {
                 // RHS yielded/errored. The LHS was already freed. Just propagate the dummy result.
                 free_token(op_token_copy);
                 return right_res;
@@ -2642,8 +2762,13 @@ ExprResult interpret_conditional_expr(Interpreter* interpreter) {
     // New syntax: <true_expr> if <condition> else <false_expr>
     // This has the lowest precedence.
 
+    if (interpreter->vm_enabled) {
+        ExprResult vm_res;
+        if (bytecode_try_eval_expression(interpreter, &vm_res)) return vm_res;
+    }
+
     ExprResult true_expr_res = interpret_await_expr(interpreter);
-    if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+    if (interpreter->exception_is_active) {
         return true_expr_res;
     }
 
@@ -2687,74 +2812,19 @@ ExprResult interpret_conditional_expr(Interpreter* interpreter) {
 }
 
 ExprResult interpret_await_expr(Interpreter* interpreter) {
-    Coroutine* self_coro = interpreter->current_executing_coroutine;
-
-    // If we are in fast-forward mode, we must check if this is the await we are looking for.
-    // If not, we skip this entire await expression to avoid executing it.
-    if (interpreter->prevent_side_effects) {
-        if (!self_coro || !self_coro->has_yielding_await_state ||
-            !(self_coro->yielding_await_token->line == interpreter->current_token->line &&
-              self_coro->yielding_await_token->col == interpreter->current_token->col))
-        {
-            // This is NOT the await we are resuming.
-            // If the current token is an await, we must dry-run it.
-            // Otherwise, we let the normal parsing functions handle it (they will respect prevent_side_effects).
-            if (interpreter->current_token->type == TOKEN_AWAIT) {
-                interpreter_eat(interpreter, TOKEN_AWAIT);
-                ExprResult dummy_res = interpret_logical_or_expr(interpreter); // This will also be in dry-run mode
-                if (dummy_res.is_freshly_created_container) free_value_contents(dummy_res.value);
-                return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
-            }
-        }
-        // If it IS the await we are resuming, we fall through to the main logic below.
-    }
-
     if (interpreter->current_token->type != TOKEN_AWAIT) {
-        ExprResult res = interpret_logical_or_expr(interpreter);
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
-            return res;
-        }
-        return res;
+        return interpret_logical_or_expr(interpreter);
     }
 
-    // --- AWAIT RESUME LOGIC ---
-    if (self_coro && self_coro->has_yielding_await_state) { // Check if we are in a resume context
-        if (self_coro->yielding_await_token &&
-            self_coro->yielding_await_token->line == interpreter->current_token->line &&
-            self_coro->yielding_await_token->col == interpreter->current_token->col)
-        {
-            DEBUG_PRINTF("AWAIT_RESUME_MATCH: Resuming at the correct await. Fast-forward mode DISABLED.%s", "");
-            interpreter->prevent_side_effects = false; // Turn off fast-forward mode.
-            self_coro->has_yielding_await_state = false; // We have successfully resumed and consumed the state.
-            free_token(self_coro->yielding_await_token);
-            self_coro->yielding_await_token = NULL;
-
-            ExprResult final_result;
-            if (self_coro->resumed_with_exception) {
-                interpreter->exception_is_active = 1;
-                free_value_contents(interpreter->current_exception);
-                interpreter->current_exception = value_deep_copy(self_coro->value_from_await);
-                final_result.value = create_null_value(); // Return dummy value on exception
-            } else {
-                final_result.value = value_deep_copy(self_coro->value_from_await);
-            }
-
-            final_result.is_freshly_created_container = true;
-            final_result.is_standalone_primary_id = false;
-
-            interpreter_eat(interpreter, TOKEN_AWAIT);
-            interpreter->prevent_side_effects = true;
-            ExprResult dummy_res = interpret_logical_or_expr(interpreter);
-            interpreter->prevent_side_effects = false;
-
-            if (dummy_res.is_freshly_created_container) {
-                free_value_contents(dummy_res.value);
-            }
-
-            return final_result; // Return the actual result from the completed await.
-        }
+    // In a skipped branch (short-circuit, untaken ternary/elif) only parse past the awaitable.
+    if (interpreter->prevent_side_effects) {
+        interpreter_eat(interpreter, TOKEN_AWAIT);
+        ExprResult dummy_res = interpret_logical_or_expr(interpreter); // This will also be in dry-run mode
+        if (dummy_res.is_freshly_created_container) free_value_contents(dummy_res.value);
+        return (ExprResult){ .value = create_null_value(), .is_freshly_created_container = false };
     }
 
+    Coroutine* self_coro = interpreter->current_executing_coroutine;
     Token* await_keyword_token = token_deep_copy(interpreter->current_token);
 
     if (!self_coro) {
@@ -2763,7 +2833,6 @@ ExprResult interpret_await_expr(Interpreter* interpreter) {
 
     Coroutine* target_coro = NULL;
 
-    // --- Simplified FIRST TIME PATH logic ---
     interpreter_eat(interpreter, TOKEN_AWAIT);
     ExprResult awaitable_expr_res = interpret_logical_or_expr(interpreter);
 
@@ -2805,7 +2874,6 @@ ExprResult interpret_await_expr(Interpreter* interpreter) {
         final_result.is_standalone_primary_id = false;
 
         free_token(await_keyword_token);
-        self_coro->has_yielding_await_state = false; // We have successfully resumed and gotten the result.
         return final_result;
     }
 
@@ -2838,17 +2906,6 @@ ExprResult interpret_await_expr(Interpreter* interpreter) {
     self_coro->state = CORO_SUSPENDED_AWAIT;
     self_coro->awaiting_on_coro = target_coro;
     coroutine_incref(target_coro);
-    // --- START: Set precise resume state ---
-    // Before overwriting the yielding_await_token, free the old one if it exists. This prevents a leak
-    // if a new await is encountered during a resume cycle before the original await point is reached.
-    if (self_coro->yielding_await_token) {
-        free_token(self_coro->yielding_await_token);
-    }
-    self_coro->has_yielding_await_state = true;
-    self_coro->yielding_await_state = get_lexer_state_for_token_start(interpreter->lexer, await_keyword_token->line, await_keyword_token->col, await_keyword_token);
-    // Store the yielding token itself for the resume check. Transfer ownership of await_keyword_token.
-    self_coro->yielding_await_token = await_keyword_token;
-    // --- END: Set precise resume state ---
 
     // The references to the target_coro have now been transferred to the async machinery
     // (the ready queue and the awaiting_on_coro pointer). We can now release the temporary
@@ -2858,6 +2915,21 @@ ExprResult interpret_await_expr(Interpreter* interpreter) {
     }
 
     coroutine_add_waiter(target_coro, self_coro);
-    ExprResult pending_res = { .value = create_null_value() };
-    return pending_res;
+    free_token(await_keyword_token);
+
+    // Suspend right here. Whoever completes target_coro stores its outcome in
+    // value_from_await and requeues us; execution then continues below.
+    coroutine_suspend(interpreter, self_coro);
+
+    ExprResult final_result = { .is_freshly_created_container = true, .is_standalone_primary_id = false };
+    if (self_coro->resumed_with_exception) {
+        self_coro->resumed_with_exception = 0;
+        interpreter->exception_is_active = 1;
+        free_value_contents(interpreter->current_exception);
+        interpreter->current_exception = value_deep_copy(self_coro->value_from_await);
+        final_result.value = create_null_value(); // Return dummy value on exception
+    } else {
+        final_result.value = value_deep_copy(self_coro->value_from_await);
+    }
+    return final_result;
 }
@@ -15,6 +15,9 @@ typedef struct {
     // True if the expression was solely a primary identifier lookup without any
     // subsequent operations (call, index, attribute access, arithmetic, etc.).
     bool is_standalone_primary_id;
+    // For a standalone identifier that yielded a view: the variable's storage, so a
+    // mutating method can un-share the container in place (copy-on-write).
+    Value* source_slot;
 } ExprResult;
 
 // Entry point for parsing any expression (lowest precedence is ternary).
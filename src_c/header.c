@@ -129,6 +129,9 @@ void debug_aware_printf(const char* format, ...) {
 }
 #endif // DEBUG_ECHOC
 
+jmp_buf* g_error_recovery_point = NULL;
+char g_error_recovery_message[512];
+
 void report_error(const char* type, const char* message, Token* token) {
     const char* file_path = "unknown file";
     if (g_interpreter_for_error_reporting && g_interpreter_for_error_reporting->current_executing_file_path) {
@@ -157,6 +160,14 @@ void report_error(const char* type, const char* message, Token* token) {
 
     }
 #endif
+    if (g_error_recovery_point) {
+        if (token) {
+            snprintf(g_error_recovery_message, sizeof(g_error_recovery_message), "[EchoC %s Error] in %s at line %d, col %d: %s", type, file_path, token->line, token->col, message);
+        } else {
+            snprintf(g_error_recovery_message, sizeof(g_error_recovery_message), "[EchoC %s Error] in %s (unknown location): %s", type, file_path, message);
+        }
+        longjmp(*g_error_recovery_point, 1);
+    }
     if (token) {
         fprintf(stderr, "[EchoC %s Error] in %s at line %d, col %d: %s\n", type, file_path, token->line, token->col, message);
     } else {
@@ -170,6 +181,12 @@ void report_error(const char* type, const char* message, Token* token) {
     exit(1);
 }
 
+void report_recovered_error(void) {
+    if (g_error_recovery_point) longjmp(*g_error_recovery_point, 1);
+    fprintf(stderr, "%s\n", g_error_recovery_message);
+    exit(1);
+}
+
 Value create_null_value() {
     Value val = {0}; // Use an aggregate initializer to zero out the entire struct.
     val.type = VAL_NULL;
@@ -179,6 +196,8 @@ Value create_null_value() {
 
 Token* token_deep_copy(Token* original) {
     if (!original) return NULL;
+    // Tokens from a SourceUnit's cache are immutable and outlive every holder, so share them.
+    if (original->is_borrowed) return original;
     Token* copy = malloc(sizeof(Token));
     if (!copy) {
         fprintf(stderr, "[EchoC System Error] Critical: Failed to allocate memory for token copy in token_deep_copy.\n");
@@ -186,51 +205,16 @@ Token* token_deep_copy(Token* original) {
     }
     *copy = *original; // Shallow copy members like type, line, col
 
-    // Deep copy the 'value' string if it's a type that owns its string
-    // Keywords and identifiers get their values from strdup in the lexer.
-    // Literals (numbers, strings) also get strdup'd values from the lexer.
-    // Multi-character operators (==, !=, <=, >=) also get strdup'd values.
-    // Single-character operators (+, -, *, /, (, ), :, etc.) use string literals.
-    switch (original->type) {
-        // Types whose 'value' is dynamically allocated by the lexer and needs deep copy
-        case TOKEN_ID:
-        case TOKEN_INTEGER:
-        case TOKEN_FLOAT:
-        case TOKEN_STRING:
-        // Keywords are initially lexed as TOKEN_ID then converted; their value is from strdup in the lexer.
-        // All keywords that have a ->value need to be deep copied.
-        case TOKEN_LET: case TOKEN_ASSIGN_KEYWORD: case TOKEN_TRUE:
-        case TOKEN_FALSE: case TOKEN_AND: case TOKEN_OR: case TOKEN_NOT: case TOKEN_IF: case TOKEN_ELIF: case TOKEN_ELSE:
-        case TOKEN_LOOP: case TOKEN_WHILE: case TOKEN_FOR: case TOKEN_FROM: case TOKEN_TO: case TOKEN_STEP: case TOKEN_IN: case TOKEN_SKIP:
-        case TOKEN_BREAK: case TOKEN_CONTINUE: case TOKEN_FUNCT: case TOKEN_RETURN:
-        case TOKEN_NULL: case TOKEN_BLUEPRINT: case TOKEN_INHERITS: case TOKEN_SUPER:
-        case TOKEN_TRY: case TOKEN_CATCH: case TOKEN_AS: case TOKEN_FINALLY: case TOKEN_RAISE: case TOKEN_IS:
-        // Multi-character operators that get strdup'd values
-        case TOKEN_EQ:  // "=="
-        case TOKEN_AWAIT: // Added AWAIT here
-        case TOKEN_NEQ: // "!="
-        case TOKEN_LTE: // "<=" // These are strdup'd by lexer
-        case TOKEN_GTE: // ">=" // These are strdup'd by lexer
-        // Add any other token types whose 'value' is malloc'd by the lexer
-        // and thus needs to be strdup'd here and freed by free_token.
-            if (original->value) {
-                copy->value = strdup(original->value);
-                if (!copy->value) {
-                    free(copy);
-                    fprintf(stderr, "[EchoC System Error] Critical: Failed to strdup token value in token_deep_copy for type %d.\n", original->type);
-                    exit(1);
-                }
-            } else {
-                // This case should ideally not happen for these token types if lexer is correct
-                copy->value = NULL;
-            }
-            break;
-        default:
-            // For single-char operators (TOKEN_PLUS, TOKEN_LPAREN, etc.) and other types
-            // that use string literals (e.g., "+", "(", ":") or have NULL value (TOKEN_EOF), just copy the pointer.
-            // No deep copy needed as these are static string literals or NULL.
-            copy->value = original->value; // Pointer copy is fine
-            break;
+    // Deep copy the 'value' string if it's a type that owns its string (identifiers, keywords,
+    // literals and multi-character operators). Single-character operators (+, -, *, /, (, ), :, etc.)
+    // use string literals, and TOKEN_EOF has an empty literal, so their pointer is copied as-is.
+    if (token_type_owns_value(original->type) && original->value) {
+        copy->value = strdup(original->value);
+        if (!copy->value) {
+            free(copy);
+            fprintf(stderr, "[EchoC System Error] Critical: Failed to strdup token value in token_deep_copy for type %d.\n", original->type);
+            exit(1);
+        }
     }
     return copy;
 }
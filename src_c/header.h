@@ -11,6 +11,7 @@
 #include <math.h>
 #include <stdbool.h> // For bool type
 #include <stdint.h>  // For SIZE_MAX
+#include <setjmp.h>  // For jmp_buf (embedding error recovery)
 #ifndef _WIN32
 #include <unistd.h> // For realpath and other POSIX functions
 #endif
@@ -65,12 +66,15 @@ typedef struct {
     char* value;
     int line;
     int col;
+    bool is_borrowed; // Lives in a SourceUnit's token cache: shared, immutable, never freed by free_token
 } Token;
 
 // Value Types Enum
 typedef enum {
     VAL_INT, VAL_FLOAT, VAL_STRING, VAL_BOOL,
     VAL_ARRAY, VAL_TUPLE, VAL_DICT, VAL_FUNCTION,
+    VAL_PACKED_ARRAY, // Contiguous int64 or double elements (see packed_array.h)
+    VAL_RANGE,     // Lazy integer sequence from range(...)
     VAL_BLUEPRINT, // Represents a class/blueprint definition
     VAL_OBJECT,    // Represents an instance of a blueprint
     VAL_BOUND_METHOD, // Represents a method bound to an object instance
@@ -84,6 +88,8 @@ typedef enum {
 
 // Forward declare structs used in Value union
 struct Array;
+struct PackedArray;
+struct Range;
 struct Tuple;
 struct Dictionary;
 struct Function;
@@ -95,6 +101,7 @@ struct BoundMethod;
 struct BlueprintListNode; // Forward declare for Interpreter struct
 struct InterpreterImpl; // Forward declare the actual struct tag
 typedef struct InterpreterImpl Interpreter; // Typedef Interpreter for use
+typedef struct SourceUnit SourceUnit; // Parse-once token cache of a module (see source_unit.h)
 
 // Value Struct
 typedef struct {
@@ -105,6 +112,8 @@ typedef struct {
         char* string_val;
         int bool_val;
         struct Array* array_val;
+        struct PackedArray* packed_array_val;
+        struct Range* range_val;
         struct Tuple* tuple_val;
         struct Dictionary* dict_val;
         struct Function* function_val;
@@ -128,29 +137,69 @@ typedef struct Array {
     Value* elements;
     int count;
     int capacity;
+    int ref_count; // Shared by assignment; mutators un-share first (value_make_unique)
 } Array;
 
+// Packed Numeric Array Structure (created by the 'numeric' module)
+typedef enum { PACKED_INT, PACKED_FLOAT } PackedKind;
+
+typedef struct PackedArray {
+    PackedKind kind;
+    union {
+        int64_t* ints;   // PACKED_INT
+        double* floats;  // PACKED_FLOAT
+    } data;
+    int count;
+    int ref_count; // Shared by assignment; stores un-share first (value_make_unique)
+} PackedArray;
+
+// Range Structure: the integers start, start + step, ... stopping before 'stop'.
+// Immutable, so copies just share it. Elements are computed on demand, never stored.
+typedef struct Range {
+    long start;
+    long stop;
+    long step; // Never 0
+    int ref_count;
+} Range;
+
 // Tuple Structure
 typedef struct Tuple {
     Value* elements;
     int count;
+    int ref_count; // Shared by assignment
 } Tuple;
 
 // Dictionary Entry Structure
 typedef struct DictEntry {
-    char* key;
+    const char* key; // Interned (see intern.h)
     Value value;
-    struct DictEntry* next;
+    uint32_t hash; // Cached hash_string(key)
 } DictEntry;
 
-// Dictionary Structure
+// Dictionary Structure: a compact, insertion-ordered hash table. 'entries' is a
+// dense array in insertion order; 'index' is an open-addressing (linear probing)
+// table of positions into 'entries', -1 for an empty slot.
 typedef struct Dictionary {
-    DictEntry** buckets;
+    DictEntry* entries;
+    int* index;
     uint64_t id; // New: Unique ID for debugging
-    int num_buckets;
+    int index_capacity; // Power of two
+    int entry_capacity; // 3/4 of index_capacity (maximum load factor)
     int count;
+    int ref_count; // Shared by assignment; mutators un-share first (value_make_unique)
 } Dictionary;
 
+typedef struct {
+    const char* text;
+    int pos;
+    char current_char;
+    int line;
+    int col;
+    size_t text_length;
+    SourceUnit* unit;      // When set, tokens are read from the unit's cache
+    int token_index;       // Cursor into unit->tokens, or -1 to locate by pos
+} Lexer;
+
 // Lexer State
 typedef struct {
     int pos;
@@ -159,11 +208,13 @@ typedef struct {
     int col;
     const char* text;      // Add text pointer to LexerState
     size_t text_length;    // Add text length to LexerState
+    SourceUnit* unit;      // Token cache for 'text', or NULL for ad-hoc text
+    int token_index;       // Index of the next cached token, or -1 if only pos is known
 } LexerState;
 
 // Parameter Structure
 typedef struct Parameter {
-    char* name;
+    const char* name; // Interned
     Value* default_value;
 } Parameter;
 
@@ -172,7 +223,7 @@ typedef Value (*CBuiltinFunction)(Interpreter* interpreter, Value* args, int arg
 
 // Function Structure
 typedef struct Function {
-    char* name;
+    const char* name; // Interned
     Parameter* params;
     int param_count;
     LexerState body_start_state;
@@ -181,16 +232,16 @@ typedef struct Function {
     struct Scope* definition_scope;
     bool is_async; // Flag to mark async functions
     CBuiltinFunction c_impl; // If not NULL, this is a C function
-    char*  source_text_owned_copy; // Malloc'd copy of the source text of the module of definition
-    size_t source_text_length;     // Length of the owned copy
-    bool is_source_owner;          // True if this Function struct instance owns source_text_owned_copy
+    SourceUnit* source_unit; // Shared, refcounted source of the module of definition (NULL for C functions)
     int body_end_token_original_line; // Line number of the 'end:' token for this function
     int body_end_token_original_col;  // Column number of the 'end:' token for this function
+    int frame_size;          // Slots resolved for params and body identifiers (0: calls use name lookup only)
+    const void* frame_owner; // Identifies the slot layout (the body's first cached token)
 } Function;
 
 // SymbolNode Structure
 typedef struct SymbolNode {
-    char* name;
+    const char* name; // Interned, so lookups compare pointers
     Value value;
     struct SymbolNode* next;
 } SymbolNode;
@@ -200,6 +251,10 @@ typedef struct Scope {
     SymbolNode* symbols;
     uint64_t id; // New: Unique ID for debugging
     struct Scope* outer;
+    // Function call frame (see scope_attach_frame): slot -> Value in 'symbols', filled on first use.
+    Value** slots;
+    int slot_count;
+    const void* frame_owner;
 } Scope;
 
 // Node for a list of Scopes (used for managing module scopes)
@@ -210,19 +265,34 @@ typedef struct ScopeListNode {
 
 
 // Blueprint (Class) Structure
+// Hidden class: the ordered field names of an instance layout. Instances of a blueprint
+// that gain the same fields in the same order share one Shape (see object_shape.c).
+typedef struct Shape {
+    uint64_t id;               // Never reused, so an inline cache cannot confuse a new shape with a freed one
+    struct Shape* parent;      // Layout without the last field; NULL for a blueprint's root shape
+    const char* field_name;    // Field this shape adds to its parent (interned); NULL for a root
+    const char** field_names;  // Name of every slot, shared with the shapes that added them
+    int field_count;
+    struct Shape* first_child; // Transitions to layouts with one more field
+    struct Shape* next_sibling;
+} Shape;
+
 typedef struct Blueprint {
     char* name;
     struct Blueprint* parent_blueprint; // For inheritance
     Scope* class_attributes_and_methods; // Stores class 'let' vars and 'funct' (methods)
     int definition_col; // Column of the 'blueprint:' keyword
     Function* init_method_cache; // Cached pointer to the 'init' method for faster instantiation
+    Shape* root_shape; // Layout of a fresh instance; owns the blueprint's whole shape tree
 } Blueprint;
 
 // Object (Instance) Structure
 typedef struct Object {
     Blueprint* blueprint; // Points to the class definition
     uint64_t id; // New: Unique ID for debugging
-    Scope* instance_attributes; // Stores 'self.x' values
+    Shape* shape; // Names the 'self.x' fields; fields[slot] holds their values
+    Value* fields;
+    int field_capacity;
     int ref_count; // Reference count for memory management
 } Object;
 
@@ -259,13 +329,52 @@ typedef struct CoroutineWaiterNode {
 typedef enum {
     CORO_NEW,      // Just created, not yet run
     CORO_RUNNABLE, // Ready to run or resume
-    CORO_RESUMING, // Resuming after an await, in a "fast-forward" state
+    CORO_RESUMING, // Woken with the result of its await, waiting to be resumed
     CORO_SUSPENDED_AWAIT, // Paused on an await
     CORO_SUSPENDED_TIMER, // Paused for a timer (e.g., async_sleep)
     CORO_DONE,     // Execution finished
     CORO_GATHER_WAIT // Special state for gather() coroutine waiting for children
 } CoroutineState;
 
+// Bump allocator for temporaries that die with the statement being executed
+// (see arena.h). Each coroutine has its own, since coroutines interleave statements.
+typedef struct ArenaBlock {
+    struct ArenaBlock* next; // Older block
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* head;  // Block being filled; NULL until the first allocation
+    ArenaBlock* spare; // Emptied block kept by arena_release for the next statement
+} Arena;
+
+// Interpreter registers owned by the running coroutine. They are saved into the
+// coroutine when it suspends at an 'await' and restored when it resumes, while
+// its C stack (see coro_context.h) keeps the rest of the evaluation state.
+typedef struct CoroutineRegisters {
+    Lexer* lexer;
+    LexerState lexer_state;
+    Token* current_token;
+    Scope* current_scope;
+    Object* current_self_object;
+    struct TryCatchFrame* try_catch_stack_top;
+    int loop_depth;
+    int break_flag;
+    int continue_flag;
+    int function_nesting_level;
+    int return_flag;
+    Value current_function_return_value;
+    int exception_is_active;
+    Value current_exception;
+    char* current_executing_file_path;
+    char* current_executing_file_directory;
+    bool prevent_side_effects;
+    struct Coroutine* current_executing_coroutine;
+    Arena* scratch;
+} CoroutineRegisters;
+
 // Coroutine Structure (instance of an async function)
 typedef struct Coroutine {
     uint32_t magic_number;      // Magic number to check for validity
@@ -274,8 +383,10 @@ typedef struct Coroutine {
     Function* function_def;     // Pointer to the async Function definition
     char* name;                 // Name of the coroutine (e.g., function name or "async_sleep")
     Scope* execution_scope;     // Its own local variable scope    
-    LexerState statement_resume_state; // Lexer state pointing to the start of the statement that yielded.
-    LexerState post_await_resume_state;
+    struct CoroContext* context; // Stack the body runs on; NULL before the first run and after it finishes
+    jmp_buf* error_recovery_point; // On the body's stack: where report_error lands while the body runs
+    bool aborted_by_error;      // A fatal error ended the body; the resumer passes it on
+    CoroutineRegisters saved_registers; // Interpreter registers while suspended at an 'await'
     CoroutineState state;
     Value result_value;         // Stores the final return value or await result
     struct Coroutine* awaiting_on_coro; // Coroutine this one is waiting for
@@ -301,27 +412,23 @@ typedef struct Coroutine {
     CoroutineWaiterNode* waiters_head; // List of coroutines waiting on this one    
     Value value_from_await;     // Stores the result obtained from an awaited coroutine
     int is_in_ready_queue; // Flag to indicate if the coroutine is currently in the ready queue    
-    LexerState yielding_await_state; // The state of the lexer at the 'await' that yielded.
-    bool has_yielding_await_state;   // Flag to indicate if the above state is valid.
-    Token* yielding_await_token; // The specific 'await' token that caused the yield.
     struct TryCatchFrame* try_catch_stack_top; // For coroutine-specific try-catch stack
+    Arena scratch;              // Statement temporaries of the body (interpreter->scratch while it runs)
 } Coroutine;
 
-typedef struct {
-    const char* text;
-    int pos;
-    char current_char;
-    int line;
-    int col;
-    size_t text_length;
-} Lexer;
-
 // Node for a queue/list of coroutines
 typedef struct CoroutineQueueNode {
     Coroutine* coro;
     struct CoroutineQueueNode* next;
 } CoroutineQueueNode;
 
+// Slot of the sleep queue's binary min-heap, ordered by (wakeup_time_sec, seq).
+typedef struct SleepQueueEntry {
+    double wakeup_time_sec; // Copied from the coroutine so sifting stays within the heap array
+    uint64_t seq;           // Insertion order; keeps sleepers with equal wakeups FIFO
+    Coroutine* coro;
+} SleepQueueEntry;
+
 // Interpreter Struct
 // Define the struct with the tag InterpreterImpl
 struct InterpreterImpl {
@@ -341,25 +448,30 @@ struct InterpreterImpl {
     struct TryCatchFrame* try_catch_stack_top; // Pointer to the top of a stack of try-catch frames
     ScopeListNode* active_module_scopes_head; // List of module scopes to be freed at cleanup
     Dictionary* module_cache;         // Cache for loaded modules (path -> Dictionary of exports)
+    SourceUnit* loaded_units_head;    // Units of executed modules; kept alive (borrowed tokens point into them) until cleanup
     char* current_executing_file_directory; // Directory of the currently executing file for relative loads
     int in_try_catch_finally_block_definition; // Flag (0 or 1) if currently parsing inside a T-C-F block
     struct BlueprintListNode* all_blueprints_head; // List of all defined blueprints
     // --- Async fields ---
     CoroutineQueueNode* async_ready_queue_head;
     CoroutineQueueNode* async_ready_queue_tail;
-    CoroutineQueueNode* async_sleep_queue_head; // New: Head of the sleep queue
-    CoroutineQueueNode* async_sleep_queue_tail; // New: Tail of the sleep queue
+    SleepQueueEntry* async_sleep_heap; // Min-heap of timer-suspended coroutines; storage is reused, never shrunk
+    int async_sleep_count;
+    int async_sleep_capacity;
+    uint64_t async_sleep_seq;          // Next insertion sequence number
     Coroutine* current_executing_coroutine; // The coroutine whose code is currently running
     int async_event_loop_active;
     Token* error_token; // Token associated with the current_exception
     int exception_is_active;        // Flag (0 or 1) indicating if an exception is currently being propagated
     int unhandled_error_occured;     // Flag for unhandled async errors
+    char* unhandled_async_errors;    // Messages for weave() roots that ended with an exception (see echoc_last_error)
     int repr_depth_count; // For preventing recursion in value_to_string_representation
     char* current_executing_file_path; // New field for better error reporting
     bool prevent_side_effects; // For true short-circuiting
-    int resume_depth; // For preventing side-effects during async resume re-execution
     bool gather_last_return_exceptions_flag; // HACK: To pass option to C function
-    bool is_dummy_resume_value; // Flag to signal a dummy value from a mismatched await
+    bool vm_enabled; // --vm: evaluate eligible expressions with the bytecode VM
+    Arena main_scratch; // Statement temporaries outside coroutines
+    Arena* scratch;     // Arena of the code running now: main_scratch or the coroutine's
 }; // The typedef 'Interpreter' is already declared above using the tag
 
 // --- Try-Catch-Finally Structures ---
@@ -390,8 +502,11 @@ typedef struct TryCatchFrame {
 // Function Declarations (Prototypes)
 Token* get_next_token(Lexer* lexer);
 Token* peek_next_token(Lexer* lexer); // New declaration
+Token* lexer_scan_token(Lexer* lexer, int* token_start_pos); // Character-level scan, bypasses any SourceUnit
 void interpret(Interpreter* interpreter);
 void free_token(Token* token);
+void free_token_contents(Token* token); // Frees only the value string, if the token type owns one
+bool token_type_owns_value(TokenType type); // True if the lexer heap-allocates the value for this type
 Token* token_deep_copy(Token* original);
 
 void free_value_contents(Value val);
@@ -406,6 +521,13 @@ void report_error(const char* type, const char* message, Token* token);
 Value create_null_value(); // Moved for consistency
 
 extern Interpreter* g_interpreter_for_error_reporting; // For error reporting
+// While an embedding caller (echoc_api.c) has a recovery point set, report_error
+// stores its message in g_error_recovery_message and longjmps there instead of exiting.
+extern jmp_buf* g_error_recovery_point;
+extern char g_error_recovery_message[512];
+// Raises the error already held in g_error_recovery_message again, from the current
+// recovery point or, without one, by printing it and exiting like report_error.
+void report_recovered_error(void);
 
 // Debugging Macro
 #ifdef DEBUG_ECHOC
@@ -427,10 +549,9 @@ void debug_aware_printf(const char* format, ...);
 #define debug_aware_printf printf
 #endif
 
-// Statement Execution Status (for async yielding)
+// Statement Execution Status
 typedef enum {
     STATEMENT_EXECUTED_OK,
-    STATEMENT_YIELDED_AWAIT, // Indicates the statement (via await) caused a yield
     STATEMENT_PROPAGATE_FLAG // Indicates a break/continue/return/exception flag is active
 } StatementExecStatus;
 
@@ -0,0 +1,121 @@
+// src_c/intern.c
+#include "intern.h"
+#include "dictionary.h" // For hash_string
+#include <stddef.h> // For offsetof
+#include <string.h> // For strcmp, memcpy
+#include <stdlib.h> // For malloc, calloc, free
+
+#define INTERN_MIN_CAPACITY 256
+
+// An interned string: callers hold a pointer to 'text', the header sits just before it.
+typedef struct InternedString {
+    uint32_t hash;
+    int ref_count;
+    char text[];
+} InternedString;
+
+// Open-addressing (linear probing) set of entries; NULL marks an empty slot.
+static InternedString** intern_slots = NULL;
+static int intern_capacity = 0; // Power of two
+static int intern_count = 0;
+
+static InternedString* intern_header(const char* interned) {
+    return (InternedString*)(interned - offsetof(InternedString, text));
+}
+
+static void intern_grow(void) {
+    int new_capacity = intern_capacity ? intern_capacity * 2 : INTERN_MIN_CAPACITY;
+    InternedString** new_slots = calloc(new_capacity, sizeof(InternedString*));
+    if (!new_slots) report_error("System", "Failed to grow the intern table", NULL);
+    uint32_t mask = (uint32_t)new_capacity - 1;
+    for (int i = 0; i < intern_capacity; ++i) {
+        InternedString* entry = intern_slots[i];
+        if (!entry) continue;
+        uint32_t slot = entry->hash & mask;
+        while (new_slots[slot]) slot = (slot + 1) & mask;
+        new_slots[slot] = entry;
+    }
+    free(intern_slots);
+    intern_slots = new_slots;
+    intern_capacity = new_capacity;
+}
+
+// Slot holding 'str', or the empty slot where it would go. The table must not be empty.
+static uint32_t intern_find_slot(const char* str, uint32_t hash) {
+    uint32_t mask = (uint32_t)intern_capacity - 1;
+    uint32_t slot = hash & mask;
+    while (intern_slots[slot]) {
+        if (intern_slots[slot]->hash == hash && strcmp(intern_slots[slot]->text, str) == 0) break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+const char* intern_acquire(const char* str) {
+    return intern_acquire_hashed(str, (uint32_t)hash_string(str));
+}
+
+const char* intern_acquire_hashed(const char* str, uint32_t hash) {
+    if ((intern_count + 1) * 4 > intern_capacity * 3) intern_grow(); // Load <= 0.75
+    uint32_t slot = intern_find_slot(str, hash);
+    InternedString* entry = intern_slots[slot];
+    if (entry) {
+        entry->ref_count++;
+        return entry->text;
+    }
+    size_t length = strlen(str);
+    entry = malloc(sizeof(InternedString) + length + 1);
+    if (!entry) report_error("System", "Failed to allocate memory for interned string", NULL);
+    entry->hash = hash;
+    entry->ref_count = 1;
+    memcpy(entry->text, str, length + 1);
+    intern_slots[slot] = entry;
+    intern_count++;
+    return entry->text;
+}
+
+const char* intern_retain(const char* interned) {
+    intern_header(interned)->ref_count++;
+    return interned;
+}
+
+void intern_release(const char* interned) {
+    if (!interned) return;
+    InternedString* entry = intern_header(interned);
+    if (--entry->ref_count > 0) return;
+
+    // Remove the entry, then shift later members of its probe run back so that
+    // lookups never stop early at the hole (no tombstones needed).
+    uint32_t mask = (uint32_t)intern_capacity - 1;
+    uint32_t hole = entry->hash & mask;
+    while (intern_slots[hole] != entry) hole = (hole + 1) & mask;
+    uint32_t slot = hole;
+    while (1) {
+        slot = (slot + 1) & mask;
+        InternedString* next = intern_slots[slot];
+        if (!next) break;
+        uint32_t home = next->hash & mask;
+        // 'next' may fill the hole unless its home lies cyclically in (hole, slot].
+        bool home_after_hole = hole <= slot ? (home > hole && home <= slot) : (home > hole || home <= slot);
+        if (home_after_hole) continue;
+        intern_slots[hole] = next;
+        hole = slot;
+    }
+    intern_slots[hole] = NULL;
+    intern_count--;
+    free(entry);
+}
+
+const char* intern_find(const char* str) {
+    return intern_find_hashed(str, (uint32_t)hash_string(str));
+}
+
+const char* intern_find_hashed(const char* str, uint32_t hash) {
+    if (intern_count == 0) return NULL;
+    InternedString* entry = intern_slots[intern_find_slot(str, hash)];
+    return entry ? entry->text : NULL;
+}
+
+uint32_t intern_hash(const char* interned) {
+    return intern_header(interned)->hash;
+}
@@ -0,0 +1,35 @@
+// src_c/intern.h
+#ifndef ECHOC_INTERN_H
+#define ECHOC_INTERN_H
+
+#include "header.h" // Provides uint32_t, size_t, report_error
+
+// Process-wide table of interned names: cached token values, symbol, parameter and
+// function names, dictionary keys and instance field names. Each distinct string is
+// stored once next to its hash, and equal strings intern to the same pointer, so
+// holders compare names with == instead of strcmp. Entries are reference counted:
+// every holder takes one reference and the string is freed when the last one drops.
+
+// Returns the canonical copy of 'str' and takes a reference to it.
+const char* intern_acquire(const char* str);
+
+// intern_acquire for a caller that already knows hash_string(str) (see string_value_hash).
+const char* intern_acquire_hashed(const char* str, uint32_t hash);
+
+// Takes another reference to 'interned', which must come from this table.
+const char* intern_retain(const char* interned);
+
+// Drops a reference to 'interned' (NULL is ignored).
+void intern_release(const char* interned);
+
+// Returns the canonical copy of 'str' without taking a reference, or NULL if nothing
+// holds it -- in which case no symbol, key or field can be named 'str' either.
+const char* intern_find(const char* str);
+
+// intern_find with a precomputed hash_string(str).
+const char* intern_find_hashed(const char* str, uint32_t hash);
+
+// hash_string of an interned string, computed once when it was added.
+uint32_t intern_hash(const char* interned);
+
+#endif // ECHOC_INTERN_H
@@ -6,10 +6,11 @@
 #include "expression_parser.h" // For actual expression parsing functions
 #include "scope.h"             // For VarScopeInfo, symbol_table_set, etc.
 #include "value_utils.h"       // For value_to_string_representation
+#include "string_value.h"      // For string_value_create
 #include "statement_parser.h"  // For actual statement parsing functions
 
 // Forward declarations for dictionary functions to avoid implicit declaration warnings/conflicts
-Dictionary* dictionary_create(int initial_buckets, Token* error_token);
+Dictionary* dictionary_create(int initial_capacity, Token* error_token);
 void dictionary_set(Dictionary* dict, const char* key_str, Value value, Token* error_token);
 Value dictionary_get(Dictionary* dict, const char* key, Token* error_token);
 // Forward declaration for symbol table lookup
@@ -118,40 +119,64 @@ Coroutine* get_from_ready_queue(Interpreter* interpreter) {
     return NULL; // Queue is empty or only contained stale nodes
 }
 
-// Helper to add to sleep queue (sorted by wakeup_time_sec)
+// --- Sleep queue: a binary min-heap on (wakeup_time_sec, seq) ---
+// Insert and pop-earliest are O(log n); the heap array is the node pool, so
+// scheduling a sleeper allocates nothing once the array has grown to size.
+
+static bool sleep_entry_before(const SleepQueueEntry* a, const SleepQueueEntry* b) {
+    if (a->wakeup_time_sec != b->wakeup_time_sec) return a->wakeup_time_sec < b->wakeup_time_sec;
+    return a->seq < b->seq;
+}
+
 void add_to_sleep_queue(Interpreter* interpreter, Coroutine* coro) {
-    CoroutineQueueNode* new_node = malloc(sizeof(CoroutineQueueNode));
-    if (!new_node) {
-        // Attempt to provide context if current_token is available from the interpreter
-        Token* error_token = interpreter->current_token ? interpreter->current_token : NULL;
-        report_error("System", "Failed to allocate CoroutineQueueNode for sleep queue.", error_token);
-        return; // Should not be reached if report_error exits
+    if (interpreter->async_sleep_count == interpreter->async_sleep_capacity) {
+        int new_capacity = interpreter->async_sleep_capacity == 0 ? 16 : interpreter->async_sleep_capacity * 2;
+        SleepQueueEntry* new_heap = realloc(interpreter->async_sleep_heap, new_capacity * sizeof(SleepQueueEntry));
+        if (!new_heap) {
+            // Attempt to provide context if current_token is available from the interpreter
+            Token* error_token = interpreter->current_token ? interpreter->current_token : NULL;
+            report_error("System", "Failed to grow the sleep queue.", error_token);
+            return; // Should not be reached if report_error exits
+        }
+        interpreter->async_sleep_heap = new_heap;
+        interpreter->async_sleep_capacity = new_capacity;
     }
-    new_node->coro = coro;
     // Increment ref_count as the sleep queue now holds a reference
     coro->ref_count++;
     DEBUG_PRINTF("ADD_TO_SLEEP_QUEUE: Coro %s (%p) ref_count incremented to %d.", coro->name ? coro->name : "unnamed", (void*)coro, coro->ref_count);
 
-    new_node->next = NULL;
+    SleepQueueEntry entry = { coro->wakeup_time_sec, interpreter->async_sleep_seq++, coro };
+    SleepQueueEntry* heap = interpreter->async_sleep_heap;
+    int i = interpreter->async_sleep_count++;
+    while (i > 0) { // Sift up
+        int parent = (i - 1) / 2;
+        if (!sleep_entry_before(&entry, &heap[parent])) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = entry;
+    DEBUG_PRINTF("Added coro %s (%p) to sleep queue. Wakeup: %.2f", coro->name ? coro->name : "unnamed", (void*)coro, coro->wakeup_time_sec);
+}
 
-    if (!interpreter->async_sleep_queue_head || coro->wakeup_time_sec < interpreter->async_sleep_queue_head->coro->wakeup_time_sec) {
-        new_node->next = interpreter->async_sleep_queue_head;
-        interpreter->async_sleep_queue_head = new_node;
-        if (!interpreter->async_sleep_queue_tail) { // If queue was empty
-            interpreter->async_sleep_queue_tail = new_node;
-        }
-    } else {
-        CoroutineQueueNode* current = interpreter->async_sleep_queue_head;
-        while (current->next && current->next->coro->wakeup_time_sec <= coro->wakeup_time_sec) {
-            current = current->next;
-        }
-        new_node->next = current->next;
-        current->next = new_node;
-        if (!new_node->next) { // Inserted at the end
-            interpreter->async_sleep_queue_tail = new_node;
+// Removes and returns the earliest sleeper. The queue's reference passes to the caller.
+static Coroutine* pop_earliest_sleeper(Interpreter* interpreter) {
+    SleepQueueEntry* heap = interpreter->async_sleep_heap;
+    Coroutine* earliest = heap[0].coro;
+    int count = --interpreter->async_sleep_count;
+    if (count > 0) {
+        SleepQueueEntry last = heap[count];
+        int i = 0;
+        while (1) { // Sift down
+            int child = 2 * i + 1;
+            if (child >= count) break;
+            if (child + 1 < count && sleep_entry_before(&heap[child + 1], &heap[child])) child++;
+            if (!sleep_entry_before(&heap[child], &last)) break;
+            heap[i] = heap[child];
+            i = child;
         }
+        heap[i] = last;
     }
-    DEBUG_PRINTF("Added coro %s (%p) to sleep queue. Wakeup: %.2f", coro->name ? coro->name : "unnamed", (void*)coro, coro->wakeup_time_sec);
+    return earliest;
 }
 
 // Helper to check sleep queue and move ready coroutines to ready queue
@@ -162,21 +187,15 @@ static void check_and_move_sleepers_to_ready_queue(Interpreter* interpreter) {
 #else
     double current_time = get_monotonic_time_sec();
 #endif
-    while (interpreter->async_sleep_queue_head && interpreter->async_sleep_queue_head->coro->wakeup_time_sec <= current_time) { // Peek before pop
-        CoroutineQueueNode* head_node = interpreter->async_sleep_queue_head;
-        Coroutine* sleeper_coro = head_node->coro;
+    while (interpreter->async_sleep_count > 0 && interpreter->async_sleep_heap[0].wakeup_time_sec <= current_time) { // Peek before pop
+        Coroutine* sleeper_coro = pop_earliest_sleeper(interpreter);
 #ifdef DEBUG_ECHOC
-        fprintf(stderr, "SLEEP_DEBUG: Waking up sleeper %s (%p). Wakeup: %.2f, Current: %.2f. SleepQ_Head before pop: %p\n",
+        fprintf(stderr, "SLEEP_DEBUG: Waking up sleeper %s (%p). Wakeup: %.2f, Current: %.2f. SleepQ count after pop: %d\n",
                  sleeper_coro->name ? sleeper_coro->name : "unnamed", (void*)sleeper_coro,
-                 sleeper_coro->wakeup_time_sec, current_time, (void*)interpreter->async_sleep_queue_head);
+                 sleeper_coro->wakeup_time_sec, current_time, interpreter->async_sleep_count);
         fflush(stderr);
 
 #endif
-        interpreter->async_sleep_queue_head = head_node->next;
-        if (!interpreter->async_sleep_queue_head) {
-            interpreter->async_sleep_queue_tail = NULL;
-        }
-        free(head_node);
 
         // Save name for logging *before* any potential free by waiters
         char* sleeper_name_for_log = NULL;
@@ -212,7 +231,7 @@ static void check_and_move_sleepers_to_ready_queue(Interpreter* interpreter) {
             sleeper_coro->has_exception = 1; // Mark that it completed with an exception
         if (sleeper_coro->exception_value.type != VAL_NULL) free_value_contents(sleeper_coro->exception_value);
             sleeper_coro->exception_value.type = VAL_STRING;
-            sleeper_coro->exception_value.as.string_val = strdup(CANCELLED_ERROR_MSG);
+            sleeper_coro->exception_value.as.string_val = string_value_create(CANCELLED_ERROR_MSG);
             if (!sleeper_coro->exception_value.as.string_val) {
                 if (sleeper_name_for_log) free(sleeper_name_for_log);
                 // report_error exits, so sleeper_name_for_log might not be freed if it was non-NULL.
@@ -267,9 +286,9 @@ static void check_and_move_sleepers_to_ready_queue(Interpreter* interpreter) {
                     waiter_node = next_waiter_node;
                 }
 #ifdef DEBUG_ECHOC
-                fprintf(stderr, "SLEEP_DEBUG: Timer coro %s (%p) DONE. Waking waiters. Destroyed self. SleepQ_Head after pop: %p\n",
+                fprintf(stderr, "SLEEP_DEBUG: Timer coro %s (%p) DONE. Waking waiters. Destroyed self. SleepQ count after pop: %d\n",
                          sleeper_name_for_log ? sleeper_name_for_log : "unnamed_async_sleep",
-                         (void*)sleeper_coro, (void*)interpreter->async_sleep_queue_head);
+                         (void*)sleeper_coro, interpreter->async_sleep_count);
                 fflush(stderr);
 #endif
             } else { 
@@ -280,10 +299,10 @@ static void check_and_move_sleepers_to_ready_queue(Interpreter* interpreter) {
                 sleeper_coro->state = CORO_RUNNABLE;
                 add_to_ready_queue(interpreter, sleeper_coro);
 #ifdef DEBUG_ECHOC
-                fprintf(stderr, "SLEEP_DEBUG: Non-async_sleep sleeper %s (%p) woke. Added to readyQ. SleepQ_Head after pop: %p\n",
+                fprintf(stderr, "SLEEP_DEBUG: Non-async_sleep sleeper %s (%p) woke. Added to readyQ. SleepQ count after pop: %d\n",
                          sleeper_name_for_log ? sleeper_name_for_log : "unnamed", 
                          (void*)sleeper_coro, 
-                         (void*)interpreter->async_sleep_queue_head);
+                         interpreter->async_sleep_count);
                 fflush(stderr);
 #endif
             }
@@ -304,36 +323,36 @@ static void check_and_move_sleepers_to_ready_queue(Interpreter* interpreter) {
 void run_event_loop(Interpreter* interpreter) {
     // Main event loop to process runnable coroutines and manage suspended ones.
 #ifdef DEBUG_ECHOC
-    fprintf(stderr, "EVENT_LOOP_DEBUG: Entered run_event_loop. ReadyQ_Head: %p, SleepQ_Head: %p\n",
+    fprintf(stderr, "EVENT_LOOP_DEBUG: Entered run_event_loop. ReadyQ_Head: %p, SleepQ count: %d\n",
                  (void*)interpreter->async_ready_queue_head,
-                 (void*)interpreter->async_sleep_queue_head);
+                 interpreter->async_sleep_count);
     fflush(stderr);
 #endif
     interpreter->async_event_loop_active = 1; // Indicate event loop is running
 
-    while (interpreter->async_ready_queue_head || interpreter->async_sleep_queue_head) {
+    while (interpreter->async_ready_queue_head || interpreter->async_sleep_count > 0) {
 // --- Start of New Event Loop Implementation ---
 
 #ifdef DEBUG_ECHOC
-        fprintf(stderr, "EVENT_LOOP_DEBUG: Top of loop. ReadyQ: %p, SleepQ: %p\n",
+        fprintf(stderr, "EVENT_LOOP_DEBUG: Top of loop. ReadyQ: %p, SleepQ count: %d\n",
                      (void*)interpreter->async_ready_queue_head,
-                     (void*)interpreter->async_sleep_queue_head);
+                     interpreter->async_sleep_count);
         fflush(stderr);
 #endif
     // First, move any ready sleepers to the ready queue
     check_and_move_sleepers_to_ready_queue(interpreter);
 #ifdef DEBUG_ECHOC
-    fprintf(stderr, "EVENT_LOOP_DEBUG: After check_sleepers. ReadyQ: %p, SleepQ: %p\n",
+    fprintf(stderr, "EVENT_LOOP_DEBUG: After check_sleepers. ReadyQ: %p, SleepQ count: %d\n",
                      (void*)interpreter->async_ready_queue_head,
-                     (void*)interpreter->async_sleep_queue_head);
+                     interpreter->async_sleep_count);
     fflush(stderr);
 #endif
     if (!interpreter->async_ready_queue_head) {
-        if (interpreter->async_sleep_queue_head) {
+        if (interpreter->async_sleep_count > 0) {
             // Ready queue is empty, but there are sleeping tasks.
             // Calculate how long to sleep until the next task wakes up.
             double now = get_monotonic_time_sec();
-            double next_wakeup_time = interpreter->async_sleep_queue_head->coro->wakeup_time_sec;
+            double next_wakeup_time = interpreter->async_sleep_heap[0].wakeup_time_sec;
             double sleep_duration_sec = next_wakeup_time - now;
 
             if (sleep_duration_sec > 0) {
@@ -367,6 +386,18 @@ void run_event_loop(Interpreter* interpreter) {
     // We use an if-else structure to handle different states.
     if (current_coro->state == CORO_RUNNABLE || current_coro->state == CORO_RESUMING) {
         // Coroutine is not yet done, so we execute it.
+        if (current_coro->is_cancelled && current_coro->context) {
+            // Suspended mid-body: raise the cancellation at its 'await' so the body unwinds
+            // through its own try/finally blocks. Delivered once; the body may catch it.
+            current_coro->is_cancelled = 0;
+            free_value_contents(current_coro->value_from_await);
+            current_coro->value_from_await.type = VAL_STRING;
+            current_coro->value_from_await.as.string_val = string_value_create(CANCELLED_ERROR_MSG);
+            if (!current_coro->value_from_await.as.string_val) {
+                 report_error("System", "Failed to strdup CANCELLED_ERROR_MSG for suspended coro.", NULL);
+            }
+            current_coro->resumed_with_exception = 1;
+        }
         if (current_coro->is_cancelled) {
             // Finalize it as cancelled.
             DEBUG_PRINTF("Event Loop: Coro %s (%p) from ready queue is cancelled. Finalizing.", current_coro->name ? current_coro->name : "unnamed", (void*)current_coro);
@@ -374,7 +405,7 @@ void run_event_loop(Interpreter* interpreter) {
             current_coro->has_exception = 1;
             if (current_coro->exception_value.type != VAL_NULL) free_value_contents(current_coro->exception_value);
             current_coro->exception_value.type = VAL_STRING;
-            current_coro->exception_value.as.string_val = strdup(CANCELLED_ERROR_MSG);
+            current_coro->exception_value.as.string_val = string_value_create(CANCELLED_ERROR_MSG);
             if (!current_coro->exception_value.as.string_val) {
                  report_error("System", "Failed to strdup CANCELLED_ERROR_MSG for ready queue coro.", NULL);
             }
@@ -421,9 +452,9 @@ void run_event_loop(Interpreter* interpreter) {
     coroutine_decref_and_free_if_zero(current_coro);
 }
 #ifdef DEBUG_ECHOC
-    fprintf(stderr, "EVENT_LOOP_DEBUG: Exited run_event_loop. ReadyQ_Head: %p, SleepQ_Head: %p\n",
+    fprintf(stderr, "EVENT_LOOP_DEBUG: Exited run_event_loop. ReadyQ_Head: %p, SleepQ count: %d\n",
                  (void*)interpreter->async_ready_queue_head,
-                 (void*)interpreter->async_sleep_queue_head);
+                 interpreter->async_sleep_count);
     fflush(stderr);
 #endif
     interpreter->async_event_loop_active = 0; // Indicate event loop has finished
@@ -489,6 +520,7 @@ static void handle_completed_coroutine(Interpreter* interpreter, Coroutine* done
                             Array* final_results_array = (Array*)malloc(sizeof(Array));
                             if (!final_results_array) report_error("System", "Failed to allocate final results array for gather.", NULL);
                             final_results_array->count = parent_gather->gather_results->count;
+                            final_results_array->ref_count = 1;
                             final_results_array->capacity = parent_gather->gather_results->capacity;
                             final_results_array->elements = (Value*)malloc(sizeof(Value) * final_results_array->capacity);
                             if (!final_results_array->elements) { free(final_results_array); report_error("System", "Failed to allocate elements for final gather results array.", NULL); }
@@ -510,6 +542,7 @@ static void handle_completed_coroutine(Interpreter* interpreter, Coroutine* done
                             Array* final_results_array = (Array*)malloc(sizeof(Array));
                             if (!final_results_array) report_error("System", "Failed to allocate final results array for gather.", NULL);
                             final_results_array->count = parent_gather->gather_results->count;
+                            final_results_array->ref_count = 1;
                             final_results_array->capacity = parent_gather->gather_results->capacity;
                             final_results_array->elements = (Value*)malloc(sizeof(Value) * final_results_array->capacity);
                             if (!final_results_array->elements) { free(final_results_array); report_error("System", "Failed to allocate elements for final gather results array.", NULL); }
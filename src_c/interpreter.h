@@ -21,5 +21,11 @@ void add_to_sleep_queue(Interpreter* interpreter, Coroutine* coro);
 void run_event_loop(Interpreter* interpreter);
 // destroy_coroutine is already declared in header.h
 StatementExecStatus interpret_coroutine_body(Interpreter* interpreter, Coroutine* coro_to_run); 
+// Called by 'await' on the running coroutine: parks it until interpret_coroutine_body resumes it.
+void coroutine_suspend(Interpreter* interpreter, Coroutine* coro);
+
+// Drop every coroutine still queued (defined in main.c, used at the end of a run).
+void robust_free_coroutine_queue(Interpreter* interpreter, CoroutineQueueNode** p_head, CoroutineQueueNode** p_tail);
+void robust_free_sleep_queue(Interpreter* interpreter);
 
 #endif // ECHOC_INTERPRETER_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 // src_c/lexer.c
 #include "header.h"
 #include "parser_utils.h" // For token_type_to_string
+#include "source_unit.h"
 
 Token* make_token(TokenType type, char* value, int line, int col) {
     // Use calloc to ensure all fields are zero-initialized.
@@ -21,70 +22,75 @@ void free_token(Token* token) {
         // Enhanced Debugging for free_token
         DEBUG_PRINTF("FREE_TOKEN: Addr=%p, Type=%s (%d), Value='%s', Line=%d, Col=%d", (void*)token, (token->type == TOKEN_EOF ? "EOF" : token_type_to_string(token->type)), token->type,
                      token->value ? token->value : "NULL", token->line, token->col);
-        // Free the token's value only if it's a type that dynamically allocates its value string.
-        // Single-character tokens (PLUS, MINUS, etc.) use string literals for their value,
-        // which should not be freed.
-        // Keywords also get their string from lexer_get_identifier, which mallocs.
-        switch (token->type) {
-            case TOKEN_INTEGER:
-            case TOKEN_FLOAT:
-            case TOKEN_STRING:
-            case TOKEN_ID:        
-            case TOKEN_LET:   // "let" is processed as an ID first
-            case TOKEN_TRUE:  // "true" is processed as an ID first
-            case TOKEN_FALSE: // "false" is processed as an ID first
-            case TOKEN_AND:
-            case TOKEN_OR:
-            case TOKEN_NOT:
-            case TOKEN_IF:
-            case TOKEN_ELIF:
-            case TOKEN_ELSE:
-            case TOKEN_LOOP:
-            case TOKEN_WHILE:
-            case TOKEN_FOR:
-            case TOKEN_FROM:
-            case TOKEN_TO:
-            case TOKEN_SKIP:
-            case TOKEN_STEP:
-            case TOKEN_IN:
-            case TOKEN_BREAK:
-            case TOKEN_CONTINUE:
-            case TOKEN_FUNCT:
-            case TOKEN_RETURN:
-            case TOKEN_NULL:
-            //case TOKEN_END: deprecated
-            case TOKEN_TRY:
-            case TOKEN_CATCH:
-            case TOKEN_AS:
-            case TOKEN_ASSIGN_KEYWORD:
-            case TOKEN_FINALLY:
-            case TOKEN_IS:
-            case TOKEN_BLUEPRINT:
-            case TOKEN_INHERITS:
-            case TOKEN_SUPER:
-            case TOKEN_RAISE:
-            case TOKEN_LOAD:
-            case TOKEN_ASYNC:
-            case TOKEN_AWAIT:
-            case TOKEN_EQ:  // "=="
-            case TOKEN_NEQ: // "!="
-            case TOKEN_LTE: // "<="
-            case TOKEN_GTE: // ">="
-            // Note: Comparison operators like TOKEN_EQ might use string literals if single char,
-            // or malloc'd if multi-char. Let's assume multi-char ops get malloc'd values for now.
-            // For simplicity, we'll handle their values like IDs for freeing.
-                if (token->value) free(token->value);
-                break;
-            default:
-                // For other token types, token->value is usually a literal or not set.
-                break;
-        }
+        if (token->is_borrowed) return; // Owned by its SourceUnit's token cache
+        free_token_contents(token);
         free(token); // Free the token struct itself
     } else {
         DEBUG_PRINTF("FREE_TOKEN: Attempt to free NULL token pointer.%s", "");
     }
 }
 
+// Free the token's value only if it's a type that dynamically allocates its value string.
+// Single-character tokens (PLUS, MINUS, etc.) use string literals for their value,
+// which should not be freed.
+// Keywords also get their string from lexer_get_identifier, which mallocs.
+bool token_type_owns_value(TokenType type) {
+    switch (type) {
+        case TOKEN_INTEGER:
+        case TOKEN_FLOAT:
+        case TOKEN_STRING:
+        case TOKEN_ID:        
+        case TOKEN_LET:   // "let" is processed as an ID first
+        case TOKEN_TRUE:  // "true" is processed as an ID first
+        case TOKEN_FALSE: // "false" is processed as an ID first
+        case TOKEN_AND:
+        case TOKEN_OR:
+        case TOKEN_NOT:
+        case TOKEN_IF:
+        case TOKEN_ELIF:
+        case TOKEN_ELSE:
+        case TOKEN_LOOP:
+        case TOKEN_WHILE:
+        case TOKEN_FOR:
+        case TOKEN_FROM:
+        case TOKEN_TO:
+        case TOKEN_SKIP:
+        case TOKEN_STEP:
+        case TOKEN_IN:
+        case TOKEN_BREAK:
+        case TOKEN_CONTINUE:
+        case TOKEN_FUNCT:
+        case TOKEN_RETURN:
+        case TOKEN_NULL:
+        //case TOKEN_END: deprecated
+        case TOKEN_TRY:
+        case TOKEN_CATCH:
+        case TOKEN_AS:
+        case TOKEN_ASSIGN_KEYWORD:
+        case TOKEN_FINALLY:
+        case TOKEN_IS:
+        case TOKEN_BLUEPRINT:
+        case TOKEN_INHERITS:
+        case TOKEN_SUPER:
+        case TOKEN_RAISE:
+        case TOKEN_LOAD:
+        case TOKEN_ASYNC:
+        case TOKEN_AWAIT:
+        case TOKEN_EQ:  // "=="
+        case TOKEN_NEQ: // "!="
+        case TOKEN_LTE: // "<="
+        case TOKEN_GTE: // ">="
+            return true;
+        default:
+            // For other token types, token->value is usually a literal or not set.
+            return false;
+    }
+}
+
+void free_token_contents(Token* token) {
+    if (token_type_owns_value(token->type) && token->value) free(token->value);
+}
+
 void lexer_advance(Lexer* lexer) {
     // DEBUG_PRINTF("LEXER_ADVANCE_START: Pos=%d, Line=%d, Col=%d, Char='%c'(%d)", lexer->pos, lexer->line, lexer->col, lexer->current_char, lexer->current_char);
     // First, check for newlines to update position correctly
@@ -147,7 +153,7 @@ static void ensure_string_capacity(char** buffer_ptr, size_t* capacity_ptr, size
         char* new_buffer = realloc(*buffer_ptr, new_capacity);
         if (!new_buffer) {
             free(*buffer_ptr);
-            Token temp_token = {TOKEN_UNKNOWN, NULL, lexer_for_error_reporting ? lexer_for_error_reporting->line : start_line, lexer_for_error_reporting ? lexer_for_error_reporting->col : start_col};
+            Token temp_token = {TOKEN_UNKNOWN, NULL, lexer_for_error_reporting ? lexer_for_error_reporting->line : start_line, lexer_for_error_reporting ? lexer_for_error_reporting->col : start_col, false};
             report_error("System", "Failed to reallocate memory for string literal buffer", &temp_token);
         }
         *buffer_ptr = new_buffer;
@@ -159,7 +165,7 @@ char* lexer_get_string(Lexer* lexer, char quote_char, int start_line_for_error,
     size_t capacity = 64;
     char* result = malloc(capacity);
     if (!result) {
-        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error};
+        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error, false};
         report_error("System", "Failed to allocate memory for string literal buffer", &temp_token);
     }
     size_t i = 0;
@@ -225,7 +231,7 @@ char* lexer_get_string(Lexer* lexer, char quote_char, int start_line_for_error,
         free(result);
         char err_msg[256];
         snprintf(err_msg, sizeof(err_msg), "Unterminated string literal starting at line %d, col %d.", start_line_for_error, start_col_for_error);
-        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error};
+        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error, false};
         report_error("Lexical", err_msg, &temp_token);
     }
     
@@ -233,7 +239,7 @@ char* lexer_get_string(Lexer* lexer, char quote_char, int start_line_for_error,
         free(result);
         char err_msg[256];
         snprintf(err_msg, sizeof(err_msg), "Mismatched braces in string interpolation starting at line %d, col %d.", start_line_for_error, start_col_for_error);
-        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error};
+        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error, false};
         report_error("Lexical", err_msg, &temp_token);
     }
 
@@ -244,27 +250,84 @@ char* lexer_get_string(Lexer* lexer, char quote_char, int start_line_for_error,
 }
 
 
-char* lexer_get_identifier(Lexer* lexer) {
-    size_t capacity = 32; // Initial capacity
-    char* result = malloc(capacity);
-    if (!result) report_error("System", "Failed to allocate memory for identifier string", NULL); // Token context might be hard here
-    size_t i = 0;
+// Keyword recognition: a perfect hash over the first, second and last characters and the
+// length. The multipliers were searched offline so that no two keywords share a slot;
+// the table is built by the compiler, and a collision introduced by a new keyword shows
+// up as an overridden initializer (-Woverride-init, part of -Wextra). An identifier costs
+// one table probe and at most one memcmp, whether or not it turns out to be a keyword.
+#define KEYWORD_TABLE_SIZE 64
+#define KEYWORD_MAX_LENGTH 9
+#define KEYWORD_SLOT(first, second, last, length) \
+    (((unsigned)(first) + (unsigned)(second) * 30u + (unsigned)(last) * 49u + (unsigned)(length)) & (KEYWORD_TABLE_SIZE - 1))
+
+typedef struct {
+    const char* word; // NULL for an empty slot
+    size_t length;
+    TokenType type;
+} KeywordEntry;
+
+static const KeywordEntry keyword_table[KEYWORD_TABLE_SIZE] = {
+    [KEYWORD_SLOT('l', 'e', 't', 3)] = { "let", 3, TOKEN_LET },
+    [KEYWORD_SLOT('t', 'r', 'e', 4)] = { "true", 4, TOKEN_TRUE },
+    [KEYWORD_SLOT('f', 'a', 'e', 5)] = { "false", 5, TOKEN_FALSE },
+    [KEYWORD_SLOT('a', 'n', 'd', 3)] = { "and", 3, TOKEN_AND },
+    [KEYWORD_SLOT('o', 'r', 'r', 2)] = { "or", 2, TOKEN_OR },
+    [KEYWORD_SLOT('n', 'o', 't', 3)] = { "not", 3, TOKEN_NOT },
+    [KEYWORD_SLOT('i', 'f', 'f', 2)] = { "if", 2, TOKEN_IF },
+    [KEYWORD_SLOT('e', 'l', 'f', 4)] = { "elif", 4, TOKEN_ELIF },
+    [KEYWORD_SLOT('e', 'l', 'e', 4)] = { "else", 4, TOKEN_ELSE },
+    [KEYWORD_SLOT('l', 'o', 'p', 4)] = { "loop", 4, TOKEN_LOOP },
+    [KEYWORD_SLOT('n', 'u', 'l', 4)] = { "null", 4, TOKEN_NULL },
+    [KEYWORD_SLOT('w', 'h', 'e', 5)] = { "while", 5, TOKEN_WHILE },
+    [KEYWORD_SLOT('f', 'o', 'r', 3)] = { "for", 3, TOKEN_FOR },
+    [KEYWORD_SLOT('f', 'r', 'm', 4)] = { "from", 4, TOKEN_FROM },
+    [KEYWORD_SLOT('t', 'o', 'o', 2)] = { "to", 2, TOKEN_TO },
+    [KEYWORD_SLOT('s', 't', 'p', 4)] = { "step", 4, TOKEN_STEP },
+    [KEYWORD_SLOT('s', 'k', 'p', 4)] = { "skip", 4, TOKEN_SKIP },
+    [KEYWORD_SLOT('i', 'n', 'n', 2)] = { "in", 2, TOKEN_IN },
+    [KEYWORD_SLOT('b', 'r', 'k', 5)] = { "break", 5, TOKEN_BREAK },
+    [KEYWORD_SLOT('c', 'o', 'e', 8)] = { "continue", 8, TOKEN_CONTINUE },
+    [KEYWORD_SLOT('f', 'u', 't', 5)] = { "funct", 5, TOKEN_FUNCT },
+    [KEYWORD_SLOT('r', 'e', 'n', 6)] = { "return", 6, TOKEN_RETURN },
+    [KEYWORD_SLOT('t', 'r', 'y', 3)] = { "try", 3, TOKEN_TRY },
+    [KEYWORD_SLOT('c', 'a', 'h', 5)] = { "catch", 5, TOKEN_CATCH },
+    [KEYWORD_SLOT('i', 's', 's', 2)] = { "is", 2, TOKEN_IS },
+    [KEYWORD_SLOT('a', 's', 's', 2)] = { "as", 2, TOKEN_AS },
+    [KEYWORD_SLOT('f', 'i', 'y', 7)] = { "finally", 7, TOKEN_FINALLY },
+    [KEYWORD_SLOT('b', 'l', 't', 9)] = { "blueprint", 9, TOKEN_BLUEPRINT },
+    [KEYWORD_SLOT('i', 'n', 's', 8)] = { "inherits", 8, TOKEN_INHERITS },
+    [KEYWORD_SLOT('s', 'u', 'r', 5)] = { "super", 5, TOKEN_SUPER },
+    [KEYWORD_SLOT('r', 'a', 'e', 5)] = { "raise", 5, TOKEN_RAISE },
+    [KEYWORD_SLOT('l', 'o', 'd', 4)] = { "load", 4, TOKEN_LOAD },
+    [KEYWORD_SLOT('a', 's', 'c', 5)] = { "async", 5, TOKEN_ASYNC },
+    [KEYWORD_SLOT('a', 'w', 't', 5)] = { "await", 5, TOKEN_AWAIT },
+};
+
+static TokenType lexer_keyword_type(const char* id, size_t length) {
+    if (length < 2 || length > KEYWORD_MAX_LENGTH) return TOKEN_ID;
+    const KeywordEntry* entry = &keyword_table[KEYWORD_SLOT((unsigned char)id[0], (unsigned char)id[1], (unsigned char)id[length - 1], length)];
+    if (entry->length == length && memcmp(entry->word, id, length) == 0) return entry->type;
+    return TOKEN_ID;
+}
 
-    while (lexer->current_char != '\0' &&
-           (isalnum((unsigned char)lexer->current_char) || lexer->current_char == '_')) {
-        if (i >= capacity - 1) { // -1 for null terminator
-            capacity *= 2;
-            char* new_result = realloc(result, capacity);
-            if (!new_result) {
-                free(result);
-                report_error("System", "Failed to reallocate memory for identifier string", NULL);
-            }
-            result = new_result;
-        }
-        result[i++] = lexer->current_char;
-        lexer_advance(lexer);
+// Scans an identifier (or keyword) and returns a malloc'd copy; '*length_out' receives its length.
+char* lexer_get_identifier(Lexer* lexer, size_t* length_out) {
+    int start = lexer->pos;
+    int end = start;
+    int text_length = (int)lexer->text_length;
+    while (end < text_length && (isalnum((unsigned char)lexer->text[end]) || lexer->text[end] == '_')) {
+        end++;
     }
-    result[i] = '\0';
+    // Same effect as lexer_advance per character: an identifier never spans a newline.
+    lexer->col += end - start;
+    lexer->pos = end;
+    lexer->current_char = end < text_length ? lexer->text[end] : '\0';
+    size_t length = (size_t)(end - start);
+    char* result = malloc(length + 1);
+    if (!result) report_error("System", "Failed to allocate memory for identifier string", NULL); // Token context might be hard here
+    memcpy(result, lexer->text + start, length);
+    result[length] = '\0';
+    *length_out = length;
     return result;
 }
 
@@ -280,7 +343,7 @@ char* lexer_get_multiline_string(Lexer* lexer, int start_line_for_error, int sta
     char* buffer = malloc(capacity);
     if (!buffer) {
         // In a real scenario, make_token for context might be better if available
-        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error};
+        Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error, false};
         report_error("System", "Failed to allocate memory for multiline string buffer", &temp_token);
         return NULL; // Should not be reached
     }
@@ -292,7 +355,7 @@ char* lexer_get_multiline_string(Lexer* lexer, int start_line_for_error, int sta
             free(buffer);
             char err_msg[256];
             snprintf(err_msg, sizeof(err_msg), "Unterminated multiline string (\"\"\") starting at line %d, col %d.", start_line_for_error, start_col_for_error);
-            Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error};
+            Token temp_token = {TOKEN_UNKNOWN, NULL, start_line_for_error, start_col_for_error, false};
             report_error("Lexical", err_msg, &temp_token);
             return NULL; // Should not be reached
         }
@@ -313,7 +376,7 @@ char* lexer_get_multiline_string(Lexer* lexer, int start_line_for_error, int sta
             char* new_buffer = realloc(buffer, capacity);
             if (!new_buffer) {
                 free(buffer);
-                Token temp_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col}; // Current pos for realloc error
+                Token temp_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col, false}; // Current pos for realloc error
                 report_error("System", "Failed to reallocate memory for multiline string buffer", &temp_token);
                 return NULL; // Should not be reached
             }
@@ -348,6 +411,8 @@ LexerState get_lexer_state(Lexer* lexer) {
     state.col = lexer->col;
     state.text = lexer->text;               // Save text pointer
     state.text_length = lexer->text_length; // Save text length
+    state.unit = lexer->unit;
+    state.token_index = lexer->token_index;
     DEBUG_PRINTF("GET_LEXER_STATE: For Lexer ADDR=%p. Captured: Pos=%d, Line=%d, Col=%d, TextPtr=%p, TextLen=%zu, CurrentCharRelevantToPos='%c'",
                  (void*)lexer, // Log address of lexer being snapshotted
                  state.pos, state.line, state.col, (void*)state.text, state.text_length, (state.pos < (int)state.text_length && state.pos >= 0 ? state.text[state.pos] : '?'));
@@ -359,10 +424,27 @@ void set_lexer_state(Lexer* lexer, LexerState state) {
     lexer->text = state.text;
     lexer->text_length = state.text_length;
     lexer->pos = state.pos;
+    lexer->unit = (state.unit && state.unit->text == state.text) ? state.unit : NULL;
+    lexer->token_index = lexer->unit ? state.token_index : -1;
 
     // Validate pos against the (potentially new) text_length
     if (lexer->pos < 0) lexer->pos = 0; // Basic sanity
     if ((size_t)lexer->pos > lexer->text_length) lexer->pos = lexer->text_length; // Cap pos at end
+    lexer->current_char = (size_t)lexer->pos < lexer->text_length ? lexer->text[lexer->pos] : '\0';
+
+    if (lexer->unit) {
+        // States captured from a unit cursor carry a token index and exact line/col: restore in O(1).
+        // Otherwise recompute line/col from the unit's line-start index instead of walking from
+        // offset 0, and locate the next cached token by position.
+        if (lexer->token_index >= 0) {
+            lexer->line = state.line;
+            lexer->col = state.col;
+        } else {
+            source_unit_position_of(lexer->unit, lexer->pos, &lexer->line, &lexer->col);
+            lexer->token_index = source_unit_token_index_at(lexer->unit, lexer->pos);
+        }
+        return;
+    }
 
     // Recalculate line and col from the restored pos and text, ignoring state.line and state.col
     // as they might be corrupted.
@@ -381,12 +463,6 @@ void set_lexer_state(Lexer* lexer, LexerState state) {
     lexer->line = current_l;
     lexer->col = current_c;
 
-    if ((size_t)lexer->pos >= lexer->text_length) {
-        lexer->current_char = '\0';
-    } else {
-        lexer->current_char = lexer->text[lexer->pos];
-    }
-
     DEBUG_PRINTF("SET_LEXER_STATE (Recalculated): For Lexer ADDR=%p. Input State (Pos=%d, Line=%d, Col=%d). Effective: Pos=%d, Line=%d, Col=%d, TextPtr=%p, TextLen=%zu, CurrentChar='%c'",
                  (void*)lexer,
                  state.pos, state.line, state.col, // Log original input state for comparison
@@ -421,6 +497,25 @@ LexerState get_lexer_state_for_token_start(Lexer* lexer, int token_line, int tok
     state.col = token_col;
     state.text = lexer->text; // Capture the text pointer from the lexer
     state.text_length = lexer->text_length; // Capture the text length
+    state.unit = lexer->unit;
+    state.token_index = -1;
+
+    if (lexer->unit) {
+        // Tokens are cached in source order, so the start can be found without scanning text.
+        int index = source_unit_find_token(lexer->unit, token_line, token_col);
+        if (index >= 0) {
+            state.token_index = index;
+            state.pos = SOURCE_UNIT_ENTRY(lexer->unit, index)->start_pos;
+        } else {
+            // Not a cached token start: the line-start index still maps line/col to an offset directly.
+            state.pos = source_unit_offset_of(lexer->unit, token_line, token_col);
+            if (state.pos < 0) {
+                report_error("Internal", "Could not find token start position in get_lexer_state_for_token_start", error_context_token_for_report);
+            }
+        }
+        state.current_char = (size_t)state.pos < lexer->text_length ? lexer->text[state.pos] : '\0';
+        return state;
+    }
 
     int p = 0;
     int current_l = 1;
@@ -448,7 +543,28 @@ LexerState get_lexer_state_for_token_start(Lexer* lexer, int token_line, int tok
     return state;
 }
 
+// Returns the next token. Lexers bound to a SourceUnit read the unit's cached token
+// stream; ad-hoc text (e.g. interpolation snippets) is scanned character by character.
 Token* get_next_token(Lexer* lexer) {
+    if (lexer->unit) {
+        SourceUnit* unit = lexer->unit;
+        if (lexer->token_index < 0) {
+            lexer->token_index = source_unit_token_index_at(unit, lexer->pos);
+        }
+        const SourceUnitToken* cached = source_unit_token_at(unit, lexer->token_index);
+        lexer->pos = cached->end_pos;
+        lexer->line = cached->end_line;
+        lexer->col = cached->end_col;
+        lexer->current_char = (size_t)lexer->pos < lexer->text_length ? lexer->text[lexer->pos] : '\0';
+        if (cached->token.type != TOKEN_EOF) lexer->token_index++;
+        return (Token*)&cached->token; // Borrowed: no allocation, free_token ignores it
+    }
+    return lexer_scan_token(lexer, NULL);
+}
+
+// Scans the next token from the lexer's characters. If token_start_pos is given,
+// it receives the text offset where the token begins (after whitespace and comments).
+Token* lexer_scan_token(Lexer* lexer, int* token_start_pos) {
     int line_at_token_start;
     int col_at_token_start;
     DEBUG_PRINTF("GET_NEXT_TOKEN_TOP: Pos=%d, Line=%d, Col=%d, Char='%c'(%d)", lexer->pos, lexer->line, lexer->col, lexer->current_char, lexer->current_char);
@@ -475,7 +591,7 @@ Token* get_next_token(Lexer* lexer) {
                 if (lexer->current_char != '\n' && lexer->current_char != '\0' && (leading_spaces % 4 != 0)) {
                     char err_msg[256];
                     snprintf(err_msg, sizeof(err_msg), "Invalid indentation: %d spaces. Must be a multiple of 4.", leading_spaces);
-                    Token temp_error_token = {TOKEN_UNKNOWN, NULL, indentation_error_line, indentation_error_col};
+                    Token temp_error_token = {TOKEN_UNKNOWN, NULL, indentation_error_line, indentation_error_col, false};
                     report_error("Lexical", err_msg, &temp_error_token);
                 }
             } else if (isspace((unsigned char)lexer->current_char) && lexer->current_char != ' ') { // Starts with non-space whitespace
@@ -495,7 +611,7 @@ Token* get_next_token(Lexer* lexer) {
                 if (peek_char != '\n' && peek_char != '\0') {
                     char err_msg[256];
                     snprintf(err_msg, sizeof(err_msg), "Invalid character ('%c') used for indentation at line %d, col %d. Only spaces are allowed when content follows.", lexer->current_char, lexer->line, lexer->col);
-                    Token temp_error_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col};
+                    Token temp_error_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col, false};
                     report_error("Lexical", err_msg, &temp_error_token);
                 }
                 // If peek_char IS \n or \0, the line was effectively "empty" or "whitespace-only" (e.g. "\t\n").
@@ -547,7 +663,7 @@ Token* get_next_token(Lexer* lexer) {
             if (!found_closing_delimiter) { // Check if loop exited due to EOF *without* finding delimiter
                 char err_msg[256];
                 snprintf(err_msg, sizeof(err_msg), "Unterminated \"'''\" block comment that started on line %d.", comment_start_line);
-                Token temp_error_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col};
+                Token temp_error_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col, false};
                 report_error("Lexical", err_msg, &temp_error_token);
             }
             DEBUG_PRINTF("  GET_NEXT_TOKEN_BLOCK_COMMENT_END at L%d C%d", lexer->line, lexer->col);
@@ -584,7 +700,7 @@ Token* get_next_token(Lexer* lexer) {
             if (!found_closing_delimiter) {
                 char err_msg[256];
                 snprintf(err_msg, sizeof(err_msg), "Unterminated inline comment '--' that started on line %d, col %d.", comment_start_line, comment_start_col);
-                Token temp_error_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col};
+                Token temp_error_token = {TOKEN_UNKNOWN, NULL, lexer->line, lexer->col, false};
                 report_error("Lexical", err_msg, &temp_error_token);
             }
             
@@ -596,47 +712,17 @@ Token* get_next_token(Lexer* lexer) {
         // If we reach here, it means current_char is part of a token
         line_at_token_start = lexer->line; // Capture line/col *after* skipping
         col_at_token_start = lexer->col;
+        if (token_start_pos) *token_start_pos = lexer->pos;
         DEBUG_PRINTF("  GET_NEXT_TOKEN_TOKEN_START_CAPTURE: Line=%d, Col=%d, Char='%c'(%d)", line_at_token_start, col_at_token_start, lexer->current_char, lexer->current_char);
 
         // --- Token Parsing Logic ---
         // This section should only be reached if no whitespace or comment was skipped in this iteration.
         { 
             if (isalpha((unsigned char)lexer->current_char) || lexer->current_char == '_') {
-                char* id_str = lexer_get_identifier(lexer);
-                if (strcmp(id_str, "let") == 0) return make_token(TOKEN_LET, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "true") == 0) return make_token(TOKEN_TRUE, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "false") == 0) return make_token(TOKEN_FALSE, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "and") == 0) return make_token(TOKEN_AND, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "or") == 0) return make_token(TOKEN_OR, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "not") == 0) return make_token(TOKEN_NOT, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "if") == 0) return make_token(TOKEN_IF, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "elif") == 0) return make_token(TOKEN_ELIF, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "else") == 0) return make_token(TOKEN_ELSE, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "loop") == 0) return make_token(TOKEN_LOOP, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "null") == 0) return make_token(TOKEN_NULL, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "while") == 0) return make_token(TOKEN_WHILE, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "for") == 0) return make_token(TOKEN_FOR, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "from") == 0) return make_token(TOKEN_FROM, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "to") == 0) return make_token(TOKEN_TO, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "step") == 0) return make_token(TOKEN_STEP, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "skip") == 0) return make_token(TOKEN_SKIP, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "in") == 0) return make_token(TOKEN_IN, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "break") == 0) return make_token(TOKEN_BREAK, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "continue") == 0) return make_token(TOKEN_CONTINUE, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "funct") == 0) return make_token(TOKEN_FUNCT, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "return") == 0) return make_token(TOKEN_RETURN, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "try") == 0) return make_token(TOKEN_TRY, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "catch") == 0) return make_token(TOKEN_CATCH, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "is") == 0) return make_token(TOKEN_IS, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "as") == 0) return make_token(TOKEN_AS, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "finally") == 0) return make_token(TOKEN_FINALLY, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "blueprint") == 0) return make_token(TOKEN_BLUEPRINT, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "inherits") == 0) return make_token(TOKEN_INHERITS, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "super") == 0) return make_token(TOKEN_SUPER, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "raise") == 0) return make_token(TOKEN_RAISE, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "load") == 0) return make_token(TOKEN_LOAD, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "async") == 0) return make_token(TOKEN_ASYNC, id_str, line_at_token_start, col_at_token_start);
-                if (strcmp(id_str, "await") == 0) return make_token(TOKEN_AWAIT, id_str, line_at_token_start, col_at_token_start);
+                size_t id_length;
+                char* id_str = lexer_get_identifier(lexer, &id_length);
+                TokenType keyword_type = lexer_keyword_type(id_str, id_length);
+                if (keyword_type != TOKEN_ID) return make_token(keyword_type, id_str, line_at_token_start, col_at_token_start);
                 DEBUG_PRINTF("  GET_NEXT_TOKEN_RETURNING_TOKEN: Type=IDENTIFIER, Value='%s', Line=%d, Col=%d", id_str, line_at_token_start, col_at_token_start);
                 return make_token(TOKEN_ID, id_str, line_at_token_start, col_at_token_start);
             }
@@ -709,5 +795,6 @@ Token* get_next_token(Lexer* lexer) {
         }
     }
     DEBUG_PRINTF("GET_NEXT_TOKEN_EOF: Line=%d, Col=%d", lexer->line, lexer->col);
+    if (token_start_pos) *token_start_pos = lexer->pos;
     return make_token(TOKEN_EOF, "", lexer->line, lexer->col);
 }
@@ -4,7 +4,10 @@
 #include "statement_parser.h"  // For interpret_statement
 #include "scope.h"             // For Scope operations
 #include "dictionary.h"        // For Dictionary operations
+#include "source_unit.h"       // For SourceUnit-backed module lexers
+#include "unit_cache.h"        // For unit_cache_store
 #include "modules/weaver.h"    // For create_weaver_module
+#include "modules/numeric.h"   // For create_numeric_module
 #include <limits.h>            // For PATH_MAX (may need to include unistd.h for realpath on POSIX)
 #include <errno.h>
 #ifndef _WIN32
@@ -28,7 +31,7 @@ Value get_or_create_builtin_module(Interpreter* interpreter, const char* module_
     snprintf(cache_key, sizeof(cache_key), "__builtin__:%s", module_name);
 
     if (dictionary_try_get(interpreter->module_cache, cache_key, &cached_val, true)) {
-        return cached_val;
+        return cached_val; // A new reference to the shared namespace
     }
 
     Value module_val;
@@ -37,6 +40,9 @@ Value get_or_create_builtin_module(Interpreter* interpreter, const char* module_
     if (strcmp(module_name, "weaver") == 0) {
         module_val = create_weaver_module(interpreter);
         found = true;
+    } else if (strcmp(module_name, "numeric") == 0) {
+        module_val = create_numeric_module(interpreter);
+        found = true;
     }
     // Add other built-in modules here with `else if`
 
@@ -45,18 +51,15 @@ Value get_or_create_builtin_module(Interpreter* interpreter, const char* module_
         report_error("Internal", "Attempted to load unknown built-in module.", error_token);
     }
 
-    // Cache the newly created module
+    // The cache takes its own reference to the namespace; ours goes to the caller.
     dictionary_set(interpreter->module_cache, cache_key, module_val, error_token);
-
-    // Return a deep copy for the caller to use, for consistency with file-based modules.
-    Value return_val = value_deep_copy(module_val);
-    free_value_contents(module_val); // Free the original created module, as it's now copied in the cache and for the return value.
-    return return_val;
+    return module_val;
 }
 
 void initialize_module_system(Interpreter* interpreter) {
     interpreter->module_cache = dictionary_create(16, NULL); // Initial size, error token not critical here
     interpreter->active_module_scopes_head = NULL;
+    interpreter->loaded_units_head = NULL;
 }
 
 void cleanup_module_system(Interpreter* interpreter) {
@@ -81,6 +84,13 @@ void cleanup_module_system(Interpreter* interpreter) {
         free(current_node);
         current_node = next_node;
     }
+    interpreter->active_module_scopes_head = NULL;
+    // Release module source units last: tokens handed out by their cursors are borrowed.
+    while (interpreter->loaded_units_head) {
+        SourceUnit* unit = interpreter->loaded_units_head;
+        interpreter->loaded_units_head = unit->next_loaded;
+        source_unit_decref(unit);
+    }
 }
 
 static char* get_echoc_executable_directory() {
@@ -267,18 +277,18 @@ char* resolve_module_path(Interpreter* interpreter, const char* module_name_or_p
 
 Value load_module_from_path(Interpreter* interpreter, const char* absolute_module_path, Token* error_token) {
     Value cached_val;
-    if (dictionary_try_get(interpreter->module_cache, absolute_module_path, &cached_val, true /*DEEP_COPY_CONTENTS for cached module*/)) {
-        // cached_val is already a deep copy from dictionary_try_get
+    if (dictionary_try_get(interpreter->module_cache, absolute_module_path, &cached_val, true)) {
+        // Copying a VAL_DICT only takes a reference, so every importer shares the one namespace.
         // Check for placeholder indicating circular dependency
         if (cached_val.type == VAL_NULL) { // Using VAL_NULL as placeholder
             // This means we are in a circular import situation. Return the placeholder.
             // The caller (likely another module's execution) will get this VAL_NULL.
             // When the original execution of this module finishes, the placeholder will be replaced.
             DEBUG_PRINTF("Circular dependency detected for module: %s. Returning placeholder.", absolute_module_path);
-            return cached_val; // Return the deep copied placeholder
+            return cached_val; // Return the placeholder
         }
-        DEBUG_PRINTF("Module %s found in cache. Returning (deep copy).", absolute_module_path);
-        return cached_val; // Return the deep copied module
+        DEBUG_PRINTF("Module %s found in cache. Returning shared namespace.", absolute_module_path);
+        return cached_val;
     }
 
     // Not in cache. Put placeholder.
@@ -289,54 +299,19 @@ Value load_module_from_path(Interpreter* interpreter, const char* absolute_modul
     Value module_exports_dict = execute_module_file_and_get_exports(interpreter, absolute_module_path, error_token);
     // If execute_module_file_and_get_exports fails, it calls report_error and exits.
 
-    // Replace placeholder with actual module exports
+    // Replace placeholder with actual module exports. The cache takes its own reference; ours goes to the caller.
     dictionary_set(interpreter->module_cache, absolute_module_path, module_exports_dict, error_token);
-    
-    Value return_val = value_deep_copy(module_exports_dict);
-    free_value_contents(module_exports_dict); // Free the local one as it's copied for return and cache.
-    return return_val;
+    return module_exports_dict;
 }
 
 static Value execute_module_file_and_get_exports(Interpreter* interpreter, const char* absolute_module_path, Token* error_token) {
-    FILE* file = fopen(absolute_module_path, "rb");
-    if (!file) {
-        char err_msg[PATH_MAX + 100];
-        snprintf(err_msg, sizeof(err_msg), "Could not open module file '%s'. Error: %s", absolute_module_path, strerror(errno));
-        report_error("Runtime", err_msg, error_token);
-    }
-
-    fseek(file, 0, SEEK_END);
-    long fsize = ftell(file);
-    // Check for ftell errors or excessively large files
-    if (fsize == -1L) {
-        char err_msg[PATH_MAX + 200];
-        snprintf(err_msg, sizeof(err_msg), "Error determining size of module file '%s': %s", absolute_module_path, strerror(errno));
-        fclose(file);
-        report_error("System", err_msg, error_token);
-    }
-    if (fsize < 0) { // Should be caught by -1L, but as a safeguard
-        char err_msg[PATH_MAX + 100];
-        snprintf(err_msg, sizeof(err_msg), "Module file '%s' reported an invalid negative size: %ld.", absolute_module_path, fsize);
-        fclose(file);
-        report_error("System", err_msg, error_token);
-    }
-    if (fsize == LONG_MAX || (unsigned long)fsize >= SIZE_MAX -1 ) { // Check for potential overflow with +1 or if fsize itself is too large
-        char err_msg[PATH_MAX + 100];
-        snprintf(err_msg, sizeof(err_msg), "Module file '%s' is too large to load (%ld bytes).", absolute_module_path, fsize);
-        fclose(file);
-        report_error("System", err_msg, error_token);
-    }
-
-    fseek(file, 0, SEEK_SET); // Rewind to the beginning of the file
-    char* source_code = malloc((size_t)fsize + 1); // Allocate memory for the source code
-    if (!source_code) { fclose(file); report_error("System", "Failed to allocate memory for module source.", error_token); } // Check allocation
-    fread(source_code, 1, fsize, file);
-    fclose(file);
-    source_code[fsize] = 0;
-
-    Lexer module_lexer = { source_code, 0, source_code[0], 1, 1, (size_t)fsize };
-    Scope* module_scope = malloc(sizeof(Scope));
-    if (!module_scope) { free(source_code); report_error("System", "Failed to allocate scope for module.", error_token); }
+    char load_error[PATH_MAX + 200];
+    SourceUnit* module_unit = source_unit_load_file(absolute_module_path, load_error, sizeof(load_error));
+    if (!module_unit) report_error("Runtime", load_error, error_token);
+    Lexer module_lexer;
+    source_unit_init_lexer(module_unit, &module_lexer);
+    Scope* module_scope = calloc(1, sizeof(Scope));
+    if (!module_scope) { source_unit_decref(module_unit); report_error("System", "Failed to allocate scope for module.", error_token); }
     module_scope->symbols = NULL;
     module_scope->id = next_scope_id++;
     module_scope->outer = NULL; // Modules have their own independent global scope.
@@ -370,6 +345,8 @@ static Value execute_module_file_and_get_exports(Interpreter* interpreter, const
         if (interpreter->exception_is_active) break; // Propagate exception from module
     }
 
+    unit_cache_store(module_unit); // Tokens plus the frames its definitions resolved
+
     Value exports_dict_val;
     exports_dict_val.type = VAL_DICT;
     exports_dict_val.as.dict_val = dictionary_create(16, error_token);
@@ -396,7 +373,10 @@ static Value execute_module_file_and_get_exports(Interpreter* interpreter, const
 
     // DO NOT free module_scope here. It's now managed by active_module_scopes_head
     // and will be freed during cleanup_module_system.
-    free(source_code); // Free the module's source code string
+    // Tokens the module's cursor handed out are borrowed from its unit (and may still be
+    // referenced, e.g. by interpreter->error_token), so the unit lives until cleanup.
+    module_unit->next_loaded = interpreter->loaded_units_head;
+    interpreter->loaded_units_head = module_unit;
 
     if (interpreter->exception_is_active) { // If module execution had an unhandled exception
         free_value_contents(exports_dict_val); // Free the partially formed/empty exports dict
@@ -18,7 +18,9 @@ char* resolve_module_path(Interpreter* interpreter, const char* module_name_or_p
 // Loads a module by its absolute path.
 // If already in cache, returns the cached module namespace (a VAL_DICT).
 // Otherwise, executes the module, caches it, and returns its namespace.
-// The returned Value is owned by the cache or is a fresh VAL_DICT.
+// A module is executed once and its namespace dict is shared by every importer:
+// the returned Value is a new reference to it (release with free_value_contents),
+// so importing costs the same however much data the module holds.
 Value load_module_from_path(Interpreter* interpreter, const char* absolute_module_path, Token* error_token);
 Value get_or_create_builtin_module(Interpreter* interpreter, const char* module_name, Token* error_token);
 
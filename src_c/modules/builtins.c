@@ -3,6 +3,7 @@
 #include "value_utils.h" // For coroutine_decref_and_free_if_zero
 #include "dictionary.h"
 #include "scope.h"
+#include "string_value.h" // For string_value_create, string_value_length
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -109,7 +110,7 @@ Value builtin_slice(Interpreter* interpreter, Value* args, int arg_count, Token*
     }
 
     const char* original_str = subject.as.string_val;
-    long original_len = (long)strlen(original_str); // Use long for consistency with indices
+    long original_len = (long)string_value_length(original_str); // Use long for consistency with indices
     long start_idx = start_val.as.integer;
     long end_idx;
 
@@ -142,19 +143,9 @@ Value builtin_slice(Interpreter* interpreter, Value* args, int arg_count, Token*
 
     if (start_idx >= end_idx || start_idx >= original_len) {
         // If start is after end, or start is at/beyond string length, result is empty string
-        result_val.as.string_val = strdup("");
-        if (!result_val.as.string_val) {
-            report_error("System", "Failed to allocate memory for empty slice result.", call_site_token);
-        }
+        result_val.as.string_val = string_value_char('\0');
     } else {
-        long slice_len = end_idx - start_idx;
-        char* sliced_str = malloc(slice_len + 1);
-        if (!sliced_str) {
-            report_error("System", "Failed to allocate memory for slice result.", call_site_token);
-        }
-        strncpy(sliced_str, original_str + start_idx, slice_len);
-        sliced_str[slice_len] = '\0';
-        result_val.as.string_val = sliced_str;
+        result_val.as.string_val = string_value_create_n(original_str + start_idx, (size_t)(end_idx - start_idx));
     }
 
     return result_val;
@@ -173,7 +164,7 @@ Value builtin_len(Interpreter* interpreter, Value* args, int arg_count, Token* c
     result.type = VAL_INT;
     switch (subject.type) {
         case VAL_STRING:
-            result.as.integer = (long)strlen(subject.as.string_val);
+            result.as.integer = (long)string_value_length(subject.as.string_val);
             break;
         case VAL_ARRAY:
             result.as.integer = (long)subject.as.array_val->count;
@@ -184,6 +175,12 @@ Value builtin_len(Interpreter* interpreter, Value* args, int arg_count, Token* c
         case VAL_DICT:
             result.as.integer = (long)subject.as.dict_val->count;
             break;
+        case VAL_PACKED_ARRAY:
+            result.as.integer = (long)subject.as.packed_array_val->count;
+            break;
+        case VAL_RANGE:
+            result.as.integer = range_length(subject.as.range_val);
+            break;
         default: {
             char err_msg[200];
             snprintf(err_msg, sizeof(err_msg), "len() unsupported for type (%d).", subject.type);
@@ -210,6 +207,14 @@ Value builtin_append(Interpreter* interpreter, Value* args, int arg_count, Token
     }
     
     Array* arr = self.as.array_val;
+    // The caller un-shared the array before evaluating the argument (see the '.append'
+    // binding). If the array is shared again now, the argument took a reference to it
+    // (e.g. 'a.append(a)'), so store a copy that cannot point back into the array.
+    Value element = value_deep_copy(args[1]);
+    if (arr->ref_count > 1) {
+        free_value_contents(element);
+        element = value_unshared_copy(args[1]);
+    }
     // Grow array if needed
     if (arr->count >= arr->capacity) {
         arr->capacity = (arr->capacity == 0 ? 8 : arr->capacity * 2);
@@ -219,8 +224,7 @@ Value builtin_append(Interpreter* interpreter, Value* args, int arg_count, Token
         }
         arr->elements = new_elements;
     }
-    // Append a deep copy of the element to insert
-    arr->elements[arr->count] = value_deep_copy(args[1]);
+    arr->elements[arr->count] = element;
     arr->count++;
     
     // append modifies in-place and returns null (like Python's list.append)
@@ -248,6 +252,8 @@ Value builtin_type(Interpreter* interpreter, Value* args, int arg_count, Token*
         case VAL_ARRAY:         type_str = "array"; break;
         case VAL_TUPLE:         type_str = "tuple"; break;
         case VAL_DICT:          type_str = "dictionary"; break;
+        case VAL_PACKED_ARRAY:  type_str = "numeric_array"; break;
+        case VAL_RANGE:         type_str = "range"; break;
         case VAL_FUNCTION:      type_str = "function"; break;
         case VAL_BLUEPRINT:     type_str = "blueprint"; break;
         case VAL_OBJECT:        type_str = "object"; break;
@@ -264,10 +270,42 @@ Value builtin_type(Interpreter* interpreter, Value* args, int arg_count, Token*
             break;
         }
     }
-    result_val.as.string_val = strdup(type_str);
+    result_val.as.string_val = string_value_create(type_str);
     if (!result_val.as.string_val) {
         report_error("System", "Failed to allocate memory for type string result.", call_site_token);
     }
     return result_val;
 }
 
+// range(stop), range(start, stop) or range(start, stop, step): a lazy sequence of integers
+// ending before 'stop'. Nothing is materialized; 'for...in' counts through it natively.
+Value builtin_range(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter; // Interpreter context not needed here
+    if (arg_count < 1 || arg_count > 3) {
+        char err_msg[100];
+        snprintf(err_msg, sizeof(err_msg), "range() takes 1 to 3 arguments, but %d were given.", arg_count);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    for (int i = 0; i < arg_count; ++i) {
+        if (args[i].type != VAL_INT) {
+            report_error("Runtime", "range() arguments must be integers.", call_site_token);
+        }
+    }
+    Range* range = malloc(sizeof(Range));
+    if (!range) {
+        report_error("System", "Failed to allocate memory for range.", call_site_token);
+    }
+    range->start = arg_count == 1 ? 0 : args[0].as.integer;
+    range->stop = arg_count == 1 ? args[0].as.integer : args[1].as.integer;
+    range->step = arg_count == 3 ? args[2].as.integer : 1;
+    range->ref_count = 1;
+    if (range->step == 0) {
+        free(range);
+        report_error("Runtime", "range() step must not be zero.", call_site_token);
+    }
+
+    Value result_val;
+    result_val.type = VAL_RANGE;
+    result_val.as.range_val = range;
+    return result_val;
+}
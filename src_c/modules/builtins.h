@@ -19,6 +19,9 @@ Value builtin_append(Interpreter* interpreter, Value* args, int arg_count, Token
 // Built-in for type()
 Value builtin_type(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token);
 
+// Built-in for range()
+Value builtin_range(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token);
+
 // Add other built-in function declarations here as they are created
 // e.g. Value builtin_to_upper(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token);
 
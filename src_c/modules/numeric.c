@@ -0,0 +1,546 @@
+// src_c/modules/numeric.c
+#include "numeric.h"
+#include "../packed_array.h"
+#include "../value_utils.h"
+#include "../dictionary.h"
+#include "../intern.h"
+
+// --- Kernels ---
+// Each kernel walks its arrays NUMERIC_LANES elements at a time using GCC/Clang
+// vector extensions, which compile to SSE2 on any x86-64 and to NEON on ARM64.
+// On x86-64 Linux GCC additionally builds an AVX2 clone of every kernel and picks
+// it at load time when the CPU supports it. Other compilers get plain loops.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NUMERIC_LANES 4
+typedef double NumericF64Vec __attribute__((vector_size(NUMERIC_LANES * sizeof(double))));
+typedef int64_t NumericI64Vec __attribute__((vector_size(NUMERIC_LANES * sizeof(int64_t))));
+typedef uint64_t NumericU64Vec __attribute__((vector_size(NUMERIC_LANES * sizeof(uint64_t))));
+#else
+#define NUMERIC_LANES 1
+typedef double NumericF64Vec;
+typedef int64_t NumericI64Vec;
+typedef uint64_t NumericU64Vec;
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define NUMERIC_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define NUMERIC_KERNEL
+#endif
+
+// out[i] = a[i] OP b[i]; a NULL 'a' or 'b' stands for the scalar 's' (broadcast).
+// Integer kernels work on uint64_t so that overflow wraps instead of being undefined.
+#define NUMERIC_ARITH_KERNEL(NAME, T, VEC, OP)                                          \
+    static NUMERIC_KERNEL void NAME(T* out, const T* a, const T* b, T s, int n) {       \
+        int i = 0;                                                                      \
+        VEC va, vb, vr;                                                                 \
+        if (a && b) {                                                                   \
+            for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {                        \
+                memcpy(&va, a + i, sizeof va); memcpy(&vb, b + i, sizeof vb);           \
+                vr = va OP vb; memcpy(out + i, &vr, sizeof vr);                         \
+            }                                                                           \
+            for (; i < n; ++i) out[i] = a[i] OP b[i];                                   \
+        } else if (a) {                                                                 \
+            for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {                        \
+                memcpy(&va, a + i, sizeof va);                                          \
+                vr = va OP s; memcpy(out + i, &vr, sizeof vr);                          \
+            }                                                                           \
+            for (; i < n; ++i) out[i] = a[i] OP s;                                      \
+        } else {                                                                        \
+            for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {                        \
+                memcpy(&vb, b + i, sizeof vb);                                          \
+                vr = s OP vb; memcpy(out + i, &vr, sizeof vr);                          \
+            }                                                                           \
+            for (; i < n; ++i) out[i] = s OP b[i];                                      \
+        }                                                                               \
+    }
+
+// out[i] = (a[i] OP b[i]) as 1 or 0, with the same scalar convention.
+#define NUMERIC_COMPARE_KERNEL(NAME, T, VEC, OP)                                        \
+    static NUMERIC_KERNEL void NAME(int64_t* out, const T* a, const T* b, T s, int n) { \
+        int i = 0;                                                                      \
+        VEC va, vb;                                                                     \
+        NumericI64Vec vm;                                                               \
+        if (a && b) {                                                                   \
+            for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {                        \
+                memcpy(&va, a + i, sizeof va); memcpy(&vb, b + i, sizeof vb);           \
+                vm = (va OP vb) & 1; memcpy(out + i, &vm, sizeof vm);                   \
+            }                                                                           \
+            for (; i < n; ++i) out[i] = a[i] OP b[i];                                   \
+        } else if (a) {                                                                 \
+            for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {                        \
+                memcpy(&va, a + i, sizeof va);                                          \
+                vm = (va OP s) & 1; memcpy(out + i, &vm, sizeof vm);                    \
+            }                                                                           \
+            for (; i < n; ++i) out[i] = a[i] OP s;                                      \
+        } else {                                                                        \
+            for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {                        \
+                memcpy(&vb, b + i, sizeof vb);                                          \
+                vm = (s OP vb) & 1; memcpy(out + i, &vm, sizeof vm);                    \
+            }                                                                           \
+            for (; i < n; ++i) out[i] = s OP b[i];                                      \
+        }                                                                               \
+    }
+
+NUMERIC_ARITH_KERNEL(numeric_add_f64, double, NumericF64Vec, +)
+NUMERIC_ARITH_KERNEL(numeric_sub_f64, double, NumericF64Vec, -)
+NUMERIC_ARITH_KERNEL(numeric_mul_f64, double, NumericF64Vec, *)
+NUMERIC_ARITH_KERNEL(numeric_div_f64, double, NumericF64Vec, /)
+NUMERIC_ARITH_KERNEL(numeric_add_i64, uint64_t, NumericU64Vec, +)
+NUMERIC_ARITH_KERNEL(numeric_sub_i64, uint64_t, NumericU64Vec, -)
+NUMERIC_ARITH_KERNEL(numeric_mul_i64, uint64_t, NumericU64Vec, *)
+NUMERIC_COMPARE_KERNEL(numeric_lt_f64, double, NumericF64Vec, <)
+NUMERIC_COMPARE_KERNEL(numeric_gt_f64, double, NumericF64Vec, >)
+NUMERIC_COMPARE_KERNEL(numeric_eq_f64, double, NumericF64Vec, ==)
+NUMERIC_COMPARE_KERNEL(numeric_lt_i64, int64_t, NumericI64Vec, <)
+NUMERIC_COMPARE_KERNEL(numeric_gt_i64, int64_t, NumericI64Vec, >)
+NUMERIC_COMPARE_KERNEL(numeric_eq_i64, int64_t, NumericI64Vec, ==)
+
+// Lane-wise partial sums, added up at the end. The summation order is fixed, so
+// results do not depend on which kernel clone runs.
+static NUMERIC_KERNEL double numeric_sum_f64(const double* a, int n) {
+    NumericF64Vec acc = {0}, va;
+    int i = 0;
+    for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {
+        memcpy(&va, a + i, sizeof va);
+        acc += va;
+    }
+    double lanes[NUMERIC_LANES];
+    memcpy(lanes, &acc, sizeof lanes);
+    double total = 0.0;
+    for (int lane = 0; lane < NUMERIC_LANES; ++lane) total += lanes[lane];
+    for (; i < n; ++i) total += a[i];
+    return total;
+}
+
+static NUMERIC_KERNEL uint64_t numeric_sum_i64(const uint64_t* a, int n) {
+    NumericU64Vec acc = {0}, va;
+    int i = 0;
+    for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {
+        memcpy(&va, a + i, sizeof va);
+        acc += va;
+    }
+    uint64_t lanes[NUMERIC_LANES];
+    memcpy(lanes, &acc, sizeof lanes);
+    uint64_t total = 0;
+    for (int lane = 0; lane < NUMERIC_LANES; ++lane) total += lanes[lane];
+    for (; i < n; ++i) total += a[i];
+    return total;
+}
+
+static NUMERIC_KERNEL double numeric_dot_f64(const double* a, const double* b, int n) {
+    NumericF64Vec acc = {0}, va, vb;
+    int i = 0;
+    for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {
+        memcpy(&va, a + i, sizeof va); memcpy(&vb, b + i, sizeof vb);
+        acc += va * vb;
+    }
+    double lanes[NUMERIC_LANES];
+    memcpy(lanes, &acc, sizeof lanes);
+    double total = 0.0;
+    for (int lane = 0; lane < NUMERIC_LANES; ++lane) total += lanes[lane];
+    for (; i < n; ++i) total += a[i] * b[i];
+    return total;
+}
+
+static NUMERIC_KERNEL uint64_t numeric_dot_i64(const uint64_t* a, const uint64_t* b, int n) {
+    NumericU64Vec acc = {0}, va, vb;
+    int i = 0;
+    for (; i + NUMERIC_LANES <= n; i += NUMERIC_LANES) {
+        memcpy(&va, a + i, sizeof va); memcpy(&vb, b + i, sizeof vb);
+        acc += va * vb;
+    }
+    uint64_t lanes[NUMERIC_LANES];
+    memcpy(lanes, &acc, sizeof lanes);
+    uint64_t total = 0;
+    for (int lane = 0; lane < NUMERIC_LANES; ++lane) total += lanes[lane];
+    for (; i < n; ++i) total += a[i] * b[i];
+    return total;
+}
+
+// Minimum (want_max false) or maximum of n >= 1 elements. Written as plain
+// compare-and-select loops, which the compiler turns into minpd/maxpd.
+static NUMERIC_KERNEL double numeric_extreme_f64(const double* a, int n, bool want_max) {
+    double best = a[0];
+    if (want_max) {
+        for (int i = 1; i < n; ++i) best = a[i] > best ? a[i] : best;
+    } else {
+        for (int i = 1; i < n; ++i) best = a[i] < best ? a[i] : best;
+    }
+    return best;
+}
+
+static NUMERIC_KERNEL int64_t numeric_extreme_i64(const int64_t* a, int n, bool want_max) {
+    int64_t best = a[0];
+    if (want_max) {
+        for (int i = 1; i < n; ++i) best = a[i] > best ? a[i] : best;
+    } else {
+        for (int i = 1; i < n; ++i) best = a[i] < best ? a[i] : best;
+    }
+    return best;
+}
+
+// --- Argument helpers ---
+
+typedef enum { NUMERIC_ADD, NUMERIC_SUB, NUMERIC_MUL, NUMERIC_DIV, NUMERIC_LT, NUMERIC_GT, NUMERIC_EQ } NumericOp;
+
+// Helper to create a VAL_FUNCTION wrapper for a C function
+static Value create_c_function_value(CBuiltinFunction func_ptr, const char* name, int param_count) {
+    Function* c_func_wrapper = calloc(1, sizeof(Function));
+    if (!c_func_wrapper) {
+        report_error("System", "Failed to allocate memory for C function wrapper.", NULL);
+    }
+    c_func_wrapper->name = intern_acquire(name);
+    c_func_wrapper->param_count = param_count; // Use -1 for varargs, or a specific number for arity checks
+    c_func_wrapper->is_async = false;
+    c_func_wrapper->c_impl = func_ptr;
+
+    Value val;
+    val.type = VAL_FUNCTION;
+    val.as.function_val = c_func_wrapper;
+    return val;
+}
+
+static Value numeric_packed_value(PackedArray* arr) {
+    Value val;
+    val.type = VAL_PACKED_ARRAY;
+    val.as.packed_array_val = arr;
+    return val;
+}
+
+static bool numeric_is_number(Value val) {
+    return val.type == VAL_INT || val.type == VAL_FLOAT;
+}
+
+static void numeric_expect_args(int arg_count, int expected, const char* usage, Token* call_site_token) {
+    if (arg_count != expected) {
+        char err_msg[200];
+        snprintf(err_msg, sizeof(err_msg), "numeric.%s expects %d argument(s), but %d were given.", usage, expected, arg_count);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+}
+
+static PackedArray* numeric_expect_packed(Value val, const char* func_name, Token* call_site_token) {
+    if (val.type != VAL_PACKED_ARRAY) {
+        char err_msg[200];
+        snprintf(err_msg, sizeof(err_msg), "numeric.%s() expects a numeric array (see numeric.pack).", func_name);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    return val.as.packed_array_val;
+}
+
+static int numeric_expect_length(Value val, const char* func_name, Token* call_site_token) {
+    if (val.type != VAL_INT || val.as.integer < 0 || val.as.integer > INT32_MAX) {
+        char err_msg[200];
+        snprintf(err_msg, sizeof(err_msg), "numeric.%s() expects a non-negative integer length.", func_name);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    return (int)val.as.integer;
+}
+
+// The operand's elements as doubles: its own storage, or a converted copy in '*scratch'.
+static const double* numeric_as_floats(const PackedArray* arr, double** scratch) {
+    if (arr->kind == PACKED_FLOAT) return arr->data.floats;
+    *scratch = malloc((arr->count > 0 ? (size_t)arr->count : 1) * sizeof(double));
+    if (!*scratch) report_error("System", "Failed to allocate memory for numeric conversion.", NULL);
+    for (int i = 0; i < arr->count; ++i) (*scratch)[i] = (double)arr->data.ints[i];
+    return *scratch;
+}
+
+// Index of the first element equal to 0, or -1.
+static int numeric_first_zero(const PackedArray* arr) {
+    for (int i = 0; i < arr->count; ++i) {
+        if (arr->kind == PACKED_INT ? arr->data.ints[i] == 0 : arr->data.floats[i] == 0.0) return i;
+    }
+    return -1;
+}
+
+// Element-wise 'a OP b' where either side (not both) may be a scalar. Comparisons give
+// 1/0 int arrays rather than bools: packed arrays only hold numbers, and an int mask
+// stays packed, so numeric.sum counts the matches and numeric.mul selects with it.
+static Value numeric_binary(Value* args, int arg_count, NumericOp op, const char* func_name, Token* call_site_token) {
+    if (arg_count != 2) numeric_expect_args(arg_count, 2, func_name, call_site_token);
+    Value lhs = args[0], rhs = args[1];
+    bool lhs_packed = lhs.type == VAL_PACKED_ARRAY, rhs_packed = rhs.type == VAL_PACKED_ARRAY;
+    if ((!lhs_packed && !numeric_is_number(lhs)) || (!rhs_packed && !numeric_is_number(rhs)) || (!lhs_packed && !rhs_packed)) {
+        char err_msg[200];
+        snprintf(err_msg, sizeof(err_msg), "numeric.%s() expects two numeric arrays, or a numeric array and a number.", func_name);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    const PackedArray* a = lhs_packed ? lhs.as.packed_array_val : NULL;
+    const PackedArray* b = rhs_packed ? rhs.as.packed_array_val : NULL;
+    if (a && b && a->count != b->count) {
+        char err_msg[200];
+        snprintf(err_msg, sizeof(err_msg), "numeric.%s() arrays differ in length (%d and %d).", func_name, a->count, b->count);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    int n = a ? a->count : b->count;
+    const Value scalar = a ? rhs : lhs; // Only meaningful when one side is not an array
+    if (op == NUMERIC_DIV && (b ? numeric_first_zero(b) >= 0 : (rhs.type == VAL_INT ? rhs.as.integer == 0 : rhs.as.floating == 0))) {
+        report_error("Runtime", "Division by zero", call_site_token); // As for '/'
+    }
+
+    bool floating = op == NUMERIC_DIV ||
+                    (a ? a->kind == PACKED_FLOAT : scalar.type == VAL_FLOAT) ||
+                    (b ? b->kind == PACKED_FLOAT : scalar.type == VAL_FLOAT);
+    bool compare = op == NUMERIC_LT || op == NUMERIC_GT || op == NUMERIC_EQ;
+    PackedArray* result = packed_array_create(compare || !floating ? PACKED_INT : PACKED_FLOAT, n);
+
+    if (floating) {
+        double* a_scratch = NULL;
+        double* b_scratch = NULL;
+        const double* av = a ? numeric_as_floats(a, &a_scratch) : NULL;
+        const double* bv = b ? numeric_as_floats(b, &b_scratch) : NULL;
+        double s = (a && b) ? 0.0 : (scalar.type == VAL_INT ? (double)scalar.as.integer : scalar.as.floating);
+        switch (op) {
+            case NUMERIC_ADD: numeric_add_f64(result->data.floats, av, bv, s, n); break;
+            case NUMERIC_SUB: numeric_sub_f64(result->data.floats, av, bv, s, n); break;
+            case NUMERIC_MUL: numeric_mul_f64(result->data.floats, av, bv, s, n); break;
+            case NUMERIC_DIV: numeric_div_f64(result->data.floats, av, bv, s, n); break;
+            case NUMERIC_LT:  numeric_lt_f64(result->data.ints, av, bv, s, n); break;
+            case NUMERIC_GT:  numeric_gt_f64(result->data.ints, av, bv, s, n); break;
+            case NUMERIC_EQ:  numeric_eq_f64(result->data.ints, av, bv, s, n); break;
+        }
+        free(a_scratch);
+        free(b_scratch);
+    } else {
+        const int64_t* av = a ? a->data.ints : NULL;
+        const int64_t* bv = b ? b->data.ints : NULL;
+        int64_t s = (a && b) ? 0 : (int64_t)scalar.as.integer;
+        uint64_t* out = (uint64_t*)result->data.ints;
+        switch (op) {
+            case NUMERIC_ADD: numeric_add_i64(out, (const uint64_t*)av, (const uint64_t*)bv, (uint64_t)s, n); break;
+            case NUMERIC_SUB: numeric_sub_i64(out, (const uint64_t*)av, (const uint64_t*)bv, (uint64_t)s, n); break;
+            case NUMERIC_MUL: numeric_mul_i64(out, (const uint64_t*)av, (const uint64_t*)bv, (uint64_t)s, n); break;
+            case NUMERIC_LT:  numeric_lt_i64(result->data.ints, av, bv, s, n); break;
+            case NUMERIC_GT:  numeric_gt_i64(result->data.ints, av, bv, s, n); break;
+            case NUMERIC_EQ:  numeric_eq_i64(result->data.ints, av, bv, s, n); break;
+            case NUMERIC_DIV: break; // Always floating
+        }
+    }
+    return numeric_packed_value(result);
+}
+
+// --- Implementations ---
+
+// numeric.pack(array_or_tuple): ints stay ints; any float makes every element a float.
+static Value numeric_pack(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 1, "pack(values)", call_site_token);
+    if (args[0].type == VAL_PACKED_ARRAY) return value_deep_copy(args[0]);
+
+    Value* elements = NULL;
+    int count = 0;
+    if (args[0].type == VAL_ARRAY) {
+        elements = args[0].as.array_val->elements;
+        count = args[0].as.array_val->count;
+    } else if (args[0].type == VAL_TUPLE) {
+        elements = args[0].as.tuple_val->elements;
+        count = args[0].as.tuple_val->count;
+    } else {
+        report_error("Runtime", "numeric.pack() expects an array or tuple of numbers.", call_site_token);
+    }
+
+    PackedKind kind = PACKED_INT;
+    for (int i = 0; i < count; ++i) {
+        if (elements[i].type == VAL_FLOAT) {
+            kind = PACKED_FLOAT;
+        } else if (elements[i].type != VAL_INT) {
+            char err_msg[200];
+            snprintf(err_msg, sizeof(err_msg), "numeric.pack() element %d is not a number.", i);
+            report_error("Runtime", err_msg, call_site_token);
+        }
+    }
+    PackedArray* arr = packed_array_create(kind, count);
+    for (int i = 0; i < count; ++i) {
+        packed_array_set(arr, i, elements[i]);
+    }
+    return numeric_packed_value(arr);
+}
+
+// numeric.zeros(n): n float zeros.
+static Value numeric_zeros(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 1, "zeros(n)", call_site_token);
+    int n = numeric_expect_length(args[0], "zeros", call_site_token);
+    PackedArray* arr = packed_array_create(PACKED_FLOAT, n);
+    for (int i = 0; i < n; ++i) arr->data.floats[i] = 0.0;
+    return numeric_packed_value(arr);
+}
+
+// numeric.fill(n, value): n copies of an int or float.
+static Value numeric_fill(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 2, "fill(n, value)", call_site_token);
+    int n = numeric_expect_length(args[0], "fill", call_site_token);
+    if (!numeric_is_number(args[1])) report_error("Runtime", "numeric.fill() value must be an integer or a float.", call_site_token);
+    PackedArray* arr = packed_array_create(args[1].type == VAL_INT ? PACKED_INT : PACKED_FLOAT, n);
+    for (int i = 0; i < n; ++i) packed_array_set(arr, i, args[1]);
+    return numeric_packed_value(arr);
+}
+
+// numeric.arange(n): the ints 0 .. n-1.
+static Value numeric_arange(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 1, "arange(n)", call_site_token);
+    int n = numeric_expect_length(args[0], "arange", call_site_token);
+    PackedArray* arr = packed_array_create(PACKED_INT, n);
+    for (int i = 0; i < n; ++i) arr->data.ints[i] = i;
+    return numeric_packed_value(arr);
+}
+
+// numeric.to_array(packed): a regular array with the same numbers.
+static Value numeric_to_array(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 1, "to_array(values)", call_site_token);
+    PackedArray* arr = numeric_expect_packed(args[0], "to_array", call_site_token);
+    Value result;
+    result.type = VAL_ARRAY;
+    result.as.array_val = packed_array_to_array(arr);
+    return result;
+}
+
+static Value numeric_add(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_ADD, "add", call_site_token);
+}
+
+static Value numeric_sub(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_SUB, "sub", call_site_token);
+}
+
+static Value numeric_mul(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_MUL, "mul", call_site_token);
+}
+
+static Value numeric_div(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_DIV, "div", call_site_token);
+}
+
+static Value numeric_lt(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_LT, "lt", call_site_token);
+}
+
+static Value numeric_gt(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_GT, "gt", call_site_token);
+}
+
+static Value numeric_eq(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_binary(args, arg_count, NUMERIC_EQ, "eq", call_site_token);
+}
+
+// numeric.sum(values): an int for int arrays, a float otherwise; 0 when empty.
+static Value numeric_sum(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 1, "sum(values)", call_site_token);
+    PackedArray* arr = numeric_expect_packed(args[0], "sum", call_site_token);
+    Value result;
+    if (arr->kind == PACKED_INT) {
+        result.type = VAL_INT;
+        result.as.integer = (long)(int64_t)numeric_sum_i64((const uint64_t*)arr->data.ints, arr->count);
+    } else {
+        result.type = VAL_FLOAT;
+        result.as.floating = numeric_sum_f64(arr->data.floats, arr->count);
+    }
+    return result;
+}
+
+static Value numeric_extreme(Value* args, int arg_count, bool want_max, Token* call_site_token) {
+    const char* func_name = want_max ? "max" : "min";
+    numeric_expect_args(arg_count, 1, want_max ? "max(values)" : "min(values)", call_site_token);
+    PackedArray* arr = numeric_expect_packed(args[0], func_name, call_site_token);
+    if (arr->count == 0) {
+        char err_msg[100];
+        snprintf(err_msg, sizeof(err_msg), "numeric.%s() of an empty array.", func_name);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    Value result;
+    if (arr->kind == PACKED_INT) {
+        result.type = VAL_INT;
+        result.as.integer = (long)numeric_extreme_i64(arr->data.ints, arr->count, want_max);
+    } else {
+        result.type = VAL_FLOAT;
+        result.as.floating = numeric_extreme_f64(arr->data.floats, arr->count, want_max);
+    }
+    return result;
+}
+
+static Value numeric_min(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_extreme(args, arg_count, false, call_site_token);
+}
+
+static Value numeric_max(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return numeric_extreme(args, arg_count, true, call_site_token);
+}
+
+// numeric.dot(a, b): sum of the element-wise products of two equally long arrays.
+static Value numeric_dot(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    numeric_expect_args(arg_count, 2, "dot(a, b)", call_site_token);
+    PackedArray* a = numeric_expect_packed(args[0], "dot", call_site_token);
+    PackedArray* b = numeric_expect_packed(args[1], "dot", call_site_token);
+    if (a->count != b->count) {
+        char err_msg[200];
+        snprintf(err_msg, sizeof(err_msg), "numeric.dot() arrays differ in length (%d and %d).", a->count, b->count);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    Value result;
+    if (a->kind == PACKED_INT && b->kind == PACKED_INT) {
+        result.type = VAL_INT;
+        result.as.integer = (long)(int64_t)numeric_dot_i64((const uint64_t*)a->data.ints, (const uint64_t*)b->data.ints, a->count);
+        return result;
+    }
+    double* a_scratch = NULL;
+    double* b_scratch = NULL;
+    result.type = VAL_FLOAT;
+    result.as.floating = numeric_dot_f64(numeric_as_floats(a, &a_scratch), numeric_as_floats(b, &b_scratch), a->count);
+    free(a_scratch);
+    free(b_scratch);
+    return result;
+}
+
+// --- Module Creation ---
+Value create_numeric_module(Interpreter* interpreter) {
+    (void)interpreter;
+    Dictionary* numeric_module = dictionary_create(32, NULL);
+
+    // Helper macro to create, set, and free the temporary C function value
+    #define ADD_NUMERIC_FUNC(name, c_func, arity) do { \
+        Value temp_val = create_c_function_value(c_func, name, arity); \
+        dictionary_set(numeric_module, name, temp_val, NULL); \
+        free_value_contents(temp_val); \
+    } while (0)
+
+    ADD_NUMERIC_FUNC("pack", numeric_pack, 1);
+    ADD_NUMERIC_FUNC("zeros", numeric_zeros, 1);
+    ADD_NUMERIC_FUNC("fill", numeric_fill, 2);
+    ADD_NUMERIC_FUNC("arange", numeric_arange, 1);
+    ADD_NUMERIC_FUNC("to_array", numeric_to_array, 1);
+    ADD_NUMERIC_FUNC("add", numeric_add, 2);
+    ADD_NUMERIC_FUNC("sub", numeric_sub, 2);
+    ADD_NUMERIC_FUNC("mul", numeric_mul, 2);
+    ADD_NUMERIC_FUNC("div", numeric_div, 2);
+    ADD_NUMERIC_FUNC("lt", numeric_lt, 2);
+    ADD_NUMERIC_FUNC("gt", numeric_gt, 2);
+    ADD_NUMERIC_FUNC("eq", numeric_eq, 2);
+    ADD_NUMERIC_FUNC("sum", numeric_sum, 1);
+    ADD_NUMERIC_FUNC("min", numeric_min, 1);
+    ADD_NUMERIC_FUNC("max", numeric_max, 1);
+    ADD_NUMERIC_FUNC("dot", numeric_dot, 2);
+
+    #undef ADD_NUMERIC_FUNC
+
+    Value module_val;
+    module_val.type = VAL_DICT;
+    module_val.as.dict_val = numeric_module;
+    return module_val;
+}
@@ -0,0 +1,9 @@
+// src_c/modules/numeric.h
+#ifndef ECHOC_NUMERIC_MODULE_H
+#define ECHOC_NUMERIC_MODULE_H
+
+#include "../header.h"
+
+Value create_numeric_module(Interpreter* interpreter);
+
+#endif // ECHOC_NUMERIC_MODULE_H
@@ -0,0 +1,408 @@
+// src_c/modules/string_methods.c
+#include "string_methods.h"
+#include "../string_value.h" // For string_value_alloc, string_value_length, string_value_char
+#include "../value_utils.h"  // For value_concat_text
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+// --- Scanning ---
+// Substring searches let memchr find candidate positions for the needle's first byte
+// (libc tests 16 to 64 bytes per instruction there) and compare the rest only at those.
+// Case conversion works on STRING_LANES bytes at a time using GCC/Clang vector
+// extensions, like the numeric module's kernels. Every result string or array is
+// allocated once at its final size: methods that cut or rewrite a string count the
+// matches first.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STRING_LANES 16
+typedef unsigned char StringByteVec __attribute__((vector_size(STRING_LANES)));
+#endif
+
+#define STRING_WHITESPACE " \t\n\v\f\r"
+
+// Offset of the first 'needle' in 'text' at or after 'from', or -1.
+static long string_search(const char* text, size_t length, const char* needle, size_t needle_length, size_t from) {
+    if (from > length || needle_length > length - from) return -1;
+    if (needle_length == 0) return (long)from;
+    const char* cursor = text + from;
+    const char* last = text + length - needle_length; // Last position a match can start at
+    while (cursor <= last) {
+        cursor = memchr(cursor, (unsigned char)needle[0], (size_t)(last - cursor) + 1);
+        if (!cursor) return -1;
+        if (memcmp(cursor + 1, needle + 1, needle_length - 1) == 0) return (long)(cursor - text);
+        cursor++;
+    }
+    return -1;
+}
+
+// Non-overlapping occurrences of a non-empty 'needle', counting at most 'limit' (-1: all).
+static long string_count_matches(const char* text, size_t length, const char* needle, size_t needle_length, long limit) {
+    long matches = 0;
+    size_t from = 0;
+    long at;
+    while ((limit < 0 || matches < limit) && (at = string_search(text, length, needle, needle_length, from)) >= 0) {
+        matches++;
+        from = (size_t)at + needle_length;
+    }
+    return matches;
+}
+
+// out[i] = in[i] with the case of the ASCII letters in [lo, hi] flipped.
+static void string_flip_case(char* out, const char* in, size_t length, unsigned char lo, unsigned char hi) {
+    size_t i = 0;
+#ifdef STRING_LANES
+    for (; i + STRING_LANES <= length; i += STRING_LANES) {
+        StringByteVec v;
+        memcpy(&v, in + i, sizeof v);
+        StringByteVec in_range = (StringByteVec)((v >= lo) & (v <= hi));
+        v ^= in_range & 0x20;
+        memcpy(out + i, &v, sizeof v);
+    }
+#endif
+    for (; i < length; ++i) {
+        unsigned char c = (unsigned char)in[i];
+        out[i] = (char)(c >= lo && c <= hi ? c ^ 0x20 : c);
+    }
+}
+
+// --- Argument and Result Helpers ---
+// 'arg_count' includes the string itself in args[0].
+static void string_method_check_arity(const char* method, int arg_count, int min_args, int max_args, Token* call_site_token) {
+    int given = arg_count - 1;
+    if (given < min_args || given > max_args) {
+        char err_msg[120];
+        if (min_args == max_args)
+            snprintf(err_msg, sizeof(err_msg), "%s() expects %d argument(s), but %d were given.", method, min_args, given);
+        else
+            snprintf(err_msg, sizeof(err_msg), "%s() expects %d to %d arguments, but %d were given.", method, min_args, max_args, given);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+}
+
+static const char* string_method_text_arg(Value* args, int index, const char* method, size_t* length, Token* call_site_token) {
+    if (args[index].type != VAL_STRING) {
+        char err_msg[120];
+        snprintf(err_msg, sizeof(err_msg), "Argument %d to %s() must be a string.", index, method);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    *length = string_value_length(args[index].as.string_val);
+    return args[index].as.string_val;
+}
+
+static long string_method_int_arg(Value* args, int index, const char* method, Token* call_site_token) {
+    if (args[index].type != VAL_INT) {
+        char err_msg[120];
+        snprintf(err_msg, sizeof(err_msg), "Argument %d to %s() must be an integer.", index, method);
+        report_error("Runtime", err_msg, call_site_token);
+    }
+    return args[index].as.integer;
+}
+
+static Value string_method_string(char* string) {
+    Value result;
+    result.type = VAL_STRING;
+    result.as.string_val = string;
+    return result;
+}
+
+// A new string holding 'length' bytes of 'text'; empty and one-character pieces use the
+// preallocated strings.
+static Value string_method_piece(const char* text, size_t length) {
+    if (length <= 1) return string_method_string(string_value_char(length ? (unsigned char)text[0] : '\0'));
+    return string_method_string(string_value_create_n(text, length));
+}
+
+static Value string_method_int(long n) {
+    Value result;
+    result.type = VAL_INT;
+    result.as.integer = n;
+    return result;
+}
+
+static Value string_method_bool(bool b) {
+    Value result;
+    result.type = VAL_BOOL;
+    result.as.bool_val = b;
+    return result;
+}
+
+// An empty array with room for exactly 'capacity' elements.
+static Array* string_method_array(long capacity, Token* call_site_token) {
+    Array* array = malloc(sizeof(Array));
+    if (!array) report_error("System", "Failed to allocate memory for array struct", call_site_token);
+    array->count = 0;
+    array->capacity = capacity > 0 ? (int)capacity : 1;
+    array->ref_count = 1;
+    array->elements = malloc(array->capacity * sizeof(Value));
+    if (!array->elements) {
+        free(array);
+        report_error("System", "Failed to allocate memory for array elements", call_site_token);
+    }
+    return array;
+}
+
+static Value string_method_array_value(Array* array) {
+    Value result;
+    result.type = VAL_ARRAY;
+    result.as.array_val = array;
+    return result;
+}
+
+// --- Methods ---
+
+// s.find(sub, start=0): index of the first 'sub' at or after 'start', or -1.
+static Value string_find(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("find", arg_count, 1, 2, call_site_token);
+    const char* text = args[0].as.string_val;
+    size_t length = string_value_length(text);
+    size_t needle_length;
+    const char* needle = string_method_text_arg(args, 1, "find", &needle_length, call_site_token);
+    long start = arg_count > 2 ? string_method_int_arg(args, 2, "find", call_site_token) : 0;
+    if (start < 0) start += (long)length;
+    if (start < 0) start = 0;
+    if (start > (long)length) return string_method_int(-1);
+    return string_method_int(string_search(text, length, needle, needle_length, (size_t)start));
+}
+
+// s.count(sub): number of non-overlapping occurrences of 'sub'.
+static Value string_count(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("count", arg_count, 1, 1, call_site_token);
+    const char* text = args[0].as.string_val;
+    size_t length = string_value_length(text);
+    size_t needle_length;
+    const char* needle = string_method_text_arg(args, 1, "count", &needle_length, call_site_token);
+    if (needle_length == 0) return string_method_int((long)length + 1); // Every position matches
+    return string_method_int(string_count_matches(text, length, needle, needle_length, -1));
+}
+
+static Value string_startswith(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("startswith", arg_count, 1, 1, call_site_token);
+    size_t length = string_value_length(args[0].as.string_val);
+    size_t prefix_length;
+    const char* prefix = string_method_text_arg(args, 1, "startswith", &prefix_length, call_site_token);
+    return string_method_bool(prefix_length <= length && memcmp(args[0].as.string_val, prefix, prefix_length) == 0);
+}
+
+static Value string_endswith(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("endswith", arg_count, 1, 1, call_site_token);
+    size_t length = string_value_length(args[0].as.string_val);
+    size_t suffix_length;
+    const char* suffix = string_method_text_arg(args, 1, "endswith", &suffix_length, call_site_token);
+    return string_method_bool(suffix_length <= length &&
+                              memcmp(args[0].as.string_val + length - suffix_length, suffix, suffix_length) == 0);
+}
+
+// s.split() cuts at runs of whitespace and drops empty pieces.
+static Value string_split_whitespace(const char* text, size_t length, Token* call_site_token) {
+    long pieces = 0;
+    for (size_t i = 0; i < length; ) {
+        i += strspn(text + i, STRING_WHITESPACE);
+        if (i >= length) break;
+        pieces++;
+        i += strcspn(text + i, STRING_WHITESPACE);
+    }
+    Array* array = string_method_array(pieces, call_site_token);
+    for (size_t i = 0; array->count < pieces; ) {
+        i += strspn(text + i, STRING_WHITESPACE);
+        size_t piece_length = strcspn(text + i, STRING_WHITESPACE);
+        array->elements[array->count++] = string_method_piece(text + i, piece_length);
+        i += piece_length;
+    }
+    return string_method_array_value(array);
+}
+
+// s.split(sep, maxsplit=-1): the pieces between occurrences of 'sep', cutting at most
+// 'maxsplit' times. Empty pieces are kept, so "".split(",") is [""]. Without 'sep', see
+// string_split_whitespace.
+static Value string_split(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("split", arg_count, 0, 2, call_site_token);
+    const char* text = args[0].as.string_val;
+    size_t length = string_value_length(text);
+    if (arg_count == 1) return string_split_whitespace(text, length, call_site_token);
+
+    size_t sep_length;
+    const char* sep = string_method_text_arg(args, 1, "split", &sep_length, call_site_token);
+    if (sep_length == 0) report_error("Runtime", "split() separator must not be empty.", call_site_token);
+    long limit = arg_count > 2 ? string_method_int_arg(args, 2, "split", call_site_token) : -1;
+
+    long matches = string_count_matches(text, length, sep, sep_length, limit);
+    Array* array = string_method_array(matches + 1, call_site_token);
+    size_t from = 0;
+    for (long i = 0; i < matches; ++i) {
+        size_t at = (size_t)string_search(text, length, sep, sep_length, from);
+        array->elements[array->count++] = string_method_piece(text + from, at - from);
+        from = at + sep_length;
+    }
+    array->elements[array->count++] = string_method_piece(text + from, length - from);
+    return string_method_array_value(array);
+}
+
+// sep.join(items): the strings (or numbers and bools, formatted as '+' does) of an array
+// or tuple, with 'sep' between them.
+static Value string_join(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("join", arg_count, 1, 1, call_site_token);
+    const char* sep = args[0].as.string_val;
+    size_t sep_length = string_value_length(sep);
+
+    Value* items;
+    int count;
+    if (args[1].type == VAL_ARRAY) {
+        items = args[1].as.array_val->elements;
+        count = args[1].as.array_val->count;
+    } else if (args[1].type == VAL_TUPLE) {
+        items = args[1].as.tuple_val->elements;
+        count = args[1].as.tuple_val->count;
+    } else {
+        report_error("Runtime", "Argument to join() must be an array or tuple.", call_site_token);
+        return create_null_value();
+    }
+    if (count == 0) return string_method_string(string_value_char('\0'));
+
+    char buffer[64];
+    size_t part_length;
+    size_t total = sep_length * (size_t)(count - 1);
+    for (int i = 0; i < count; ++i) {
+        if (!value_concat_text(items[i], buffer, sizeof(buffer), &part_length)) {
+            char err_msg[120];
+            snprintf(err_msg, sizeof(err_msg), "join() items must be strings, numbers or bools (item %d is not).", i);
+            report_error("Runtime", err_msg, call_site_token);
+        }
+        total += part_length;
+    }
+
+    char* joined = string_value_alloc(total);
+    char* out = joined;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            memcpy(out, sep, sep_length);
+            out += sep_length;
+        }
+        const char* part = value_concat_text(items[i], buffer, sizeof(buffer), &part_length);
+        memcpy(out, part, part_length);
+        out += part_length;
+    }
+    return string_method_string(joined);
+}
+
+// s.replace(old, new, count=-1): 's' with the first 'count' occurrences of 'old' replaced.
+static Value string_replace(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("replace", arg_count, 2, 3, call_site_token);
+    const char* text = args[0].as.string_val;
+    size_t length = string_value_length(text);
+    size_t old_length, new_length;
+    const char* old_text = string_method_text_arg(args, 1, "replace", &old_length, call_site_token);
+    const char* new_text = string_method_text_arg(args, 2, "replace", &new_length, call_site_token);
+    if (old_length == 0) report_error("Runtime", "replace() argument 'old' must not be empty.", call_site_token);
+    long limit = arg_count > 3 ? string_method_int_arg(args, 3, "replace", call_site_token) : -1;
+
+    long matches = string_count_matches(text, length, old_text, old_length, limit);
+    if (matches == 0) return string_method_string(string_value_retain(args[0].as.string_val));
+
+    char* replaced = string_value_alloc(length - (size_t)matches * old_length + (size_t)matches * new_length);
+    char* out = replaced;
+    size_t from = 0;
+    for (long i = 0; i < matches; ++i) {
+        size_t at = (size_t)string_search(text, length, old_text, old_length, from);
+        memcpy(out, text + from, at - from);
+        out += at - from;
+        memcpy(out, new_text, new_length);
+        out += new_length;
+        from = at + old_length;
+    }
+    memcpy(out, text + from, length - from);
+    return string_method_string(replaced);
+}
+
+// s.strip(chars), s.lstrip(chars), s.rstrip(chars): 's' without the leading and/or
+// trailing characters found in 'chars' (whitespace by default).
+static Value string_strip_ends(Value* args, int arg_count, const char* method, bool left, bool right, Token* call_site_token) {
+    string_method_check_arity(method, arg_count, 0, 1, call_site_token);
+    const char* text = args[0].as.string_val;
+    size_t length = string_value_length(text);
+
+    bool strip_set[256] = { false };
+    size_t chars_length = strlen(STRING_WHITESPACE);
+    const char* chars = arg_count > 1 ? string_method_text_arg(args, 1, method, &chars_length, call_site_token) : STRING_WHITESPACE;
+    for (size_t i = 0; i < chars_length; ++i) strip_set[(unsigned char)chars[i]] = true;
+
+    size_t begin = 0, end = length;
+    if (left) while (begin < end && strip_set[(unsigned char)text[begin]]) begin++;
+    if (right) while (end > begin && strip_set[(unsigned char)text[end - 1]]) end--;
+    if (begin == 0 && end == length) return string_method_string(string_value_retain(args[0].as.string_val));
+    return string_method_piece(text + begin, end - begin);
+}
+
+static Value string_strip(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return string_strip_ends(args, arg_count, "strip", true, true, call_site_token);
+}
+
+static Value string_lstrip(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return string_strip_ends(args, arg_count, "lstrip", true, false, call_site_token);
+}
+
+static Value string_rstrip(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    return string_strip_ends(args, arg_count, "rstrip", false, true, call_site_token);
+}
+
+// s.upper(), s.lower(): only ASCII letters change.
+static Value string_upper(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("upper", arg_count, 0, 0, call_site_token);
+    size_t length = string_value_length(args[0].as.string_val);
+    char* upper = string_value_alloc(length);
+    string_flip_case(upper, args[0].as.string_val, length, 'a', 'z');
+    return string_method_string(upper);
+}
+
+static Value string_lower(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    string_method_check_arity("lower", arg_count, 0, 0, call_site_token);
+    size_t length = string_value_length(args[0].as.string_val);
+    char* lower = string_value_alloc(length);
+    string_flip_case(lower, args[0].as.string_val, length, 'A', 'Z');
+    return string_method_string(lower);
+}
+
+// --- Method Table ---
+static const struct {
+    const char* name;
+    CBuiltinFunction impl;
+} string_method_table[] = {
+    { "find", string_find },
+    { "count", string_count },
+    { "startswith", string_startswith },
+    { "endswith", string_endswith },
+    { "split", string_split },
+    { "join", string_join },
+    { "replace", string_replace },
+    { "strip", string_strip },
+    { "lstrip", string_lstrip },
+    { "rstrip", string_rstrip },
+    { "upper", string_upper },
+    { "lower", string_lower },
+};
+
+CBuiltinFunction string_method_lookup(const char* name) {
+    for (size_t i = 0; i < sizeof(string_method_table) / sizeof(string_method_table[0]); ++i) {
+        if (strcmp(string_method_table[i].name, name) == 0) return string_method_table[i].impl;
+    }
+    return NULL;
+}
+
+const char* string_method_name(CBuiltinFunction method) {
+    for (size_t i = 0; i < sizeof(string_method_table) / sizeof(string_method_table[0]); ++i) {
+        if (string_method_table[i].impl == method) return string_method_table[i].name;
+    }
+    return NULL;
+}
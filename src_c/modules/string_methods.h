@@ -0,0 +1,18 @@
+// src_c/modules/string_methods.h
+#ifndef ECHOC_STRING_METHODS_H
+#define ECHOC_STRING_METHODS_H
+
+#include "../header.h"
+
+// Native methods of string values: s.find(), s.count(), s.startswith(), s.endswith(),
+// s.split(), s.join(), s.replace(), s.strip(), s.lstrip(), s.rstrip(), s.upper() and
+// s.lower(). Like array.append they are C builtins bound to their receiver, which
+// they get as args[0].
+
+// The method called 'name', or NULL if strings have no such method.
+CBuiltinFunction string_method_lookup(const char* name);
+
+// The name of a method returned by string_method_lookup, or NULL for any other function.
+const char* string_method_name(CBuiltinFunction method);
+
+#endif // ECHOC_STRING_METHODS_H
@@ -3,6 +3,7 @@
 #include "../interpreter.h"
 #include "../value_utils.h"
 #include "../dictionary.h"
+#include "../intern.h"
 
 // --- Forward declarations for weaver functions ---
 static Value weaver_weave(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token);
@@ -18,7 +19,7 @@ static Value create_c_function_value(CBuiltinFunction func_ptr, const char* name
     if (!c_func_wrapper) {
         report_error("System", "Failed to allocate memory for C function wrapper.", NULL);
     }
-    c_func_wrapper->name = strdup(name);
+    c_func_wrapper->name = intern_acquire(name);
     c_func_wrapper->param_count = param_count; // Use -1 for varargs, or a specific number for arity checks
     c_func_wrapper->is_async = false; // The wrapper itself is not async
     c_func_wrapper->c_impl = func_ptr; // This is the new field pointing to the C implementation
@@ -74,10 +75,16 @@ static Value weaver_weave(Interpreter* interpreter, Value* args, int arg_count,
             interpreter->current_exception = value_deep_copy(initial_coro->exception_value);
 
             interpreter->unhandled_error_occured = 1;
+            // Reported with the run's final error (echoc_last_error), not printed here.
             char* err_str_repr = value_to_string_representation(initial_coro->exception_value, interpreter, NULL);
-            fprintf(stderr, "\n[EchoC Runtime Error] Unhandled exception in async workflow '%s': %s\n",
-                     initial_coro->name ? initial_coro->name : "unnamed_root_coro",
-                     err_str_repr);
+            const char* coro_name = initial_coro->name ? initial_coro->name : "unnamed_root_coro";
+            size_t old_length = interpreter->unhandled_async_errors ? strlen(interpreter->unhandled_async_errors) : 0;
+            size_t message_size = old_length + strlen(coro_name) + strlen(err_str_repr) + 80;
+            char* messages = realloc(interpreter->unhandled_async_errors, message_size);
+            if (!messages) report_error("System", "Failed to allocate memory for error message.", call_site_token);
+            snprintf(messages + old_length, message_size - old_length, "[EchoC Runtime Error] Unhandled exception in async workflow '%s': %s\n",
+                     coro_name, err_str_repr);
+            interpreter->unhandled_async_errors = messages;
             free(err_str_repr);
             // result is already a null value, so we just proceed to cleanup.
         }
@@ -184,9 +191,12 @@ static Value weaver_gather(Interpreter* interpreter, Value* args, int arg_count,
     gather_coro->result_value = create_null_value();
     gather_coro->exception_value = create_null_value();
     gather_coro->value_from_await = create_null_value();
-    gather_coro->gather_tasks = value_deep_copy(args[0]).as.array_val;
+    Value tasks_copy = value_deep_copy(args[0]);
+    value_make_unique(&tasks_copy); // The scheduler overwrites finished tasks in place
+    gather_coro->gather_tasks = tasks_copy.as.array_val;
     gather_coro->gather_results = malloc(sizeof(Array));
     gather_coro->gather_results->count = tasks_array->count;
+    gather_coro->gather_results->ref_count = 1;
     gather_coro->gather_results->capacity = tasks_array->count;
     gather_coro->gather_results->elements = tasks_array->count > 0 ? calloc(tasks_array->count, sizeof(Value)) : NULL;
     gather_coro->gather_pending_count = tasks_array->count;
@@ -239,6 +249,20 @@ static Value weaver_yield_now(Interpreter* interpreter, Value* args, int arg_cou
     return weaver_rest(interpreter, &zero_duration, 1, call_site_token);
 }
 
+// weaver.clock()
+// Monotonic time in milliseconds, the clock weaver.rest() schedules against.
+static Value weaver_clock(Interpreter* interpreter, Value* args, int arg_count, Token* call_site_token) {
+    (void)interpreter;
+    (void)args; // Mark as unused
+    if (arg_count != 0) {
+        report_error("Runtime", "weaver.clock() takes 0 arguments.", call_site_token);
+    }
+    Value now;
+    now.type = VAL_FLOAT;
+    now.as.floating = get_monotonic_time_sec() * 1000.0;
+    return now;
+}
+
 // --- Module Creation ---
 
 Value create_weaver_module(Interpreter* interpreter) {
@@ -258,6 +282,7 @@ Value create_weaver_module(Interpreter* interpreter) {
     ADD_WEAVER_FUNC("gather", weaver_gather, 1);
     ADD_WEAVER_FUNC("cancel", weaver_cancel, 1);
     ADD_WEAVER_FUNC("yield_now", weaver_yield_now, 0);
+    ADD_WEAVER_FUNC("clock", weaver_clock, 0);
 
     // Undefine the macro to keep it local to this function
     #undef ADD_WEAVER_FUNC
@@ -0,0 +1,144 @@
+// src_c/object_shape.c
+#include "object_shape.h"
+#include "source_unit.h" // For SourceUnitToken (inline cache entries)
+#include "scope.h"       // For symbol_table_get_local
+#include "intern.h"      // Field names are interned and compared by pointer
+
+static uint64_t next_shape_id = 1; // 0 marks an empty inline cache
+
+static Shape* shape_create(Shape* parent, const char* field_name) {
+    Shape* shape = calloc(1, sizeof(Shape));
+    if (!shape) report_error("System", "Failed to allocate memory for object shape.", NULL);
+    shape->id = next_shape_id++;
+    shape->parent = parent;
+    if (!parent) return shape;
+
+    shape->field_name = intern_retain(field_name);
+    shape->field_count = parent->field_count + 1;
+    shape->field_names = malloc(shape->field_count * sizeof(const char*));
+    if (!shape->field_names) report_error("System", "Failed to allocate memory for object shape.", NULL);
+    if (parent->field_count > 0) memcpy(shape->field_names, parent->field_names, parent->field_count * sizeof(const char*));
+    shape->field_names[parent->field_count] = shape->field_name;
+
+    shape->next_sibling = parent->first_child;
+    parent->first_child = shape;
+    return shape;
+}
+
+Shape* blueprint_root_shape(Blueprint* bp) {
+    if (!bp->root_shape) bp->root_shape = shape_create(NULL, NULL);
+    return bp->root_shape;
+}
+
+void shape_free_tree(Shape* root) {
+    if (!root) return;
+    Shape* child = root->first_child;
+    while (child) {
+        Shape* next = child->next_sibling;
+        shape_free_tree(child);
+        child = next;
+    }
+    intern_release(root->field_name);
+    free(root->field_names);
+    free(root);
+}
+
+static int shape_find_interned_slot(const Shape* shape, const char* key) {
+    for (int slot = shape->field_count - 1; slot >= 0; --slot) {
+        if (shape->field_names[slot] == key) return slot;
+    }
+    return -1;
+}
+
+int shape_find_slot(const Shape* shape, const char* name) {
+    const char* key = intern_find(name);
+    return key ? shape_find_interned_slot(shape, key) : -1;
+}
+
+// The layout 'shape' becomes when interned 'key' is added, reusing an existing transition.
+static Shape* shape_with_field(Shape* shape, const char* key) {
+    for (Shape* child = shape->first_child; child; child = child->next_sibling) {
+        if (child->field_name == key) return child;
+    }
+    return shape_create(shape, key);
+}
+
+// Only tokens from a source unit's cache carry an inline cache.
+static SourceUnitToken* attribute_site_cache(const Token* site) {
+    if (!site || !site->is_borrowed) return NULL;
+    return (SourceUnitToken*)site; // Borrowed tokens live inside their cache entry
+}
+
+Value* object_get_field(Object* obj, const char* name) {
+    int slot = shape_find_slot(obj->shape, name);
+    return slot >= 0 ? &obj->fields[slot] : NULL;
+}
+
+Value* object_find_attribute(Object* obj, const Token* site, const char* name) {
+    SourceUnitToken* cache = attribute_site_cache(site);
+    if (cache && cache->attr_shape_id == obj->shape->id) {
+        if (cache->attr_slot >= 0) return &obj->fields[cache->attr_slot];
+        if (cache->attr_class_value) return cache->attr_class_value;
+    }
+
+    // Instance fields shadow class members. Class scopes only gain symbols while their
+    // blueprint body runs, so for a given shape the answer below never changes.
+    int slot = shape_find_slot(obj->shape, name);
+    Value* found = slot >= 0 ? &obj->fields[slot] : NULL;
+    for (Blueprint* bp = obj->blueprint; !found && bp; bp = bp->parent_blueprint) {
+        found = symbol_table_get_local(bp->class_attributes_and_methods, name);
+    }
+    if (cache && found) {
+        cache->attr_shape_id = obj->shape->id;
+        cache->attr_slot = slot;
+        cache->attr_class_value = slot >= 0 ? NULL : found;
+        cache->attr_transition = NULL;
+    }
+    return found;
+}
+
+void object_set_field(Object* obj, const Token* site, const char* name, Value value) {
+    SourceUnitToken* cache = attribute_site_cache(site);
+    int slot;
+    Shape* grown_shape = NULL;
+    if (cache && cache->attr_shape_id == obj->shape->id && (cache->attr_slot >= 0 || cache->attr_transition)) {
+        slot = cache->attr_slot;
+        grown_shape = cache->attr_transition;
+    } else {
+        const char* key = intern_acquire(name);
+        slot = shape_find_interned_slot(obj->shape, key);
+        if (slot < 0) grown_shape = shape_with_field(obj->shape, key);
+        intern_release(key); // A new shape took its own reference
+        if (cache) {
+            cache->attr_shape_id = obj->shape->id;
+            cache->attr_slot = slot;
+            cache->attr_class_value = NULL;
+            cache->attr_transition = grown_shape;
+        }
+    }
+
+    Value new_value = value_deep_copy(value); // Copy first in case 'value' lives in the old one
+    if (slot >= 0) {
+        free_value_contents(obj->fields[slot]);
+        obj->fields[slot] = new_value;
+        return;
+    }
+    if (grown_shape->field_count > obj->field_capacity) {
+        int new_capacity = obj->field_capacity ? obj->field_capacity * 2 : 4;
+        Value* new_fields = realloc(obj->fields, new_capacity * sizeof(Value));
+        if (!new_fields) report_error("System", "Failed to grow object fields.", NULL);
+        obj->fields = new_fields;
+        obj->field_capacity = new_capacity;
+    }
+    obj->fields[grown_shape->field_count - 1] = new_value;
+    obj->shape = grown_shape;
+}
+
+void object_free_fields(Object* obj) {
+    for (int slot = 0; slot < obj->shape->field_count; ++slot) {
+        free_value_contents(obj->fields[slot]);
+    }
+    free(obj->fields);
+    obj->fields = NULL;
+    obj->field_capacity = 0;
+}
@@ -0,0 +1,35 @@
+// src_c/object_shape.h
+#ifndef ECHOC_OBJECT_SHAPE_H
+#define ECHOC_OBJECT_SHAPE_H
+
+#include "header.h" // Provides Shape, Object, Blueprint, Token, Value
+
+// Instance fields live in a flat Value array indexed by slot; the object's Shape
+// maps names to slots. Shapes form a per-blueprint transition tree, so objects
+// initialized the same way share a layout, and a call site that has seen a shape
+// before can reuse the slot it found without looking the name up again.
+
+// Layout of a new instance of 'bp' (no fields), created on first use.
+Shape* blueprint_root_shape(Blueprint* bp);
+
+// Frees a blueprint's shape tree. Objects using it must already be freed.
+void shape_free_tree(Shape* root);
+
+// Slot of 'name' in 'shape', or -1.
+int shape_find_slot(const Shape* shape, const char* name);
+
+// Instance field 'name', or NULL. Does not consult the blueprint.
+Value* object_get_field(Object* obj, const char* name);
+
+// Resolves obj.name: an instance field, else a class attribute or method along the
+// blueprint chain, else NULL. 'site' is the attribute-name token; when it comes from
+// a source unit its inline cache is used and refreshed. It may be NULL.
+Value* object_find_attribute(Object* obj, const Token* site, const char* name);
+
+// Stores a copy of 'value' in field 'name', adding the field if needed (self.name = value).
+void object_set_field(Object* obj, const Token* site, const char* name, Value value);
+
+// Frees the field values and storage of an object that is being destroyed.
+void object_free_fields(Object* obj);
+
+#endif // ECHOC_OBJECT_SHAPE_H
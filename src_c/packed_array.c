@@ -0,0 +1,113 @@
+// src_c/packed_array.c
+#include "packed_array.h"
+#include <string.h>
+#include <stdlib.h>
+
+PackedArray* packed_array_create(PackedKind kind, int count) {
+    PackedArray* arr = malloc(sizeof(PackedArray));
+    if (!arr) report_error("System", "Failed to allocate memory for numeric array.", NULL);
+    arr->kind = kind;
+    arr->count = count;
+    arr->ref_count = 1;
+    size_t element_size = kind == PACKED_INT ? sizeof(int64_t) : sizeof(double);
+    void* data = malloc((count > 0 ? (size_t)count : 1) * element_size);
+    if (!data) { free(arr); report_error("System", "Failed to allocate memory for numeric array elements.", NULL); }
+    if (kind == PACKED_INT) arr->data.ints = data;
+    else arr->data.floats = data;
+    return arr;
+}
+
+void packed_array_free(PackedArray* arr) {
+    if (!arr) return;
+    if (arr->kind == PACKED_INT) free(arr->data.ints);
+    else free(arr->data.floats);
+    free(arr);
+}
+
+PackedArray* packed_array_clone(const PackedArray* arr) {
+    PackedArray* clone = packed_array_create(arr->kind, arr->count);
+    if (arr->kind == PACKED_INT) memcpy(clone->data.ints, arr->data.ints, arr->count * sizeof(int64_t));
+    else memcpy(clone->data.floats, arr->data.floats, arr->count * sizeof(double));
+    return clone;
+}
+
+Value packed_array_get(const PackedArray* arr, int index) {
+    Value val;
+    if (arr->kind == PACKED_INT) {
+        val.type = VAL_INT;
+        val.as.integer = (long)arr->data.ints[index];
+    } else {
+        val.type = VAL_FLOAT;
+        val.as.floating = arr->data.floats[index];
+    }
+    return val;
+}
+
+// Converts the elements of an int array to doubles in place of the old storage.
+static void packed_array_widen(PackedArray* arr) {
+    double* floats = malloc((arr->count > 0 ? (size_t)arr->count : 1) * sizeof(double));
+    if (!floats) report_error("System", "Failed to allocate memory for numeric array elements.", NULL);
+    for (int i = 0; i < arr->count; ++i) floats[i] = (double)arr->data.ints[i];
+    free(arr->data.ints);
+    arr->data.floats = floats;
+    arr->kind = PACKED_FLOAT;
+}
+
+bool packed_array_set(PackedArray* arr, int index, Value value) {
+    if (value.type == VAL_INT) {
+        if (arr->kind == PACKED_INT) arr->data.ints[index] = value.as.integer;
+        else arr->data.floats[index] = (double)value.as.integer;
+        return true;
+    }
+    if (value.type == VAL_FLOAT) {
+        if (arr->kind == PACKED_INT) packed_array_widen(arr);
+        arr->data.floats[index] = value.as.floating;
+        return true;
+    }
+    return false;
+}
+
+Array* packed_array_to_array(const PackedArray* arr) {
+    Array* generic = malloc(sizeof(Array));
+    if (!generic) report_error("System", "Failed to allocate memory for array.", NULL);
+    generic->count = arr->count;
+    generic->capacity = arr->count > 0 ? arr->count : 1;
+    generic->ref_count = 1;
+    generic->elements = malloc(generic->capacity * sizeof(Value));
+    if (!generic->elements) { free(generic); report_error("System", "Failed to allocate memory for array elements.", NULL); }
+    for (int i = 0; i < arr->count; ++i) {
+        generic->elements[i] = packed_array_get(arr, i);
+    }
+    return generic;
+}
+
+bool packed_array_equals_array(const PackedArray* packed, const Array* array) {
+    if (packed->count != array->count) return false;
+    for (int i = 0; i < packed->count; ++i) {
+        Value element = array->elements[i];
+        if (element.type == VAL_INT && packed->kind == PACKED_INT) {
+            if (packed->data.ints[i] != (int64_t)element.as.integer) return false;
+        } else if (element.type == VAL_INT || element.type == VAL_FLOAT) {
+            double x = packed->kind == PACKED_INT ? (double)packed->data.ints[i] : packed->data.floats[i];
+            double y = element.type == VAL_INT ? (double)element.as.integer : element.as.floating;
+            if (x != y) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool packed_array_equal(const PackedArray* a, const PackedArray* b) {
+    if (a == b) return true;
+    if (a->count != b->count) return false;
+    if (a->kind == PACKED_INT && b->kind == PACKED_INT) {
+        return a->count == 0 || memcmp(a->data.ints, b->data.ints, a->count * sizeof(int64_t)) == 0;
+    }
+    for (int i = 0; i < a->count; ++i) {
+        double x = a->kind == PACKED_INT ? (double)a->data.ints[i] : a->data.floats[i];
+        double y = b->kind == PACKED_INT ? (double)b->data.ints[i] : b->data.floats[i];
+        if (x != y) return false;
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+// src_c/packed_array.h
+#ifndef ECHOC_PACKED_ARRAY_H
+#define ECHOC_PACKED_ARRAY_H
+
+#include "header.h" // Provides PackedArray, Array, Value
+
+// A numeric array stored as contiguous int64 or double elements instead of
+// tagged Values. The 'numeric' module creates them and runs its vectorized
+// kernels over them; the core only needs indexing, len, iteration, printing
+// and stores. A store of a float into an int array widens the whole array to
+// floats; a store of anything non-numeric turns it back into a generic array.
+
+// New array of 'count' uninitialized elements, with a reference count of 1.
+PackedArray* packed_array_create(PackedKind kind, int count);
+
+// Frees the elements and the struct. Called once the reference count reaches 0.
+void packed_array_free(PackedArray* arr);
+
+// Private copy of a shared array (see value_make_unique).
+PackedArray* packed_array_clone(const PackedArray* arr);
+
+// Element 'index' (must be in range) as a VAL_INT or VAL_FLOAT.
+Value packed_array_get(const PackedArray* arr, int index);
+
+// Stores 'value' at 'index' (must be in range) of an unshared array. Returns false,
+// leaving the array untouched, if 'value' is not an integer or a float.
+bool packed_array_set(PackedArray* arr, int index, Value value);
+
+// Generic array holding the same numbers.
+Array* packed_array_to_array(const PackedArray* arr);
+
+// Element-wise numeric equality (an int array can equal a float array).
+bool packed_array_equal(const PackedArray* a, const PackedArray* b);
+
+// True if 'array' holds the same numbers as 'packed', element by element, so that a
+// packed array compares equal to the generic array it was packed from.
+bool packed_array_equals_array(const PackedArray* packed, const Array* array);
+
+#endif // ECHOC_PACKED_ARRAY_H
@@ -1,6 +1,8 @@
 // src_c/scope.c
 #include "scope.h"
 #include "value_utils.h" // For value_to_string_representation
+#include "source_unit.h" // For SourceUnitToken (frame slots of cached identifier tokens)
+#include "intern.h" // Symbol names are interned and compared by pointer
 #include <string.h> // For strcmp, strdup
 #include <stdlib.h> // For malloc, free
 #include <stdbool.h> // For bool
@@ -19,7 +21,7 @@ void free_scope(Scope* scope) {
         }
 
         if (current->name) {
-            free(current->name);
+            intern_release(current->name);
             current->name = NULL; // Good practice
         }
         
@@ -29,12 +31,13 @@ void free_scope(Scope* scope) {
         free(current);
         current = next;
     }
+    free(scope->slots); // Slots only point at values owned by the symbol nodes above
     free(scope); // Free the Scope struct itself
 }
 
 
 void enter_scope(Interpreter* interpreter) {
-    Scope* new_scope = (Scope*)malloc(sizeof(Scope));
+    Scope* new_scope = (Scope*)calloc(1, sizeof(Scope));
     if (!new_scope) {
         // This is a critical error - we can't continue without memory
         report_error("System", "Failed to allocate memory for new scope", interpreter->current_token);
@@ -67,11 +70,12 @@ void symbol_table_set(Scope* current_scope, const char* name, Value value) {
                  current_scope->symbols ? current_scope->symbols->name : "NULL_HEAD",
                  (void*)current_scope->symbols);
 
-    // Search from the current scope outwards.
-    Scope* scope_to_search = current_scope;
+    // Search from the current scope outwards. A name nobody has interned is not bound anywhere.
+    const char* key = intern_find(name);
+    Scope* scope_to_search = key ? current_scope : NULL;
     while (scope_to_search != NULL) {
         for (SymbolNode* node = scope_to_search->symbols; node != NULL; node = node->next) {
-            if (strcmp(node->name, name) == 0) {
+            if (node->name == key) {
                 // Found it. Update the value in its definition scope and return.
                 DEBUG_PRINTF("  Updating existing variable '%s' in [Scope #%llu] %p", name, scope_to_search->id, (void*)scope_to_search);
                 Value new_value_copy = value_deep_copy(value); // Copy the new value first to handle self-assignment (e.g. let: x = x + 1)
@@ -95,11 +99,7 @@ void symbol_table_set(Scope* current_scope, const char* name, Value value) {
         exit(1); // Or set a global error flag
         report_error("System", "Failed to allocate memory for new symbol", NULL);
     }
-    newNode->name = strdup(name);
-    if (!newNode->name) {
-        free(newNode);
-        report_error("System", "Failed to allocate memory for symbol name in symbol_table_set", NULL);
-    }
+    newNode->name = intern_acquire(name);
     // Use value_deep_copy which handles NULL values properly
     // and returns an appropriate error value if copying fails
     newNode->value = value_deep_copy(value);
@@ -118,8 +118,9 @@ void symbol_table_define(Scope* scope, const char* name, Value value) {
     }
 
     // Check if the variable already exists in the *current* scope.
-    for (SymbolNode* node = scope->symbols; node != NULL; node = node->next) {
-        if (strcmp(node->name, name) == 0) {
+    const char* key = intern_find(name);
+    for (SymbolNode* node = key ? scope->symbols : NULL; node != NULL; node = node->next) {
+        if (node->name == key) {
             // Variable exists in the current scope, so update it.
             DEBUG_PRINTF("  Updating existing variable '%s' with 'let' in current scope %p", name, (void*)scope);
             free_value_contents(node->value);
@@ -134,11 +135,7 @@ void symbol_table_define(Scope* scope, const char* name, Value value) {
     if (!newNode) {
         report_error("System", "Failed to allocate memory for new symbol in symbol_table_define", NULL);
     }
-    newNode->name = strdup(name);
-    if (!newNode->name) {
-        free(newNode);
-        report_error("System", "Failed to allocate memory for symbol name in symbol_table_define", NULL);
-    }
+    newNode->name = intern_acquire(name);
     newNode->value = value_deep_copy(value);
     newNode->next = scope->symbols;
     scope->symbols = newNode;
@@ -169,7 +166,8 @@ Value* symbol_table_get_recursive(Scope* current_scope, const char* name) {
     if (temp_s_log) DEBUG_PRINTF("  ... (more outer scopes for '%s' lookup)%s", name, "");
 
     DEBUG_PRINTF("SYMBOL_TABLE_GET: Attempting to find variable '%s'", name);
-    Scope* scope_to_search = current_scope;
+    const char* key = intern_find(name);
+    Scope* scope_to_search = key ? current_scope : NULL;
     while (scope_to_search != NULL) {
         DEBUG_PRINTF("  Searching [Scope #%llu] %p (outer: %p)", scope_to_search->id, (void*)scope_to_search, (void*)scope_to_search->outer);
         SymbolNode* current_symbol = scope_to_search->symbols;
@@ -185,7 +183,7 @@ Value* symbol_table_get_recursive(Scope* current_scope, const char* name) {
             //}
             // --- END: ADD THIS DEBUG BLOCK ---
 
-            if (strcmp(current_symbol->name, name) == 0) {
+            if (current_symbol->name == key) {
                 DEBUG_PRINTF("    FOUND variable '%s' in [Scope #%llu] %p.", name, scope_to_search->id, (void*)scope_to_search);
                 if (current_symbol->value.type == VAL_INT) {
                     DEBUG_PRINTF("      Type: VAL_INT, Value: %ld", current_symbol->value.as.integer);
@@ -213,10 +211,11 @@ Value* symbol_table_get(Scope* current_scope, const char* name) {
 Value* symbol_table_get_local(Scope* scope, const char* name) {
     if (!scope) return NULL;
     DEBUG_PRINTF("SYMBOL_TABLE_GET_LOCAL: Attempting to find variable '%s' in scope %p", name, (void*)scope);
-    SymbolNode* current_symbol = scope->symbols;
+    const char* key = intern_find(name);
+    SymbolNode* current_symbol = key ? scope->symbols : NULL;
     while (current_symbol != NULL) {
         DEBUG_PRINTF("    Checking against symbol '%s'", current_symbol->name);
-        if (strcmp(current_symbol->name, name) == 0) {
+        if (current_symbol->name == key) {
             DEBUG_PRINTF("    FOUND variable '%s' locally.", name);
              if (current_symbol->value.type == VAL_INT) DEBUG_PRINTF("      Type: VAL_INT, Value: %ld", current_symbol->value.as.integer);
              else if (current_symbol->value.type == VAL_FLOAT) DEBUG_PRINTF("      Type: VAL_FLOAT, Value: %f", current_symbol->value.as.floating);
@@ -229,24 +228,102 @@ Value* symbol_table_get_local(Scope* scope, const char* name) {
     return NULL;
 }
 
-VarScopeInfo get_variable_definition_scope_and_value(Scope* search_start_scope, const char* name) {
+// Finds interned 'key' starting at 'scope' and moving outwards.
+static VarScopeInfo scope_find_interned(Scope* scope, const char* key) {
     VarScopeInfo info = {NULL, NULL};
-    Scope* scope_to_search = search_start_scope;
-    while (scope_to_search != NULL) {
-        SymbolNode* current_symbol = scope_to_search->symbols;
-        while (current_symbol != NULL) {
-            if (strcmp(current_symbol->name, name) == 0) {
+    for (Scope* scope_to_search = key ? scope : NULL; scope_to_search != NULL; scope_to_search = scope_to_search->outer) {
+        for (SymbolNode* current_symbol = scope_to_search->symbols; current_symbol != NULL; current_symbol = current_symbol->next) {
+            if (current_symbol->name == key) {
                 info.value_ptr = &(current_symbol->value);
                 info.definition_scope = scope_to_search; // This is the scope where the symbol node resides
                 return info;
             }
-            current_symbol = current_symbol->next;
         }
-        scope_to_search = scope_to_search->outer;
     }
     return info; // Not found
 }
 
+static Value* scope_find_local_interned(Scope* scope, const char* key) {
+    for (SymbolNode* node = scope->symbols; node != NULL; node = node->next) {
+        if (node->name == key) return &node->value;
+    }
+    return NULL;
+}
+
+VarScopeInfo get_variable_definition_scope_and_value(Scope* search_start_scope, const char* name) {
+    return scope_find_interned(search_start_scope, intern_find(name));
+}
+
+// Cached tokens already carry the interned name; other tokens look theirs up.
+static const char* token_name_key(const Token* name_token) {
+    return name_token->is_borrowed ? name_token->value : intern_find(name_token->value);
+}
+
+void scope_attach_frame(Scope* scope, const Function* func) {
+    if (!func || func->frame_size <= 0) return;
+    scope->slots = calloc(func->frame_size, sizeof(Value*));
+    if (!scope->slots) report_error("System", "Failed to allocate function frame", NULL);
+    scope->slot_count = func->frame_size;
+    scope->frame_owner = func->frame_owner;
+}
+
+// Finds the frame slot for 'name_token' if the token belongs to the function whose call
+// scope encloses 'current_scope'. Returns NULL when the name must be looked up by string:
+// unresolved token, no matching frame, or the name is shadowed by a scope nested inside
+// the call (e.g. a 'for' loop scope), in which case '*shadowed' receives that value.
+static Value** scope_frame_slot(Scope* current_scope, const Token* name_token, Scope** frame_out, Value** shadowed) {
+    *shadowed = NULL;
+    if (!name_token->is_borrowed) return NULL;
+    const SourceUnitToken* entry = (const SourceUnitToken*)name_token; // Borrowed tokens live inside their cache entry
+    if (entry->slot < 0) return NULL;
+
+    Scope* frame = current_scope;
+    while (frame && !frame->slots) frame = frame->outer;
+    if (!frame || frame->frame_owner != entry->frame_owner || entry->slot >= frame->slot_count) return NULL;
+    for (Scope* s = current_scope; s != frame; s = s->outer) {
+        Value* local = scope_find_local_interned(s, name_token->value);
+        if (local) { *shadowed = local; return NULL; }
+    }
+    *frame_out = frame;
+    return &frame->slots[entry->slot];
+}
+
+// Caches the slot once the variable lives in the frame scope itself. Values further out
+// (globals, closures) are never cached: a later definition in between could shadow them.
+static void scope_fill_frame_slot(Scope* frame, Value** slot, const char* key) {
+    Value* local = scope_find_local_interned(frame, key);
+    if (local) *slot = local;
+}
+
+Value* symbol_table_get_token(Scope* current_scope, const Token* name_token) {
+    Scope* frame = NULL;
+    Value* shadowed;
+    Value** slot = scope_frame_slot(current_scope, name_token, &frame, &shadowed);
+    if (slot) {
+        if (*slot) return *slot;
+        // Scopes nested in the call were already checked, so searching from the frame is equivalent.
+        VarScopeInfo info = scope_find_interned(frame, name_token->value);
+        if (info.definition_scope == frame) *slot = info.value_ptr; // See scope_fill_frame_slot
+        return info.value_ptr;
+    }
+    if (shadowed) return shadowed;
+    return scope_find_interned(current_scope, token_name_key(name_token)).value_ptr;
+}
+
+void symbol_table_set_token(Scope* current_scope, const Token* name_token, Value value) {
+    Scope* frame = NULL;
+    Value* shadowed;
+    Value** slot = scope_frame_slot(current_scope, name_token, &frame, &shadowed);
+    if (slot && *slot) {
+        Value new_value_copy = value_deep_copy(value); // Copy first to handle self-assignment
+        free_value_contents(**slot);
+        **slot = new_value_copy;
+        return;
+    }
+    symbol_table_set(current_scope, name_token->value, value);
+    if (slot) scope_fill_frame_slot(frame, slot, name_token->value);
+}
+
 void print_scope_contents(Scope* scope) {
     if (!scope) {
         DEBUG_PRINTF("Scope is NULL.%s", ""); // Added empty string argument
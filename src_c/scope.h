@@ -35,6 +35,19 @@ typedef struct {
 // Gets a variable's value and its definition scope.
 VarScopeInfo get_variable_definition_scope_and_value(Scope* search_start_scope, const char* name);
 
+// Gives a freshly entered call scope a flat slot frame matching 'func''s resolved layout.
+// No-op for functions without one (C functions, empty bodies).
+void scope_attach_frame(Scope* scope, const Function* func);
+
+// Variable lookup by identifier token. A token resolved to a frame slot of the function
+// executing in 'current_scope' costs one array index once its local exists; globals,
+// closure variables and unresolved tokens fall back to symbol_table_get.
+Value* symbol_table_get_token(Scope* current_scope, const Token* name_token);
+
+// Same semantics as symbol_table_set(current_scope, name_token->value, value), using the
+// token's frame slot when the variable is a local of the executing function.
+void symbol_table_set_token(Scope* current_scope, const Token* name_token, Value value);
+
 // Prints the contents of a scope for debugging.
 void print_scope_contents(Scope* scope);
 
@@ -0,0 +1,341 @@
+// src_c/source_unit.c
+#include "source_unit.h"
+#include "bytecode_vm.h" // For bytecode_chunk_free
+#include "string_template.h" // For string_template_free
+#include "string_value.h"    // For string_value_release (cached literal values)
+#include "intern.h" // Token values are interned process-wide
+#include "unit_cache.h" // Persistent token cache consulted by source_unit_load_file
+#include <errno.h>
+#include <fcntl.h>    // For open
+#include <limits.h>   // For INT_MAX (text offsets are ints)
+#include <sys/stat.h> // For fstat
+#ifndef _WIN32
+#include <sys/mman.h> // For mmap, munmap
+#endif
+
+SourceUnit* source_unit_create(char* text, size_t text_length) {
+    SourceUnit* unit = calloc(1, sizeof(SourceUnit));
+    if (!unit) report_error("System", "Failed to allocate memory for source unit", NULL);
+    unit->text = text;
+    unit->text_length = text_length;
+    unit->ref_count = 1;
+
+    // Line-start index, shared by every lexer state that points into this text.
+    int line_capacity = 64;
+    unit->line_starts = malloc(line_capacity * sizeof(int));
+    if (!unit->line_starts) report_error("System", "Failed to allocate line index for source unit", NULL);
+    unit->line_starts[unit->line_count++] = 0;
+    for (size_t i = 0; i < text_length; ++i) {
+        if (text[i] != '\n') continue;
+        if (unit->line_count == line_capacity) {
+            line_capacity *= 2;
+            int* new_starts = realloc(unit->line_starts, line_capacity * sizeof(int));
+            if (!new_starts) report_error("System", "Failed to grow line index for source unit", NULL);
+            unit->line_starts = new_starts;
+        }
+        unit->line_starts[unit->line_count++] = (int)i + 1;
+    }
+
+    unit->scan_lexer.text = text;
+    unit->scan_lexer.pos = 0;
+    unit->scan_lexer.current_char = text_length > 0 ? text[0] : '\0';
+    unit->scan_lexer.line = 1;
+    unit->scan_lexer.col = 1;
+    unit->scan_lexer.text_length = text_length;
+    unit->scan_lexer.unit = NULL; // The scan lexer always works on characters
+    unit->scan_lexer.token_index = -1;
+    DEBUG_PRINTF("SOURCE_UNIT_CREATE: %p, text_len=%zu", (void*)unit, text_length);
+    return unit;
+}
+
+SourceUnit* source_unit_load_file(const char* path, char* error_message, size_t error_size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        snprintf(error_message, error_size, "Could not open file '%s': %s", path, strerror(errno));
+        return NULL;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < 0 || (unsigned long long)file_stat.st_size >= (unsigned long long)INT_MAX) {
+        snprintf(error_message, error_size, "Could not determine a usable size for file '%s'.", path);
+        close(fd);
+        return NULL;
+    }
+    size_t length = (size_t)file_stat.st_size;
+
+#ifndef _WIN32
+    // The lexer relies on a NUL after the text. The zero-filled tail of a mapping's last
+    // page provides it, so only a file ending exactly on a page boundary is read instead.
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (length > 0 && page_size > 0 && length % (size_t)page_size != 0) {
+        void* mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            close(fd);
+            SourceUnit* unit = source_unit_create(mapped, length);
+            unit->mapped_length = length;
+            unit_cache_load(unit, path, &file_stat);
+            return unit;
+        }
+    }
+#endif
+
+    char* text = malloc(length + 1);
+    if (!text) {
+        snprintf(error_message, error_size, "Could not allocate memory to read file '%s'.", path);
+        close(fd);
+        return NULL;
+    }
+    size_t bytes_read = 0;
+    while (bytes_read < length) {
+        ssize_t n = read(fd, text + bytes_read, length - bytes_read);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        bytes_read += (size_t)n;
+    }
+    close(fd);
+    if (bytes_read != length) {
+        snprintf(error_message, error_size, "Failed to read entire file '%s'. Expected %zu bytes, got %zu.", path, length, bytes_read);
+        free(text);
+        return NULL;
+    }
+    text[length] = '\0';
+    SourceUnit* unit = source_unit_create(text, length);
+    unit_cache_load(unit, path, &file_stat);
+    return unit;
+}
+
+void source_unit_incref(SourceUnit* unit) {
+    if (unit) unit->ref_count++;
+}
+
+void source_unit_decref(SourceUnit* unit) {
+    if (!unit) return;
+    unit->ref_count--;
+    if (unit->ref_count > 0) return;
+    DEBUG_PRINTF("SOURCE_UNIT_FREE: %p (%d tokens cached)", (void*)unit, unit->token_count);
+    for (int i = 0; i < unit->expr_chunks_capacity; ++i) {
+        bytecode_chunk_free(unit->expr_chunks[i]);
+    }
+    free(unit->expr_chunks);
+    for (int i = 0; i < unit->token_count; ++i) {
+        SourceUnitToken* entry = SOURCE_UNIT_ENTRY(unit, i);
+        string_template_free(entry->string_template);
+        string_value_release(entry->literal_string);
+        if (token_type_owns_value(entry->token.type)) intern_release(entry->token.value); // One reference per cached token
+    }
+    for (int i = 0; i < unit->block_count; ++i) {
+        free(unit->token_blocks[i]);
+    }
+    free(unit->token_blocks);
+    free(unit->line_starts);
+    free(unit->source_path);
+#ifndef _WIN32
+    if (unit->mapped_length > 0) munmap((void*)unit->text, unit->mapped_length);
+    else
+#endif
+    free((char*)unit->text);
+    free(unit);
+}
+
+// Appends an uninitialized entry, allocating a new block when the last one is full.
+SourceUnitToken* source_unit_append_entry(SourceUnit* unit) {
+    if (unit->token_count == unit->block_count * SOURCE_UNIT_TOKEN_BLOCK) {
+        if (unit->block_count == unit->block_capacity) {
+            int new_capacity = unit->block_capacity ? unit->block_capacity * 2 : 8;
+            SourceUnitToken** new_blocks = realloc(unit->token_blocks, new_capacity * sizeof(SourceUnitToken*));
+            if (!new_blocks) report_error("System", "Failed to grow token cache for source unit", NULL);
+            unit->token_blocks = new_blocks;
+            unit->block_capacity = new_capacity;
+        }
+        unit->token_blocks[unit->block_count] = malloc(SOURCE_UNIT_TOKEN_BLOCK * sizeof(SourceUnitToken));
+        if (!unit->token_blocks[unit->block_count]) report_error("System", "Failed to allocate token cache for source unit", NULL);
+        unit->block_count++;
+    }
+    int index = unit->token_count++;
+    return SOURCE_UNIT_ENTRY(unit, index);
+}
+
+// Lexes one more token from where the previous one ended and appends it.
+static void source_unit_lex_next(SourceUnit* unit) {
+    if (unit->reached_eof) return;
+    int start_pos = unit->scan_lexer.pos;
+    Token* scanned = lexer_scan_token(&unit->scan_lexer, &start_pos);
+
+    SourceUnitToken* entry = source_unit_append_entry(unit);
+    entry->token = *scanned;
+    entry->token.is_borrowed = true;
+    entry->slot = -1;
+    entry->frame_size = -1;
+    entry->frame_owner = NULL;
+    entry->attr_shape_id = 0;
+    entry->attr_slot = -1;
+    entry->attr_class_value = NULL;
+    entry->attr_transition = NULL;
+    entry->string_template = NULL;
+    entry->literal_string = NULL;
+    entry->next_dedent = -1;
+    if (token_type_owns_value(scanned->type) && scanned->value) {
+        entry->token.value = (char*)intern_acquire(scanned->value);
+        free(scanned->value);
+    }
+    entry->start_pos = start_pos;
+    entry->end_pos = unit->scan_lexer.pos;
+    entry->end_line = unit->scan_lexer.line;
+    entry->end_col = unit->scan_lexer.col;
+    free(scanned);
+    if (entry->token.type == TOKEN_EOF) unit->reached_eof = true;
+}
+
+const SourceUnitToken* source_unit_token_at(SourceUnit* unit, int index) {
+    while (index >= unit->token_count && !unit->reached_eof) {
+        source_unit_lex_next(unit);
+    }
+    if (index >= unit->token_count) index = unit->token_count - 1; // Clamp to EOF
+    return SOURCE_UNIT_ENTRY(unit, index);
+}
+
+int source_unit_token_index_at(SourceUnit* unit, int pos) {
+    // Make sure the token covering 'pos' has been lexed.
+    while (!unit->reached_eof && (unit->token_count == 0 || SOURCE_UNIT_ENTRY(unit, unit->token_count - 1)->start_pos < pos)) {
+        source_unit_lex_next(unit);
+    }
+    int lo = 0;
+    int hi = unit->token_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (SOURCE_UNIT_ENTRY(unit, mid)->start_pos < pos) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int source_unit_find_token(SourceUnit* unit, int line, int col) {
+    int lo = 0;
+    int hi = unit->token_count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        const Token* t = &SOURCE_UNIT_ENTRY(unit, mid)->token;
+        if (t->line == line && t->col == col) return mid;
+        if (t->line < line || (t->line == line && t->col < col)) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+void source_unit_position_of(SourceUnit* unit, int pos, int* line, int* col) {
+    // Last line whose start is <= pos.
+    int lo = 0;
+    int hi = unit->line_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (unit->line_starts[mid] <= pos) lo = mid;
+        else hi = mid - 1;
+    }
+    *line = lo + 1;
+    *col = pos - unit->line_starts[lo] + 1;
+}
+
+int source_unit_offset_of(SourceUnit* unit, int line, int col) {
+    if (line < 1 || line > unit->line_count || col < 1) return -1;
+    int pos = unit->line_starts[line - 1] + col - 1;
+    int line_end = line < unit->line_count ? unit->line_starts[line] : (int)unit->text_length + 1;
+    if (pos >= line_end) return -1; // Column runs past the end of the line
+    return pos;
+}
+
+int source_unit_resolve_frame(SourceUnit* unit, int body_start, int body_end, const Parameter* params, int param_count) {
+    if (body_start >= body_end) return 0;
+    source_unit_token_at(unit, body_end - 1); // Make sure the whole body is cached
+    SourceUnitToken* owner = SOURCE_UNIT_ENTRY(unit, body_start);
+    if (owner->frame_owner == owner && owner->frame_size >= 0) return owner->frame_size;
+
+    // Token values and parameter names are interned, so names compare by pointer.
+    int name_capacity = param_count + 16;
+    const char** names = malloc(name_capacity * sizeof(const char*));
+    if (!names) report_error("System", "Failed to allocate name table for function frame", NULL);
+    int name_count = 0;
+    for (int i = 0; i < param_count; ++i) {
+        names[name_count++] = params[i].name;
+    }
+
+    for (int i = body_start; i < body_end; ++i) {
+        SourceUnitToken* entry = SOURCE_UNIT_ENTRY(unit, i);
+        if (entry->token.type == TOKEN_FUNCT) {
+            // A nested definition: skip its header line and its indented body.
+            int def_col = entry->token.col;
+            if (i > body_start) {
+                const Token* prev = &SOURCE_UNIT_ENTRY(unit, i - 1)->token;
+                if (prev->type == TOKEN_ASYNC && prev->line == entry->token.line) def_col = prev->col;
+            }
+            int header_line = entry->token.line;
+            while (i + 1 < body_end && SOURCE_UNIT_ENTRY(unit, i + 1)->token.line == header_line) i++;
+            while (i + 1 < body_end && SOURCE_UNIT_ENTRY(unit, i + 1)->token.col >= def_col + 4) i++;
+            continue;
+        }
+        if (entry->token.type != TOKEN_ID) continue;
+        if (i > body_start && SOURCE_UNIT_ENTRY(unit, i - 1)->token.type == TOKEN_DOT) continue; // Attribute name
+
+        int slot = 0;
+        while (slot < name_count && names[slot] != entry->token.value) slot++;
+        if (slot == name_count) {
+            if (name_count == name_capacity) {
+                name_capacity *= 2;
+                const char** new_names = realloc(names, name_capacity * sizeof(const char*));
+                if (!new_names) report_error("System", "Failed to grow name table for function frame", NULL);
+                names = new_names;
+            }
+            names[name_count++] = entry->token.value;
+        }
+        entry->slot = slot;
+        entry->frame_owner = owner;
+    }
+    free(names);
+
+    owner->frame_owner = owner;
+    owner->frame_size = name_count;
+    DEBUG_PRINTF("SOURCE_UNIT_RESOLVE_FRAME: tokens [%d, %d) -> %d slots", body_start, body_end, name_count);
+    return name_count;
+}
+
+#define SKIP_BLOCK_STACK 256
+
+int source_unit_skip_block(SourceUnit* unit, int index, int max_col) {
+    SourceUnitToken* entry = (SourceUnitToken*)source_unit_token_at(unit, index);
+    // Every token strictly between a token and its next_dedent is indented at least as far,
+    // so none of them can end the skip: hop over the whole run.
+    while (entry->token.type != TOKEN_EOF && entry->token.col > max_col && entry->next_dedent >= 0) {
+        index = entry->next_dedent;
+        entry = SOURCE_UNIT_ENTRY(unit, index);
+    }
+    if (entry->token.type == TOKEN_EOF || entry->token.col <= max_col) return index;
+
+    // Walk the rest of the block, keeping the tokens whose next_dedent is still open on a
+    // stack of increasing columns. The token that ends the skip (or EOF) is left of every
+    // token in the block, so it closes all of them. Tokens that do not fit on the stack simply stay
+    // unrecorded.
+    int open[SKIP_BLOCK_STACK];
+    int open_count = 0;
+    while (entry->token.type != TOKEN_EOF && entry->token.col > max_col) {
+        int col = entry->token.col;
+        while (open_count > 0 && SOURCE_UNIT_ENTRY(unit, open[open_count - 1])->token.col > col) {
+            int closed = open[--open_count];
+            SOURCE_UNIT_ENTRY(unit, closed)->next_dedent = index;
+        }
+        if (open_count < SKIP_BLOCK_STACK) open[open_count++] = index;
+        // A run recorded by an earlier skip holds nothing that could close an open token.
+        index = entry->next_dedent >= 0 ? entry->next_dedent : index + 1;
+        entry = (SourceUnitToken*)source_unit_token_at(unit, index);
+    }
+    for (int i = 0; i < open_count; ++i) SOURCE_UNIT_ENTRY(unit, open[i])->next_dedent = index;
+    return index;
+}
+
+void source_unit_init_lexer(SourceUnit* unit, Lexer* lexer) {
+    lexer->text = unit->text;
+    lexer->pos = 0;
+    lexer->current_char = unit->text_length > 0 ? unit->text[0] : '\0';
+    lexer->line = 1;
+    lexer->col = 1;
+    lexer->text_length = unit->text_length;
+    lexer->unit = unit;
+    lexer->token_index = 0;
+}
@@ -0,0 +1,127 @@
+// src_c/source_unit.h
+#ifndef ECHOC_SOURCE_UNIT_H
+#define ECHOC_SOURCE_UNIT_H
+
+#include "header.h" // Provides Token, Lexer, LexerState, SourceUnit forward declaration
+
+struct BytecodeChunk; // See bytecode_vm.h
+struct StringTemplate; // See string_template.h
+
+// A token lexed once from a SourceUnit, together with the lexer position
+// just past it so a cursor can continue without re-scanning characters.
+typedef struct SourceUnitToken {
+    Token token;    // Cached token (is_borrowed); the unit holds a reference to its interned value (see intern.h)
+    int start_pos;  // Offset of the token's first character
+    int end_pos;    // Lexer position right after the token
+    int end_line;
+    int end_col;
+    // Set by source_unit_resolve_frame for identifiers inside a function body.
+    int slot;                                // Frame slot of the identifier, or -1
+    int frame_size;                          // On a body's first token: slots in that body's frame
+    const struct SourceUnitToken* frame_owner; // First token of the body that assigned 'slot'
+    // Inline cache for an attribute name after '.' (see object_shape.c), valid for one shape.
+    uint64_t attr_shape_id;  // Shape the entry was filled for; 0 when empty
+    int attr_slot;           // Instance field slot, or -1 when the attribute is attr_class_value
+    Value* attr_class_value; // Class attribute or method found along the blueprint chain
+    Shape* attr_transition;  // For a store that adds the field: the shape it leads to
+    struct StringTemplate* string_template; // For a string literal: its compiled %{...} template, or NULL
+    char* literal_string;                   // For a literal without %{...}: its value, shared by every evaluation
+    // Block index (see source_unit_skip_block): the next token with a smaller column (or EOF),
+    // i.e. where the indented run starting here ends. -1 until a skip has scanned past it.
+    int next_dedent;
+} SourceUnitToken;
+
+#define SOURCE_UNIT_TOKEN_BLOCK 512
+
+// Cached entry 'index' (must be < unit->token_count).
+#define SOURCE_UNIT_ENTRY(unit, index) \
+    (&(unit)->token_blocks[(index) / SOURCE_UNIT_TOKEN_BLOCK][(index) % SOURCE_UNIT_TOKEN_BLOCK])
+
+// The parsed form of one module's source text. The text is tokenized once,
+// lazily and in source order (so lexical errors surface exactly when the
+// old lexer would have reached them), and every lexer that walks this text
+// reads tokens from the cache instead of re-scanning characters.
+// Functions defined in the module share the unit by reference.
+struct SourceUnit {
+    const char* text;    // Owned, NUL-terminated source
+    size_t text_length;
+    size_t mapped_length; // Nonzero when 'text' is a read-only mmap of the file (see source_unit_load_file)
+    int ref_count;
+
+    // Fixed-size blocks, never moved once allocated: tokens handed out by a
+    // cursor are borrowed pointers into them.
+    SourceUnitToken** token_blocks;
+    int token_count;
+    int block_count;
+    int block_capacity;
+    bool reached_eof;    // True once the EOF token has been cached
+    Lexer scan_lexer;    // Character lexer positioned after the last cached token
+
+    int* line_starts;    // Offset of the first character of each line (line N at index N-1)
+    int line_count;
+
+    struct BytecodeChunk** expr_chunks; // --vm: compiled expressions keyed by start token index
+    int expr_chunks_capacity;
+
+    // Persistent token cache (see unit_cache.h), set up by source_unit_load_file.
+    char* source_path;       // Absolute path of the cached file, or NULL when the unit is not cached
+    long long source_mtime;  // Modification time of the file when it was loaded
+    bool loaded_from_cache;  // Tokens came from the entry rather than the lexer
+
+    SourceUnit* next_loaded; // Link in interpreter->loaded_units_head
+};
+
+// Creates a unit that takes ownership of 'text' (malloc'd, NUL-terminated).
+// The returned unit has a reference count of 1.
+SourceUnit* source_unit_create(char* text, size_t text_length);
+
+// Creates a unit over the file at 'path'. On POSIX the file is mapped read-only, so the
+// text is shared with the page cache and never copied; otherwise it is read into memory.
+// If the persistent cache holds this exact file, the unit comes back already lexed.
+// On failure returns NULL with a message in 'error_message'.
+SourceUnit* source_unit_load_file(const char* path, char* error_message, size_t error_size);
+
+void source_unit_incref(SourceUnit* unit);
+
+// Drops a reference; frees the text and token cache (releasing its token values) when it reaches zero.
+void source_unit_decref(SourceUnit* unit);
+
+// Appends an uninitialized token entry to the cache and returns it (used when
+// filling a unit from the persistent cache; lexing appends through this too).
+SourceUnitToken* source_unit_append_entry(SourceUnit* unit);
+
+// Returns the cached token at 'index', lexing further into the text if needed.
+// Indices past the EOF token clamp to the EOF token.
+const SourceUnitToken* source_unit_token_at(SourceUnit* unit, int index);
+
+// Returns the index of the token get_next_token would produce when started at
+// text offset 'pos' (the first token starting at or after 'pos').
+int source_unit_token_index_at(SourceUnit* unit, int pos);
+
+// Returns the index of the already-lexed token starting at line/col, or -1.
+int source_unit_find_token(SourceUnit* unit, int line, int col);
+
+// Converts a text offset to its 1-based line/col in O(log lines).
+void source_unit_position_of(SourceUnit* unit, int pos, int* line, int* col);
+
+// Converts a 1-based line/col to a text offset in O(1); returns -1 if it is outside the text.
+int source_unit_offset_of(SourceUnit* unit, int line, int col);
+
+// Resolver pass for a function body spanning cached tokens [body_start, body_end).
+// Parameters get slots 0..param_count-1, then every other identifier read or written
+// in the body gets the next free slot; bodies of nested functions are left to their
+// own definitions. Returns the frame size (0 for an empty body). Idempotent: a body
+// that was already resolved returns its recorded size without rescanning.
+int source_unit_resolve_frame(SourceUnit* unit, int body_start, int body_end, const Parameter* params, int param_count);
+
+// Returns the index of the first token at or after 'index' whose column is <= max_col,
+// or of the EOF token: where skipping an untaken branch, a finished loop or a function
+// body indented past 'max_col' stops. The first skip over a block lexes and walks it
+// once, recording next_dedent for every token passed; later skips over any block in
+// that range follow those links, one hop per indentation level, instead of walking tokens.
+int source_unit_skip_block(SourceUnit* unit, int index, int max_col);
+
+// Initializes 'lexer' as a cursor over the unit's token stream.
+void source_unit_init_lexer(SourceUnit* unit, Lexer* lexer);
+
+#endif // ECHOC_SOURCE_UNIT_H
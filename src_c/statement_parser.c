@@ -6,12 +6,20 @@
 #include "value_utils.h"       // For value_to_string_representation, free_value_contents
 #include "module_loader.h"     // For module loading functions
 #include "dictionary.h"        // For dictionary_set
+#include "source_unit.h"       // For source_unit_incref/decref, source_unit_skip_block
+#include "object_shape.h"      // For object_get_field, object_set_field
+#include "packed_array.h"      // For packed_array_set, packed_array_to_array
+#include "arena.h"             // For the statement-scoped scratch arena
+#include "intern.h"            // For interned function and parameter names
+#include "string_value.h"      // For string values (length, hash, in-place append)
 
 #include <stdio.h>  // For printf, sprintf
 #include <string.h> // For strdup, strcmp
 #include <stdlib.h> // For free
 #include <math.h>   // For fmod in for loop
+#include <limits.h> // For LONG_MAX/LONG_MIN bounds of counted loops
 #include "interpreter.h" // For Coroutine struct and other interpreter specifics if needed by interpret_coroutine_body
+#include "coro_context.h" // For the coroutine stacks used by interpret_coroutine_body
 
 // Forward declarations for static functions within this file
 static StatementExecStatus interpret_let_statement(Interpreter* interpreter);
@@ -40,7 +48,18 @@ extern void add_to_ready_queue(Interpreter* interpreter, Coroutine* coro);
 extern void run_event_loop(Interpreter* interpreter); 
 // Forward declaration for a function from dictionary.c that is not in the header yet.
 extern Value* dictionary_try_get_value_ptr(Dictionary* dict, const char* key_str);
+static StatementExecStatus interpret_statement_dispatch(Interpreter* interpreter);
+
+// Temporaries the statement puts in the scratch arena are dropped when it completes.
 StatementExecStatus interpret_statement(Interpreter* interpreter) {
+    Arena* scratch = interpreter->scratch;
+    ArenaMark mark = arena_mark(scratch);
+    StatementExecStatus status = interpret_statement_dispatch(interpreter);
+    arena_release(scratch, mark);
+    return status;
+}
+
+static StatementExecStatus interpret_statement_dispatch(Interpreter* interpreter) {
     DEBUG_PRINTF("INTERPRET_STATEMENT: Token type: %s, value: '%s'. Current scope: %p",
                  token_type_to_string(interpreter->current_token->type), //
                  interpreter->current_token->value ? interpreter->current_token->value : "N/A", //
@@ -70,9 +89,7 @@ StatementExecStatus interpret_statement(Interpreter* interpreter) {
     } else if (interpreter->current_token->type == TOKEN_RETURN) {
         status = interpret_return_statement(interpreter);
     } else if (interpreter->current_token->type == TOKEN_LET) {
-        if ((status = interpret_let_statement(interpreter)) == STATEMENT_YIELDED_AWAIT) {
-            return status;
-        }
+        status = interpret_let_statement(interpreter);
     } else if (interpreter->current_token->type == TOKEN_IF) {
         status = interpret_if_statement(interpreter);
     } else if (interpreter->current_token->type == TOKEN_LOOP) {
@@ -149,11 +166,8 @@ static StatementExecStatus interpret_expression_statement(Interpreter* interpret
         return STATEMENT_PROPAGATE_FLAG; // Propagate exception
     }
 
-    // If not resuming, and the result of a standalone expression statement is a coroutine,
-    // print its representation. This avoids re-printing during a resume.
-    if ((!interpreter->current_executing_coroutine || interpreter->current_executing_coroutine->state != CORO_RESUMING) &&
-        (result.type == VAL_COROUTINE || result.type == VAL_GATHER_TASK))
-    {
+    // If the result of a standalone expression statement is a coroutine, print its representation.
+    if (result.type == VAL_COROUTINE || result.type == VAL_GATHER_TASK) {
         char* str_repr = value_to_string_representation(result, interpreter, first_token_in_expr);
         debug_aware_printf("%s\n", str_repr);
         fflush(stdout); // Ensure it prints before any potential warning on stderr
@@ -180,26 +194,21 @@ static StatementExecStatus interpret_expression_statement(Interpreter* interpret
 
     // An expression statement must be terminated by a colon.
     interpreter_eat(interpreter, TOKEN_COLON);
-    if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-        return STATEMENT_YIELDED_AWAIT;
-    }
     return STATEMENT_EXECUTED_OK;
 }
 // Helper function to perform the actual indexed assignment
 // target_container: The direct container (array or dict) to modify
 // final_index: The index/key to use on target_container
-// value_to_set: The value to assign (this function will deep_copy it if needed)
+// value_to_set: The value to assign; ownership passes to this function
 // error_token: For error reporting context
 // base_var_name: Name of the original variable for error messages
 void perform_indexed_assignment(Value* target_container, Value final_index, Value value_to_set, Token* error_token, const char* base_var_name) {
-    if (g_interpreter_for_error_reporting->prevent_side_effects) return; // Do not perform assignment during a fast-forward resume
-
     if (target_container->type == VAL_ARRAY) {
         if (final_index.type != VAL_INT) {
             g_interpreter_for_error_reporting->exception_is_active = 1;
             free_value_contents(g_interpreter_for_error_reporting->current_exception);
             g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
-            g_interpreter_for_error_reporting->current_exception.as.string_val = strdup("Array index for assignment must be an integer.");
+            g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create("Array index for assignment must be an integer.");
             if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
             g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
             // Cleanup values that were passed in and would normally be freed by caller if no error
@@ -217,7 +226,7 @@ void perform_indexed_assignment(Value* target_container, Value final_index, Valu
             g_interpreter_for_error_reporting->exception_is_active = 1;
             free_value_contents(g_interpreter_for_error_reporting->current_exception);
             g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
-            g_interpreter_for_error_reporting->current_exception.as.string_val = strdup(err_msg);
+            g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create(err_msg);
             if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
             g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
             // Cleanup values that were passed in and would normally be freed by caller if no error
@@ -225,24 +234,61 @@ void perform_indexed_assignment(Value* target_container, Value final_index, Valu
             return;
         }
         free_value_contents(arr->elements[effective_idx]); // Free old element
-        arr->elements[effective_idx] = value_deep_copy(value_to_set);
+        arr->elements[effective_idx] = value_to_set;
+    } else if (target_container->type == VAL_PACKED_ARRAY) {
+        PackedArray* packed = target_container->as.packed_array_val;
+        if (final_index.type != VAL_INT) {
+            g_interpreter_for_error_reporting->exception_is_active = 1;
+            free_value_contents(g_interpreter_for_error_reporting->current_exception);
+            g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
+            g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create("Array index for assignment must be an integer.");
+            if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
+            g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
+            free_value_contents(final_index); free_value_contents(value_to_set);
+            return;
+        }
+        long idx = final_index.as.integer;
+        long effective_idx = idx;
+        if (effective_idx < 0) effective_idx += packed->count;
+
+        if (effective_idx < 0 || effective_idx >= packed->count) {
+            char err_msg[150];
+            snprintf(err_msg, sizeof(err_msg), "Array assignment index %ld out of bounds for array '%s' (size %d).", idx, base_var_name, packed->count);
+            g_interpreter_for_error_reporting->exception_is_active = 1;
+            free_value_contents(g_interpreter_for_error_reporting->current_exception);
+            g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
+            g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create(err_msg);
+            if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
+            g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
+            free_value_contents(final_index); free_value_contents(value_to_set);
+            return;
+        }
+        if (!packed_array_set(packed, (int)effective_idx, value_to_set)) {
+            // A non-numeric element: the slot falls back to a generic array holding the same numbers.
+            Array* generic = packed_array_to_array(packed);
+            free_value_contents(*target_container);
+            target_container->type = VAL_ARRAY;
+            target_container->as.array_val = generic;
+            generic->elements[effective_idx] = value_to_set;
+        }
     } else if (target_container->type == VAL_DICT) {
         if (final_index.type != VAL_STRING) {
             g_interpreter_for_error_reporting->exception_is_active = 1;
             free_value_contents(g_interpreter_for_error_reporting->current_exception);
             g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
-            g_interpreter_for_error_reporting->current_exception.as.string_val = strdup("Dictionary key for assignment must be a string.");
+            g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create("Dictionary key for assignment must be a string.");
             if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
             g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
             free_value_contents(final_index); free_value_contents(value_to_set);
             return;
         }
-        dictionary_set(target_container->as.dict_val, final_index.as.string_val, value_to_set, error_token);
+        dictionary_set_hashed(target_container->as.dict_val, final_index.as.string_val, string_value_hash(final_index.as.string_val), value_to_set, error_token);
+        free_value_contents(value_to_set); // dictionary_set took its own reference
     } else if (target_container->type == VAL_TUPLE) {
         g_interpreter_for_error_reporting->exception_is_active = 1;
         free_value_contents(g_interpreter_for_error_reporting->current_exception);
         g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
-        g_interpreter_for_error_reporting->current_exception.as.string_val = strdup("Tuples are immutable and cannot be modified.");
+        g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create("Tuples are immutable and cannot be modified.");
         if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
         g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
         free_value_contents(final_index); free_value_contents(value_to_set);
@@ -253,14 +299,135 @@ void perform_indexed_assignment(Value* target_container, Value final_index, Valu
         g_interpreter_for_error_reporting->exception_is_active = 1;
         free_value_contents(g_interpreter_for_error_reporting->current_exception);
         g_interpreter_for_error_reporting->current_exception.type = VAL_STRING;
-        g_interpreter_for_error_reporting->current_exception.as.string_val = strdup(err_msg);
+        g_interpreter_for_error_reporting->current_exception.as.string_val = string_value_create(err_msg);
         if (g_interpreter_for_error_reporting->error_token) free_token(g_interpreter_for_error_reporting->error_token);
         g_interpreter_for_error_reporting->error_token = token_deep_copy(error_token);
         free_value_contents(final_index); free_value_contents(value_to_set);
         return;
     }
     free_value_contents(final_index); // final_index is consumed
-    // value_to_set is consumed by deep_copy or dictionary_set which makes its own copy
+}
+
+// Indices of a chained indexed 'let' up to (not including) the last one. They are
+// replayed once the RHS has been evaluated to un-share every container on the path.
+typedef struct {
+    Value* indices;
+    int count;
+    int capacity;
+} LetIndexPath;
+
+static void let_index_path_push(LetIndexPath* path, Value index, bool index_is_fresh) {
+    if (path->count == path->capacity) {
+        int new_capacity = path->capacity ? path->capacity * 2 : 4;
+        Value* new_indices = realloc(path->indices, new_capacity * sizeof(Value));
+        if (!new_indices) report_error("System", "Failed to grow index path for indexed assignment", NULL);
+        path->indices = new_indices;
+        path->capacity = new_capacity;
+    }
+    path->indices[path->count++] = index_is_fresh ? index : value_deep_copy(index);
+}
+
+static void let_index_path_free(LetIndexPath* path) {
+    for (int i = 0; i < path->count; ++i) free_value_contents(path->indices[i]);
+    free(path->indices);
+}
+
+// Assigns 'value' (borrowed) at root[path...][final_index]. The value is copied before
+// the path is made unique so that e.g. 'let: a[0] = a' stores the old 'a', not a cycle.
+static void let_assign_through_path(Value* root, LetIndexPath* path, Value final_index, Value value, Token* error_token, const char* base_var_name) {
+    Value owned_value = value_deep_copy(value);
+    Value* target_container = root ? value_make_path_unique(root, path->indices, path->count) : NULL;
+    if (!target_container) {
+        char err_msg[150];
+        snprintf(err_msg, sizeof(err_msg), "Collection '%s' changed while evaluating the assigned value.", base_var_name);
+        free_value_contents(owned_value); free_value_contents(final_index);
+        report_error("Runtime", err_msg, error_token);
+    }
+    perform_indexed_assignment(target_container, final_index, owned_value, error_token, base_var_name);
+}
+
+// 'let: s = s + a + b:' with s holding a string. The general path builds s + a, a full copy
+// of s, and copies the result into s again, so accumulating text in a loop is quadratic in
+// its length. When the right-hand side, read ahead on the cached tokens up to the
+// statement's ':', is only the target followed by '+' terms, each term is evaluated exactly
+// as interpret_additive_expr would and their text is appended to the variable's own buffer.
+// The target's string is held from before the first term, so a term that rebinds the
+// target does not change what is appended to, just as s + a + b reads s first.
+// Returns false, having consumed nothing, for any other statement.
+static bool let_append_to_string(Interpreter* interpreter, const Token* target_token) {
+    Lexer* lexer = interpreter->lexer;
+    Token* first = interpreter->current_token;
+    if (!lexer->unit || !first->is_borrowed || first->type != TOKEN_ID || strcmp(first->value, target_token->value) != 0) return false;
+    int index = lexer->token_index - 1;
+    if (index < 0 || index >= lexer->unit->token_count || &SOURCE_UNIT_ENTRY(lexer->unit, index)->token != first) return false;
+    if (source_unit_token_at(lexer->unit, index + 1)->token.type != TOKEN_PLUS) return false;
+
+    int depth = 0;
+    for (int i = index + 1;; i++) {
+        TokenType type = source_unit_token_at(lexer->unit, i)->token.type;
+        if (type == TOKEN_EOF || type == TOKEN_AWAIT) return false;
+        if (type == TOKEN_LPAREN || type == TOKEN_LBRACKET || type == TOKEN_LBRACE) depth++;
+        else if (type == TOKEN_RPAREN || type == TOKEN_RBRACKET || type == TOKEN_RBRACE) depth--;
+        else if (depth == 0) {
+            if (type == TOKEN_COLON) break;
+            // Anything else at the top level ('-', comparisons, 'and', '?', ...) binds looser
+            // than '+' or changes what the chain means, so leave it to the general path.
+            if (type != TOKEN_PLUS && type != TOKEN_MUL && type != TOKEN_DIV && type != TOKEN_MOD &&
+                type != TOKEN_POWER && type != TOKEN_DOT && type != TOKEN_ID && type != TOKEN_STRING &&
+                type != TOKEN_INTEGER && type != TOKEN_FLOAT && type != TOKEN_TRUE &&
+                type != TOKEN_FALSE && type != TOKEN_NULL) return false;
+        }
+        if (depth < 0) return false;
+    }
+    Value* target = symbol_table_get_token(interpreter->current_scope, target_token);
+    if (!target || target->type != VAL_STRING) return false;
+
+    interpreter_eat(interpreter, TOKEN_ID);
+    char* original = string_value_retain(target->as.string_val);
+    DynamicString tail;
+    ds_init(&tail, 64);
+    while (interpreter->current_token->type == TOKEN_PLUS) {
+        interpreter_eat(interpreter, TOKEN_PLUS);
+        ExprResult term = interpret_multiplicative_expr(interpreter);
+        if (interpreter->exception_is_active) {
+            if (term.is_freshly_created_container) free_value_contents(term.value);
+            string_value_release(original);
+            ds_free(&tail);
+            return true;
+        }
+        char number_buffer[256];
+        size_t text_length;
+        const char* text = value_concat_text(term.value, number_buffer, sizeof(number_buffer), &text_length);
+        if (!text) {
+            if (term.is_freshly_created_container) free_value_contents(term.value);
+            string_value_release(original);
+            ds_free(&tail);
+            report_error("Runtime", "Unsupported operand types for '+' operator.", (Token*)target_token);
+        }
+        ds_ensure_capacity(&tail, text_length);
+        memcpy(tail.buffer + tail.length, text, text_length + 1);
+        tail.length += text_length;
+        if (term.is_freshly_created_container) free_value_contents(term.value);
+    }
+    if (interpreter->current_token->type == TOKEN_COLON) {
+        // Look the variable up again: a term may have rebound it.
+        target = symbol_table_get_token(interpreter->current_scope, target_token);
+        if (target && target->type == VAL_STRING && target->as.string_val == original) {
+            string_value_release(original); // Unshared again unless something else took a reference
+            string_value_append(target, tail.buffer, tail.length, true);
+        } else {
+            // Rebound: the result is still the original text plus the terms. Appending to
+            // our reference copies it unless nothing else holds the original any more.
+            Value appended = { .type = VAL_STRING, .as.string_val = original };
+            string_value_append(&appended, tail.buffer, tail.length, false);
+            symbol_table_set_token(interpreter->current_scope, target_token, appended);
+            free_value_contents(appended);
+        }
+    } else { // The caller's interpreter_eat reports the malformed statement.
+        string_value_release(original);
+    }
+    ds_free(&tail);
+    return true;
 }
 
 static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
@@ -282,7 +449,7 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
         report_error("Syntax", "Expected variable name after 'let:'", target_name_token_for_error);
         free_token(target_name_token_for_error); // Free the copy before exiting
     }
-    char* var_name_str = strdup(target_name_token_for_error->value);
+    char* var_name_str = arena_strdup(interpreter->scratch, target_name_token_for_error->value);
     interpreter_eat(interpreter, TOKEN_ID);
 
     DEBUG_PRINTF("LET_STMT: Variable name: '%s'. Current token before assignment part: %s ('%s')",
@@ -292,17 +459,18 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
     // Handle 'let: self.attribute = value'
     if (strcmp(var_name_str, "self") == 0 && interpreter->current_token->type == TOKEN_DOT) { // Starts with self.
         if (!interpreter->current_self_object) {
-            free(var_name_str); free_token(target_name_token_for_error);
+            free_token(target_name_token_for_error);
             report_error("Runtime", "'self' can only be used within an instance method.", target_name_token_for_error); 
         }
         interpreter_eat(interpreter, TOKEN_DOT); // Eat '.'
         Token* attr_name_token = interpreter->current_token;
         if (attr_name_token->type != TOKEN_ID) {
             // attr_name_str not yet allocated
-            free(var_name_str); free_token(target_name_token_for_error);
+            free_token(target_name_token_for_error);
             report_error("Syntax", "Expected attribute name after 'self.'.", attr_name_token);
         } // attr_name_token is consumed by strdup or eat
-        char* attr_name_str = strdup(attr_name_token->value);
+        char* attr_name_str = arena_strdup(interpreter->scratch, attr_name_token->value);
+        const Token* attr_site = attr_name_token->is_borrowed ? attr_name_token : NULL; // Inline cache for self.attr = value
         interpreter_eat(interpreter, TOKEN_ID); // Eat attribute name
 
         DEBUG_PRINTF("LET_STMT (self): Attribute name: '%s'. Current token: %s ('%s')",
@@ -312,11 +480,11 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
 
         if (interpreter->current_token->type == TOKEN_LBRACKET) { // self.attribute[index] = value
             Object* self_obj = interpreter->current_self_object;
-            Value* base_container_val_ptr = symbol_table_get_local(self_obj->instance_attributes, attr_name_str);
+            Value* base_container_val_ptr = object_get_field(self_obj, attr_name_str);
             if (!base_container_val_ptr) {
                 // Could also check blueprint attributes if self.CLASS_ATTR[idx] was allowed (not currently supported this way)
                 char err_msg[200]; sprintf(err_msg, "Attribute '%s' not found on 'self' for indexed assignment.", attr_name_str); 
-                free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error); 
+                free_token(target_name_token_for_error);
                 report_error("Runtime", err_msg, target_name_token_for_error); // Use target_name_token_for_error as attr_name_token might be invalid
             }
 
@@ -325,6 +493,7 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
 
             Value final_index_for_assignment;
             bool final_index_is_fresh = false;
+            LetIndexPath index_path = { NULL, 0, 0 };
 
             while (interpreter->current_token->type == TOKEN_LBRACKET) {
                 parent_container_for_final_assignment = container_to_modify;
@@ -336,14 +505,10 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
 
                 if (interpreter->exception_is_active) {
                     if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                    let_index_path_free(&index_path);
+                    free_token(target_name_token_for_error);
                     return STATEMENT_PROPAGATE_FLAG;
                 } 
-                if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                    if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
-                    return STATEMENT_YIELDED_AWAIT;
-                }
                 interpreter_eat(interpreter, TOKEN_RBRACKET);
 
                 if (final_index_is_fresh) free_value_contents(final_index_for_assignment); // Free previous loop's final_index if it was fresh
@@ -358,7 +523,7 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
                 if (parent_container_for_final_assignment->type == VAL_ARRAY) {
                     if (current_loop_index.type != VAL_INT) {
                         if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                        free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                        free_token(target_name_token_for_error);
                         report_error("Runtime", "Array index must be an integer.", target_name_token_for_error);
                     }
                     long idx = current_loop_index.as.integer;
@@ -368,34 +533,34 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
                         char err_msg[150];
                         sprintf(err_msg, "Array index %ld out of bounds for array attribute '%s' (size %d).", idx, attr_name_str, parent_container_for_final_assignment->as.array_val->count);
                         if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                        free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                        free_token(target_name_token_for_error);
                         report_error("Runtime", err_msg, target_name_token_for_error);
                     }
                     container_to_modify = &parent_container_for_final_assignment->as.array_val->elements[effective_idx];
-                    if (current_loop_index_is_fresh) free_value_contents(current_loop_index); // Traversal index freed
+                    let_index_path_push(&index_path, current_loop_index, current_loop_index_is_fresh);
                     final_index_is_fresh = false; // Mark as consumed for next iteration or if loop ends
                 } else if (parent_container_for_final_assignment->type == VAL_DICT) {
                     if (current_loop_index.type != VAL_STRING) {
                         if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                        free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                        free_token(target_name_token_for_error);
                         report_error("Runtime", "Dictionary key must be a string.", target_name_token_for_error);
                     }
                     
-                    Value* next_container_ptr = dictionary_try_get_value_ptr(parent_container_for_final_assignment->as.dict_val, current_loop_index.as.string_val);
+                    Value* next_container_ptr = dictionary_try_get_value_ptr_hashed(parent_container_for_final_assignment->as.dict_val, current_loop_index.as.string_val, string_value_hash(current_loop_index.as.string_val));
                     if (!next_container_ptr) {
                         char err_msg[200];
                         sprintf(err_msg, "Key '%s' not found in dictionary attribute '%s' during chained assignment.", current_loop_index.as.string_val, attr_name_str);
                         if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                        free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                        free_token(target_name_token_for_error);
                         report_error("Runtime", err_msg, target_name_token_for_error);
                     }
                     container_to_modify = next_container_ptr; // This is a pointer to the Value inside the dictionary.
-                    if (current_loop_index_is_fresh) free_value_contents(current_loop_index); // Traversal index freed
+                    let_index_path_push(&index_path, current_loop_index, current_loop_index_is_fresh);
                     final_index_is_fresh = false; // Mark as consumed
                 } else {
                     // This is the new final else block for all other unsupported types.
                     if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                    free_token(target_name_token_for_error);
                     report_error("Runtime", "Chained indexed assignment is only supported for nested arrays and dictionaries.", target_name_token_for_error);
                 }
             }
@@ -407,35 +572,21 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
             ExprResult rhs_res = interpret_expression(interpreter);
             Value val_to_set = rhs_res.value;
             
-            if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                DEBUG_PRINTF("LET_STMT (self.attr[...]): RHS yielded. var_name='%s', attr_name='%s'. Pending.", var_name_str, attr_name_str);
-                status = STATEMENT_YIELDED_AWAIT;
-                if(final_index_is_fresh) free_value_contents(final_index_for_assignment);
-                if(rhs_res.is_freshly_created_container) free_value_contents(val_to_set); // RHS value will be re-evaluated
-                free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
-                return status;
-            }
             if (interpreter->exception_is_active) {
                 if(final_index_is_fresh) free_value_contents(final_index_for_assignment);
                 if(rhs_res.is_freshly_created_container) free_value_contents(val_to_set);
-                free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+                let_index_path_free(&index_path);
+                free_token(target_name_token_for_error);
                 return STATEMENT_PROPAGATE_FLAG;
             }
 
-            if (interpreter->is_dummy_resume_value) {
-                interpreter->is_dummy_resume_value = false; // Consume flag
-                if (final_index_is_fresh) free_value_contents(final_index_for_assignment); // Clean up index
-            } else {
-                if (!interpreter->prevent_side_effects) {
-                    perform_indexed_assignment(parent_container_for_final_assignment, final_index_for_assignment, val_to_set, target_name_token_for_error, attr_name_str);
-                } else if (final_index_is_fresh) {
-                    // If skipping assignment, we must still free the fresh index value.
-                    free_value_contents(final_index_for_assignment);
-                }
-            }
+            // Look the attribute up again: the RHS may have replaced it.
+            Value* base_after_rhs = object_get_field(interpreter->current_self_object, attr_name_str);
+            let_assign_through_path(base_after_rhs, &index_path, final_index_for_assignment, val_to_set, target_name_token_for_error, attr_name_str);
 
-            // Always free the RHS value if it was a temporary, as it was either consumed by assignment or unused.
-            if (rhs_res.is_freshly_created_container) free_value_contents(val_to_set); // perform_indexed_assignment copies or consumes
+            let_index_path_free(&index_path);
+            // Always free the RHS value if it was a temporary; the assignment took its own reference.
+            if (rhs_res.is_freshly_created_container) free_value_contents(val_to_set);
         } else if (interpreter->current_token->type == TOKEN_ASSIGN) { // self.attribute = value
             interpreter_eat(interpreter, TOKEN_ASSIGN); 
             DEBUG_PRINTF("LET_STMT (self.attr): About to parse RHS. Current token: %s ('%s')",
@@ -444,46 +595,28 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
             ExprResult val_expr_res = interpret_expression(interpreter);
             Value val_to_assign = val_expr_res.value;
             if (interpreter->exception_is_active) {
-                free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error); if(val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
+                free_token(target_name_token_for_error); if(val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
                 return STATEMENT_PROPAGATE_FLAG;
             }
-            if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                DEBUG_PRINTF("LET_STMT (self.attr): RHS yielded for await. var_name='%s', attr_name='%s'. Pending assignment.",
-                             var_name_str, attr_name_str); // Log action
-                status = STATEMENT_YIELDED_AWAIT;
-                if(val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign); // RHS value will be re-evaluated
-                free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
-                return status;
-            } else if (interpreter->is_dummy_resume_value) {
-                interpreter->is_dummy_resume_value = false; // Consume flag
-                if (val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
-            } else {
-                if (!interpreter->prevent_side_effects) {
-                    DEBUG_PRINTF("LET_STMT (self.attr): Assigning to self attribute '%s'. Value type: %d", attr_name_str, val_to_assign.type);
-                    symbol_table_define(interpreter->current_self_object->instance_attributes, attr_name_str, val_to_assign);
-                }
-                if (val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign); // symbol_table_set made a deep copy
-            }
+            DEBUG_PRINTF("LET_STMT (self.attr): Assigning to self attribute '%s'. Value type: %d", attr_name_str, val_to_assign.type);
+            object_set_field(interpreter->current_self_object, attr_site, attr_name_str, val_to_assign);
+            if (val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign); // object_set_field made a deep copy
         } else {
-            free(var_name_str); free(attr_name_str); free_token(target_name_token_for_error);
+            free_token(target_name_token_for_error);
             report_error_unexpected_token(interpreter, "'[' for indexed assignment or '=' for attribute assignment after 'self.attribute'");
         }
-        free(attr_name_str); free(var_name_str);
         free_token(target_name_token_for_error); // Free the copied token
         interpreter_eat(interpreter, TOKEN_COLON); 
-        if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-            return STATEMENT_YIELDED_AWAIT;
-        }
         return STATEMENT_EXECUTED_OK;
     }
-    Value* current_val_ptr = symbol_table_get(interpreter->current_scope, var_name_str);
+    Value* current_val_ptr = symbol_table_get_token(interpreter->current_scope, target_name_token_for_error);
 
     // This block replaces the old logic for indexed assignment, including the problematic `while` loop.
     if (interpreter->current_token->type == TOKEN_LBRACKET) { // Indexed assignment var[idx1][idx2]... = value
         if (!current_val_ptr) {
             char err_msg[150];
             sprintf(err_msg, "Variable '%s' must be an existing collection for indexed assignment with 'let:'.", var_name_str);
-            free(var_name_str); free_token(target_name_token_for_error);
+            free_token(target_name_token_for_error);
             report_error("Runtime", err_msg, target_name_token_for_error);
         }
 
@@ -492,6 +625,7 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
 
         Value final_index_for_assignment;
         bool final_index_is_fresh = false;
+        LetIndexPath index_path = { NULL, 0, 0 };
 
         while (interpreter->current_token->type == TOKEN_LBRACKET) {
             parent_container_for_final_assignment = container_to_modify;
@@ -503,14 +637,10 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
 
             if (interpreter->exception_is_active) {
                 if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                free(var_name_str); free_token(target_name_token_for_error);
+                let_index_path_free(&index_path);
+                free_token(target_name_token_for_error);
                 return STATEMENT_PROPAGATE_FLAG;
             } 
-            if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                free(var_name_str); free_token(target_name_token_for_error);
-                return STATEMENT_YIELDED_AWAIT;
-            }
             interpreter_eat(interpreter, TOKEN_RBRACKET);
 
             if (final_index_is_fresh) free_value_contents(final_index_for_assignment);
@@ -525,7 +655,7 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
             if (parent_container_for_final_assignment->type == VAL_ARRAY) {
                 if (current_loop_index.type != VAL_INT) {
                     if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free_token(target_name_token_for_error);
+                    free_token(target_name_token_for_error);
                     report_error("Runtime", "Array index must be an integer.", target_name_token_for_error);
                 }
                 long idx = current_loop_index.as.integer;
@@ -535,33 +665,33 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
                     char err_msg[150];
                     snprintf(err_msg, sizeof(err_msg), "Array index %ld out of bounds for array '%s' (size %d).", idx, var_name_str, parent_container_for_final_assignment->as.array_val->count);
                     if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free_token(target_name_token_for_error);
+                    free_token(target_name_token_for_error);
                     report_error("Runtime", err_msg, target_name_token_for_error);
                 }
                 container_to_modify = &parent_container_for_final_assignment->as.array_val->elements[effective_idx];
-                if (current_loop_index_is_fresh) free_value_contents(current_loop_index); // Traversal index freed
+                let_index_path_push(&index_path, current_loop_index, current_loop_index_is_fresh);
                 final_index_is_fresh = false; 
             } else if (parent_container_for_final_assignment->type == VAL_DICT) {
                 if (current_loop_index.type != VAL_STRING) {
                     if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free_token(target_name_token_for_error);
+                    free_token(target_name_token_for_error);
                     report_error("Runtime", "Dictionary key must be a string.", target_name_token_for_error);
                 }
                 
-                Value* next_container_ptr = dictionary_try_get_value_ptr(parent_container_for_final_assignment->as.dict_val, current_loop_index.as.string_val);
+                Value* next_container_ptr = dictionary_try_get_value_ptr_hashed(parent_container_for_final_assignment->as.dict_val, current_loop_index.as.string_val, string_value_hash(current_loop_index.as.string_val));
                 if (!next_container_ptr) {
                     char err_msg[200];
                     sprintf(err_msg, "Key '%s' not found in dictionary variable '%s' during chained assignment.", current_loop_index.as.string_val, var_name_str);
                     if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                    free(var_name_str); free_token(target_name_token_for_error);
+                    free_token(target_name_token_for_error);
                     report_error("Runtime", err_msg, target_name_token_for_error);
                 }
                 container_to_modify = next_container_ptr;
-                if (current_loop_index_is_fresh) free_value_contents(current_loop_index);
+                let_index_path_push(&index_path, current_loop_index, current_loop_index_is_fresh);
                 final_index_is_fresh = false;
             } else {
                 if(current_loop_index_is_fresh) free_value_contents(current_loop_index);
-                free(var_name_str); free_token(target_name_token_for_error);
+                free_token(target_name_token_for_error);
                 report_error("Runtime", "Chained indexed assignment is only supported for nested arrays and dictionaries.", target_name_token_for_error);
             }
         }
@@ -573,33 +703,24 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
         if (interpreter->exception_is_active) {
             if(final_index_is_fresh) free_value_contents(final_index_for_assignment);
             if(new_val_res.is_freshly_created_container) free_value_contents(new_value_to_assign);
-            free(var_name_str); free_token(target_name_token_for_error);
+            let_index_path_free(&index_path);
+            free_token(target_name_token_for_error);
             return STATEMENT_PROPAGATE_FLAG;
         } 
-        if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-            DEBUG_PRINTF("LET_STMT (indexed): RHS yielded for await. var_name='%s'. Pending assignment.", var_name_str);
-            status = STATEMENT_YIELDED_AWAIT;
-            if(final_index_is_fresh) free_value_contents(final_index_for_assignment);
-            if(new_val_res.is_freshly_created_container) free_value_contents(new_value_to_assign); // RHS value will be re-evaluated
-            free(var_name_str);
-            free_token(target_name_token_for_error);
-            return status;
-        }
-        if (interpreter->is_dummy_resume_value) {
-            interpreter->is_dummy_resume_value = false; // Consume flag
-            if (final_index_is_fresh) free_value_contents(final_index_for_assignment);
-        } else {
-            if (!interpreter->prevent_side_effects) {
-                perform_indexed_assignment(parent_container_for_final_assignment, final_index_for_assignment, new_value_to_assign, target_name_token_for_error, var_name_str);
-            } else if (final_index_is_fresh) {
-                // If skipping assignment, we must still free the fresh index value.
-                free_value_contents(final_index_for_assignment);
-            }
-        }
+        // Look the variable up again: the RHS may have rebound it.
+        Value* base_after_rhs = symbol_table_get_token(interpreter->current_scope, target_name_token_for_error);
+        let_assign_through_path(base_after_rhs, &index_path, final_index_for_assignment, new_value_to_assign, target_name_token_for_error, var_name_str);
+        let_index_path_free(&index_path);
         // Always free the RHS value if it was temporary
         if (new_val_res.is_freshly_created_container) free_value_contents(new_value_to_assign);
     } else if (interpreter->current_token->type == TOKEN_ASSIGN) { // Simple assignment
         interpreter_eat(interpreter, TOKEN_ASSIGN);
+        if (let_append_to_string(interpreter, target_name_token_for_error)) {
+            free_token(target_name_token_for_error);
+            if (interpreter->exception_is_active) return STATEMENT_PROPAGATE_FLAG;
+            interpreter_eat(interpreter, TOKEN_COLON);
+            return status;
+        }
 
         DEBUG_PRINTF("LET_STMT_BEFORE_EXPR: Current token before interpret_expression: %s ('%s')",
                      token_type_to_string(interpreter->current_token->type),
@@ -615,40 +736,29 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
                     token_type_to_string(interpreter->current_token->type),
                     interpreter->current_token->value ? interpreter->current_token->value : "N/A");
         
+#ifdef DEBUG_ECHOC
         char* val_to_assign_str = value_to_string_representation(val_to_assign, interpreter, target_name_token_for_error);
         DEBUG_PRINTF("LET_STMT (simple) AFTER_EXPR: val_to_assign (type %d, fresh: %d): %s. coro_state: %d",
                      val_to_assign.type, val_expr_res.is_freshly_created_container, val_to_assign_str ? val_to_assign_str : "NULL_REPR", interpreter->current_executing_coroutine ? (int)interpreter->current_executing_coroutine->state : -1);
         free(val_to_assign_str);
+#endif
 
-        if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-            // --- YIELD PATH ---
-            // The expression on the RHS is yielding right now. We must suspend this statement.
-            DEBUG_PRINTF("LET_STMT (simple): RHS yielded for await. var_name='%s'. Pending assignment.", var_name_str);
-            status = STATEMENT_YIELDED_AWAIT;
-            // The RHS value will be re-evaluated on resume, so free any temporary value now.
-            if(val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
-            free(var_name_str);
+        if (interpreter->exception_is_active) {
             free_token(target_name_token_for_error);
-            return status;
+            if(val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
+            return STATEMENT_PROPAGATE_FLAG;
+        }
+        DEBUG_PRINTF("LET_STMT (simple): var_name='%s'. Assigning.", var_name_str);
+        Value* existing = val_expr_res.is_freshly_created_container
+            ? symbol_table_get_token(interpreter->current_scope, target_name_token_for_error) : NULL;
+        if (existing) {
+            // A temporary is moved into the variable instead of being copied and then freed.
+            free_value_contents(*existing);
+            *existing = val_to_assign;
         } else {
-            // --- NORMAL SYNC PATH ---
-            // The expression on the RHS was synchronous and did not yield.
-            if (interpreter->exception_is_active) { // Check for exception only in sync path after expr eval
-                free(var_name_str); free_token(target_name_token_for_error);
-                if(val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
-                return STATEMENT_PROPAGATE_FLAG;
-            }
-            if (interpreter->is_dummy_resume_value) {
-                interpreter->is_dummy_resume_value = false; // Consume flag
-                if (val_expr_res.is_freshly_created_container) free_value_contents(val_to_assign);
-            } else {
-                if (!interpreter->prevent_side_effects) {
-                    DEBUG_PRINTF("LET_STMT (simple) SYNC/RESUME: var_name='%s'. Assigning.", var_name_str);
-                    symbol_table_set(interpreter->current_scope, var_name_str, val_to_assign);
-                }
-                if (val_expr_res.is_freshly_created_container) {
-                    free_value_contents(val_to_assign); // symbol_table_set made a deep copy
-                }
+            symbol_table_set_token(interpreter->current_scope, target_name_token_for_error, val_to_assign);
+            if (val_expr_res.is_freshly_created_container) {
+                free_value_contents(val_to_assign); // symbol_table_set made a deep copy
             }
         }
 
@@ -656,11 +766,10 @@ static StatementExecStatus interpret_let_statement(Interpreter* interpreter) {
         char err_msg[200];
         snprintf(err_msg, sizeof(err_msg), "Expected '[' for indexed assignment or '=' for simple assignment after variable name '%s', but got %s.",
                 var_name_str, token_type_to_string(interpreter->current_token->type));
-        free(var_name_str); free_token(target_name_token_for_error);
+        free_token(target_name_token_for_error);
         report_error("Syntax", err_msg, interpreter->current_token);
     }
 
-    free(var_name_str);
     // Always free target_name_token_for_error as it's local to this call.
     free_token(target_name_token_for_error);
     DEBUG_PRINTF("LET_STMT_BEFORE_FINAL_COLON: Current token: %s ('%s')",
@@ -712,8 +821,27 @@ static StatementExecStatus interpret_block_statement(Interpreter* interpreter) {
     return status; // Should be STATEMENT_EXECUTED_OK if reached here
 }
 
+// Moves the cursor to the first token at or left of 'max_col' (or EOF) in one jump through
+// the unit's block index (see source_unit_skip_block). Returns false, without moving, when
+// the current token is not the cursor's cached token; callers then skip token by token.
+static bool jump_past_block(Interpreter* interpreter, int max_col) {
+    Lexer* lexer = interpreter->lexer;
+    if (!lexer->unit || !interpreter->current_token->is_borrowed) return false;
+    // The cursor does not advance past EOF, so only then is token_index the current token.
+    int index = interpreter->current_token->type == TOKEN_EOF ? lexer->token_index : lexer->token_index - 1;
+    if (index < 0 || index >= lexer->unit->token_count ||
+        &SOURCE_UNIT_ENTRY(lexer->unit, index)->token != interpreter->current_token) return false;
+    int target = source_unit_skip_block(lexer->unit, index, max_col);
+    if (target != index) {
+        lexer->token_index = target;
+        interpreter->current_token = get_next_token(lexer);
+    }
+    return true;
+}
+
 // New implementation for skip_statements_in_branch
 static void skip_statements_in_branch(Interpreter* interpreter, int start_col) {
+    if (jump_past_block(interpreter, start_col)) return;
 
     while (interpreter->current_token->type != TOKEN_EOF) {
         if (interpreter->current_token->col <= start_col) {
@@ -727,6 +855,13 @@ static void skip_statements_in_branch(Interpreter* interpreter, int start_col) {
 
 static void skip_to_loop_end(Interpreter* interpreter, int target_loop_col) {
     Token* last_token_before_eof_skip = interpreter->current_token;
+    if (jump_past_block(interpreter, target_loop_col)) {
+        if (interpreter->current_token->type != TOKEN_EOF) return;
+        if (interpreter->current_token != last_token_before_eof_skip) { // The cursor sits on EOF, right after the last skipped token
+            last_token_before_eof_skip = &SOURCE_UNIT_ENTRY(interpreter->lexer->unit, interpreter->lexer->token_index - 1)->token;
+        }
+        report_error("Syntax", "Unexpected EOF while skipping to loop end. Missing block terminator?", last_token_before_eof_skip);
+    }
 
     while(interpreter->current_token->type != TOKEN_EOF) {
         if (interpreter->current_token->col <= target_loop_col) {
@@ -779,12 +914,7 @@ static StatementExecStatus execute_statements_in_controlled_block(Interpreter* i
 
         StatementExecStatus status = interpret_statement(interpreter);
 
-        if (status == STATEMENT_YIELDED_AWAIT) {
-            // If a statement yields, just propagate the status up.
-            // Do NOT skip the rest of the block.
-            if (last_token_before_terminator_or_eof) free_token(last_token_before_terminator_or_eof);
-            return status;
-        } else if (status != STATEMENT_EXECUTED_OK) {
+        if (status != STATEMENT_EXECUTED_OK) {
             // For break, continue, return, exception, we DO skip the rest of the block.
             skip_statements_in_branch(interpreter, start_col);
             if (last_token_before_terminator_or_eof) {
@@ -897,11 +1027,6 @@ static StatementExecStatus interpret_if_statement(Interpreter* interpreter) { //
         free_token(if_keyword_token_for_context);
         return STATEMENT_PROPAGATE_FLAG;
     }
-    if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-        if (cond_res.is_freshly_created_container) free_value_contents(cond_res.value);
-        free_token(if_keyword_token_for_context);
-        return STATEMENT_YIELDED_AWAIT;
-    }
 
     int condition_line = interpreter->current_token->line;
     interpreter_eat(interpreter, TOKEN_COLON);
@@ -918,11 +1043,6 @@ static StatementExecStatus interpret_if_statement(Interpreter* interpreter) { //
     if (value_is_truthy(cond_res.value)) {
         branch_taken = true;
         status = execute_statements_in_controlled_block(interpreter, if_col, "if", TOKEN_ELIF, TOKEN_ELSE, TOKEN_EOF);
-		if (status == STATEMENT_YIELDED_AWAIT) {
-			free_token(if_keyword_token_for_context);
-			if (cond_res.is_freshly_created_container) free_value_contents(cond_res.value);
-			return STATEMENT_YIELDED_AWAIT;
-		}
     } else {
         skip_statements_in_branch(interpreter, if_col);
     }
@@ -945,10 +1065,10 @@ static StatementExecStatus interpret_if_statement(Interpreter* interpreter) { //
         interpreter_eat(interpreter, TOKEN_ELIF);
         interpreter_eat(interpreter, TOKEN_COLON);
         ExprResult elif_cond_res = interpret_expression(interpreter);
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             if (elif_cond_res.is_freshly_created_container) free_value_contents(elif_cond_res.value);
             free_token(elif_token_for_error); free_token(if_keyword_token_for_context);
-            return interpreter->exception_is_active ? STATEMENT_PROPAGATE_FLAG : STATEMENT_YIELDED_AWAIT;
+            return STATEMENT_PROPAGATE_FLAG;
         }
         int elif_cond_line = interpreter->current_token->line;
         interpreter_eat(interpreter, TOKEN_COLON);
@@ -963,12 +1083,6 @@ static StatementExecStatus interpret_if_statement(Interpreter* interpreter) { //
         if (value_is_truthy(elif_cond_res.value)) {
             branch_taken = true;
             status = execute_statements_in_controlled_block(interpreter, if_col, "elif", TOKEN_ELIF, TOKEN_ELSE, TOKEN_EOF);
-			if (status == STATEMENT_YIELDED_AWAIT) {
-				if (elif_cond_res.is_freshly_created_container) free_value_contents(elif_cond_res.value);
-				free_token(elif_token_for_error);
-				free_token(if_keyword_token_for_context);
-				return STATEMENT_YIELDED_AWAIT;
-			}
         } else {
             skip_statements_in_branch(interpreter, if_col);
         }
@@ -991,11 +1105,6 @@ static StatementExecStatus interpret_if_statement(Interpreter* interpreter) { //
             report_error("Syntax", "Expected an indented block after 'else' statement.", else_token_for_error);
         }
         status = execute_statements_in_controlled_block(interpreter, if_col, "else", TOKEN_EOF, TOKEN_EOF, TOKEN_EOF);
-		if (status == STATEMENT_YIELDED_AWAIT) {
-			free_token(else_token_for_error);
-			free_token(if_keyword_token_for_context);
-			return STATEMENT_YIELDED_AWAIT;
-		}
         free_token(else_token_for_error);
     }
 
@@ -1043,15 +1152,12 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
     if (interpreter->current_token->type != TOKEN_ID) {
         report_error("Syntax", "Expected function name after 'funct:'.", interpreter->current_token);
     }
-    char* func_name_str = strdup(interpreter->current_token->value);
-    if (!func_name_str) {
-        report_error("System", "Failed to strdup function name.", funct_token_original_ref);
-    }
+    const char* func_name_str = intern_acquire(interpreter->current_token->value);
     interpreter_eat(interpreter, TOKEN_ID);
 
     Function* new_func = calloc(1, sizeof(Function));
     if (!new_func) {
-        free(func_name_str);
+        intern_release(func_name_str);
         report_error("System", "Failed to allocate memory for Function struct.", funct_token_original_ref);
     }
 
@@ -1062,10 +1168,9 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
     new_func->param_count = 0;
     new_func->is_async = is_async_param;
     new_func->definition_scope = interpreter->current_scope; // Lexical scope
-    // Point to the lexer's current text; value_deep_copy will strdup it for the stored version.
-    new_func->source_text_owned_copy = (char*)interpreter->lexer->text; // Cast away const for temporary assignment
-    new_func->source_text_length = interpreter->lexer->text_length;
-    new_func->is_source_owner = false; // This temporary Function struct does not own the source text yet.
+    // Share the module's parsed source; every copy of the function holds a reference to it.
+    new_func->source_unit = interpreter->lexer->unit;
+    source_unit_incref(new_func->source_unit);
     new_func->body_end_token_original_line = -1; // Initialize to -1, meaning not pre-scanned
     new_func->body_end_token_original_col = -1; // Initialize to -1
 
@@ -1074,8 +1179,8 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
     if (interpreter->current_token->type != TOKEN_RPAREN) {
         new_func->params = malloc(param_capacity * sizeof(Parameter));
         if (!new_func->params && param_capacity > 0) {
-            free(new_func->name);
-            // new_func->source_text_owned_copy is not owned here
+            intern_release(new_func->name);
+            source_unit_decref(new_func->source_unit);
             free(new_func);
             report_error("System", "Failed to alloc params for func def.", funct_token_original_ref);
         }
@@ -1086,10 +1191,10 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
                 Parameter* new_params_ptr = realloc(new_func->params, param_capacity * sizeof(Parameter));
                 if (!new_params_ptr) {
                     // Proper cleanup of existing new_func->params elements would be needed here
-                    free(new_func->name);
+                    intern_release(new_func->name);
                     if (new_func->params) { // Free existing params if realloc fails
                         for(int k=0; k<new_func->param_count; ++k) {
-                            free(new_func->params[k].name);
+                            intern_release(new_func->params[k].name);
                             if (new_func->params[k].default_value) {
                                 free_value_contents(*(new_func->params[k].default_value));
                                 free(new_func->params[k].default_value);
@@ -1097,7 +1202,7 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
                         }
                         free(new_func->params);
                     }
-                    // new_func->source_text_owned_copy is not owned here
+                    source_unit_decref(new_func->source_unit);
                     free(new_func);
                     report_error("System", "Failed to realloc params for function definition.", interpreter->current_token);
                 }
@@ -1106,22 +1211,7 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
             if (interpreter->current_token->type != TOKEN_ID) {
                 report_error("Syntax", "Expected parameter name.", interpreter->current_token);
             }
-            new_func->params[new_func->param_count].name = strdup(interpreter->current_token->value);
-            if (!new_func->params[new_func->param_count].name) {
-                // Full cleanup
-                for(int k=0; k<new_func->param_count; ++k) { // Free previously allocated param names
-                    free(new_func->params[k].name);
-                    if (new_func->params[k].default_value) { // And their default values
-                        free_value_contents(*(new_func->params[k].default_value));
-                        free(new_func->params[k].default_value);
-                    }
-                }
-                free(new_func->params);
-                free(new_func->name);
-                    // new_func->source_text_owned_copy is not owned here
-                free(new_func);
-                report_error("System", "Failed to strdup parameter name.", interpreter->current_token);
-            }
+            new_func->params[new_func->param_count].name = intern_acquire(interpreter->current_token->value);
 
             new_func->params[new_func->param_count].default_value = NULL;
             interpreter_eat(interpreter, TOKEN_ID);
@@ -1131,11 +1221,11 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
                 new_func->params[new_func->param_count].default_value = malloc(sizeof(Value));
                 if (!new_func->params[new_func->param_count].default_value) {
                     // Full cleanup for current and previous params
-                    free(new_func->params[new_func->param_count].name);
-                    for(int k=0; k<new_func->param_count; ++k) { free(new_func->params[k].name); /* free default_value if set */ }
+                    intern_release(new_func->params[new_func->param_count].name);
+                    for(int k=0; k<new_func->param_count; ++k) { intern_release(new_func->params[k].name); /* free default_value if set */ }
                     free(new_func->params);
-                    free(new_func->name);
-                    // new_func->source_text_owned_copy is not owned here
+                    intern_release(new_func->name);
+                    source_unit_decref(new_func->source_unit);
                     free(new_func);
                     report_error("System", "Failed to alloc memory for default param value.", interpreter->current_token);
                 }
@@ -1165,10 +1255,10 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
     // If it's not, it's a syntax error (missing body).
     if (interpreter->current_token->col <= funct_def_col) {
         // Cleanup before error reporting
-        free(new_func->name);
+        intern_release(new_func->name);
         if (new_func->params) {
             for (int i = 0; i < new_func->param_count; ++i) {
-                free(new_func->params[i].name);
+                intern_release(new_func->params[i].name);
                 if (new_func->params[i].default_value) {
                     free_value_contents(*(new_func->params[i].default_value));
                     free(new_func->params[i].default_value);
@@ -1196,7 +1286,7 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
                                                                  interpreter->current_token->line,
                                                                  interpreter->current_token->col,
                                                                  interpreter->current_token);
-        new_func->body_start_state = absolute_body_start_state; // Store absolute for now, adjust when source_text_owned_copy is made
+        new_func->body_start_state = absolute_body_start_state; // Points into the shared source unit
     } else { // Empty function body
         new_func->body_start_state = get_lexer_state_for_token_start(interpreter->lexer, interpreter->current_token->line, interpreter->current_token->col, interpreter->current_token); // Points to 'end'
     }
@@ -1204,6 +1294,7 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
     // The new logic: skip tokens until indentation is less than or equal to funct_def_col
     // This assumes the function body is always indented by 4 spaces.
     int expected_body_indent = funct_def_col + 4;
+    jump_past_block(interpreter, expected_body_indent - 1); // The loop below then only runs for uncached tokens
     while (interpreter->current_token->type != TOKEN_EOF &&
            interpreter->current_token->col >= expected_body_indent) {
         // If the current token is at the same indentation level as the function definition,
@@ -1216,6 +1307,16 @@ static void interpret_funct_statement(Interpreter* interpreter, int statement_st
 
     // The current_token is now the first token *after* the function body, at an indentation
     // less than or equal to the function definition's column.
+
+    // Resolve the body's locals and parameters to frame slots (see scope_attach_frame).
+    if (interpreter->lexer->unit && new_func->body_start_state.token_index >= 0) {
+        int body_start = new_func->body_start_state.token_index;
+        int body_end = interpreter->lexer->token_index; // Index of current_token (the cursor does not advance past EOF)
+        if (interpreter->current_token->type != TOKEN_EOF) body_end--;
+        new_func->frame_size = source_unit_resolve_frame(interpreter->lexer->unit, body_start, body_end,
+                                                         new_func->params, new_func->param_count);
+        if (new_func->frame_size > 0) new_func->frame_owner = SOURCE_UNIT_ENTRY(interpreter->lexer->unit, body_start);
+    }
     Value func_val; func_val.type = VAL_FUNCTION; func_val.as.function_val = new_func;
     symbol_table_define(interpreter->current_scope, new_func->name, func_val); // This makes a deep copy for the symbol table.
 
@@ -1255,12 +1356,12 @@ static StatementExecStatus interpret_return_statement(Interpreter* interpreter)
         }
         results[result_count] = interpret_expression(interpreter);
 
-        if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->exception_is_active) {
             for (int i = 0; i <= result_count; ++i) {
                 if (results[i].is_freshly_created_container) free_value_contents(results[i].value);
             }
             free_token(return_keyword_token);
-            return interpreter->exception_is_active ? STATEMENT_PROPAGATE_FLAG : STATEMENT_YIELDED_AWAIT;
+            return STATEMENT_PROPAGATE_FLAG;
         }
         result_count++;
 
@@ -1281,6 +1382,7 @@ static StatementExecStatus interpret_return_statement(Interpreter* interpreter)
         Tuple* tuple = malloc(sizeof(Tuple));
         if (!tuple) report_error("System", "Failed to allocate memory for return tuple.", return_keyword_token);
         tuple->count = result_count;
+        tuple->ref_count = 1;
         tuple->elements = malloc(result_count * sizeof(Value));
         if (!tuple->elements) { free(tuple); report_error("System", "Failed to allocate memory for return tuple elements.", return_keyword_token); }
 
@@ -1341,22 +1443,14 @@ static StatementExecStatus interpret_loop_statement(Interpreter* interpreter) {
             interpreter->current_token
         );
 
-        bool just_resumed = (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_RESUMING);
-
         interpreter->loop_depth++;
         bool is_first_pass_of_c_loop = true;
 
         while (1) { // The new C control loop
-            // On the first pass of this C loop (whether it's the first time the statement
-            // is run, or the first time after an async resume), the lexer is already
-            // positioned at the start of the condition. On subsequent synchronous iterations,
-            // we must rewind to re-evaluate the condition.
+            // On the first pass the lexer is already positioned at the start of the
+            // condition. On later iterations we must rewind to re-evaluate it.
             if (is_first_pass_of_c_loop) {
                 is_first_pass_of_c_loop = false;
-                if (just_resumed) {
-                    just_resumed = false; // Consume the flag for the first pass
-                }
-                // The flag will be consumed by the await expression itself. We just check it here.
             } else {
                 rewind_lexer_and_token(interpreter, condition_start_state, NULL);
             }
@@ -1365,11 +1459,6 @@ static StatementExecStatus interpret_loop_statement(Interpreter* interpreter) {
             // --- Part 1: Evaluate Condition ---
             ExprResult cond_res = interpret_expression(interpreter);
 
-            if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                free_token(condition_token_for_error);
-                if (cond_res.is_freshly_created_container) free_value_contents(cond_res.value);
-                return STATEMENT_YIELDED_AWAIT;
-            }
             if (interpreter->exception_is_active) {
                 free_token(condition_token_for_error);
                 if (cond_res.is_freshly_created_container) free_value_contents(cond_res.value);
@@ -1422,12 +1511,8 @@ static StatementExecStatus interpret_loop_statement(Interpreter* interpreter) {
                              loop_col + 4, interpreter->current_token->col);
                     report_error("Syntax", err_msg, interpreter->current_token);
                 }
-            }            StatementExecStatus body_status = execute_loop_body_iteration(interpreter, loop_col, loop_col + 4, "while");
-
-            if (body_status == STATEMENT_YIELDED_AWAIT) {
-                free_token(loop_keyword_token_for_context);
-                return STATEMENT_YIELDED_AWAIT;
             }
+            execute_loop_body_iteration(interpreter, loop_col, loop_col + 4, "while");
 
             if (interpreter->break_flag) {
                 interpreter->break_flag = 0;
@@ -1453,7 +1538,6 @@ static StatementExecStatus interpret_loop_statement(Interpreter* interpreter) {
         interpreter->loop_depth--;
     } else if (interpreter->current_token->type == TOKEN_FOR) {
         status = interpret_for_loop(interpreter, loop_col, loop_line, loop_keyword_token_for_context);
-        // If interpret_for_loop yielded, it will return STATEMENT_YIELDED_AWAIT.
         // The interpret_for_loop function handles its own loop_depth decrement.
     } else {
         char err_msg[200];
@@ -1467,6 +1551,34 @@ static StatementExecStatus interpret_loop_statement(Interpreter* interpreter) {
     return status;
 }
 
+// Outcome of one pass over a loop body (see run_loop_body_pass).
+typedef enum { LOOP_BODY_NEXT, LOOP_BODY_BREAK, LOOP_BODY_PROPAGATE } LoopBodyOutcome;
+
+// Runs a loop body once from its start and consumes 'break'/'continue'. After a break or a
+// propagating return/exception, the lexer is left on the first token after the loop.
+static LoopBodyOutcome run_loop_body_pass(Interpreter* interpreter, LexerState body_start, int loop_col, int body_indent, const char* loop_type_for_error) {
+    rewind_lexer_and_token(interpreter, body_start, NULL);
+    execute_loop_body_iteration(interpreter, loop_col, body_indent, loop_type_for_error);
+    if (interpreter->return_flag || interpreter->exception_is_active) {
+        skip_statements_in_branch(interpreter, loop_col);
+        return LOOP_BODY_PROPAGATE;
+    }
+    if (interpreter->break_flag) {
+        interpreter->break_flag = 0;
+        skip_statements_in_branch(interpreter, loop_col);
+        return LOOP_BODY_BREAK;
+    }
+    interpreter->continue_flag = 0;
+    return LOOP_BODY_NEXT;
+}
+
+// Stores the next value of a counted loop straight into the loop variable's symbol.
+static void set_loop_counter(Value* loop_var, long value) {
+    if (loop_var->type != VAL_INT && loop_var->type != VAL_FLOAT) free_value_contents(*loop_var); // The body rebound it
+    loop_var->type = VAL_INT;
+    loop_var->as.integer = value;
+}
+
 static StatementExecStatus interpret_for_loop(Interpreter* interpreter, int loop_col, int loop_line, Token* loop_keyword_token_for_context) {
     StatementExecStatus status = STATEMENT_EXECUTED_OK;
     (void)loop_line; // Mark as unused
@@ -1486,79 +1598,47 @@ static StatementExecStatus interpret_for_loop(Interpreter* interpreter, int loop
     int body_indent = loop_col + 4; // Body indented 4 spaces relative to 'loop:'
 
     if (interpreter->current_token->type == TOKEN_FROM) { // Range loop
-        // --- START: New async-safe for...from...to implementation ---
         interpreter_eat(interpreter, TOKEN_FROM);
-        
-        // On first entry, evaluate start/end/step and store them.
-        // On resume, these expressions are NOT re-evaluated. The loop continues from where it was.
-        // This requires storing the loop state (current value, end, step) in the loop's scope.
-        
-        // Create hidden variable names
-        char end_var_name[256], step_var_name[256];
-        snprintf(end_var_name, sizeof(end_var_name), "__%s_end", var_name_str);
-        snprintf(step_var_name, sizeof(step_var_name), "__%s_step", var_name_str);
-
-        bool just_resumed = (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_RESUMING);
-
-        Value* loop_var_ptr = symbol_table_get_local(interpreter->current_scope, var_name_str);
-
-        if (loop_var_ptr == NULL) { // First time entering this loop
-            ExprResult start_res = interpret_expression(interpreter);
-            if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                if (start_res.is_freshly_created_container) free_value_contents(start_res.value);
-                status = STATEMENT_YIELDED_AWAIT;
-                goto cleanup_for_loop;
-            }
-            if (interpreter->exception_is_active) { if (start_res.is_freshly_created_container) free_value_contents(start_res.value); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
-            interpreter_eat(interpreter, TOKEN_TO);
-            ExprResult end_res = interpret_expression(interpreter);
-            if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                if (start_res.is_freshly_created_container) free_value_contents(start_res.value);
-                if (end_res.is_freshly_created_container) free_value_contents(end_res.value);
-                status = STATEMENT_YIELDED_AWAIT;
-                goto cleanup_for_loop;
-            }
-            if (interpreter->exception_is_active) { if (start_res.is_freshly_created_container) free_value_contents(start_res.value); if (end_res.is_freshly_created_container) free_value_contents(end_res.value); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
-            
-            Value step_val; step_val.type = VAL_INT; step_val.as.integer = 1;
-            bool step_is_fresh = false;
-            if (interpreter->current_token->type == TOKEN_STEP) {
-                interpreter_eat(interpreter, TOKEN_STEP);
-                ExprResult step_res = interpret_expression(interpreter);
-                if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-                    if (start_res.is_freshly_created_container) free_value_contents(start_res.value);
-                    if (end_res.is_freshly_created_container) free_value_contents(end_res.value);
-                    if (step_res.is_freshly_created_container) free_value_contents(step_res.value);
-                    status = STATEMENT_YIELDED_AWAIT;
-                    goto cleanup_for_loop;
-                }
-                if (interpreter->exception_is_active) { if (start_res.is_freshly_created_container) free_value_contents(start_res.value); if (end_res.is_freshly_created_container) free_value_contents(end_res.value); if (step_res.is_freshly_created_container) free_value_contents(step_res.value); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
-                step_val = step_res.value;
-                step_is_fresh = step_res.is_freshly_created_container;
-            }
 
-            // --- START: Stricter Syntax Check ---
-            int for_header_line = interpreter->current_token->line;
-            interpreter_eat(interpreter, TOKEN_COLON);
-            if (interpreter->current_token->line == for_header_line && interpreter->current_token->type != TOKEN_EOF) {
-                report_error("Syntax", "Unexpected token on the same line after 'for...from...to' header. Expected a newline and an indented block.", interpreter->current_token);
-            }
-            // --- END: Stricter Syntax Check ---
+        // Evaluate start/end/step once. The counter, end and step then live in this C frame
+        // (coroutines keep their own stacks across awaits); the loop variable is only written.
+        ExprResult start_res = interpret_expression(interpreter);
+        if (interpreter->exception_is_active) { if (start_res.is_freshly_created_container) free_value_contents(start_res.value); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
+        interpreter_eat(interpreter, TOKEN_TO);
+        ExprResult end_res = interpret_expression(interpreter);
+        if (interpreter->exception_is_active) { if (start_res.is_freshly_created_container) free_value_contents(start_res.value); if (end_res.is_freshly_created_container) free_value_contents(end_res.value); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
 
-            if (!((start_res.value.type == VAL_INT || start_res.value.type == VAL_FLOAT) && (end_res.value.type == VAL_INT || end_res.value.type == VAL_FLOAT) && (step_val.type == VAL_INT || step_val.type == VAL_FLOAT))) {
-                report_error("Runtime", "Start, end, and step values for 'for...from...to' loop must be numbers.", var_name_token);
-            }
+        Value step_val; step_val.type = VAL_INT; step_val.as.integer = 1;
+        bool step_is_fresh = false;
+        if (interpreter->current_token->type == TOKEN_STEP) {
+            interpreter_eat(interpreter, TOKEN_STEP);
+            ExprResult step_res = interpret_expression(interpreter);
+            if (interpreter->exception_is_active) { if (start_res.is_freshly_created_container) free_value_contents(start_res.value); if (end_res.is_freshly_created_container) free_value_contents(end_res.value); if (step_res.is_freshly_created_container) free_value_contents(step_res.value); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
+            step_val = step_res.value;
+            step_is_fresh = step_res.is_freshly_created_container;
+        }
 
-            // Store loop parameters in hidden variables within the loop's scope
-            symbol_table_define(interpreter->current_scope, end_var_name, end_res.value);
-            symbol_table_define(interpreter->current_scope, step_var_name, step_val);
-            // Initialize the public loop variable
-            symbol_table_define(interpreter->current_scope, var_name_str, start_res.value);
+        // --- START: Stricter Syntax Check ---
+        int for_header_line = interpreter->current_token->line;
+        interpreter_eat(interpreter, TOKEN_COLON);
+        if (interpreter->current_token->line == for_header_line && interpreter->current_token->type != TOKEN_EOF) {
+            report_error("Syntax", "Unexpected token on the same line after 'for...from...to' header. Expected a newline and an indented block.", interpreter->current_token);
+        }
+        // --- END: Stricter Syntax Check ---
 
-            if (start_res.is_freshly_created_container) free_value_contents(start_res.value);
-            if (end_res.is_freshly_created_container) free_value_contents(end_res.value);
-            if (step_is_fresh) free_value_contents(step_val);
+        Value start_val = start_res.value;
+        Value end_val = end_res.value;
+        if (!((start_val.type == VAL_INT || start_val.type == VAL_FLOAT) && (end_val.type == VAL_INT || end_val.type == VAL_FLOAT) && (step_val.type == VAL_INT || step_val.type == VAL_FLOAT))) {
+            report_error("Runtime", "Start, end, and step values for 'for...from...to' loop must be numbers.", var_name_token);
         }
+        // Numbers own no memory, so the values stay usable after this.
+        if (start_res.is_freshly_created_container) free_value_contents(start_val);
+        if (end_res.is_freshly_created_container) free_value_contents(end_val);
+        if (step_is_fresh) free_value_contents(step_val);
+
+        // The loop variable's symbol node stays put for the loop's lifetime, so it is looked up once.
+        symbol_table_define(interpreter->current_scope, var_name_str, start_val);
+        Value* loop_var = symbol_table_get_local(interpreter->current_scope, var_name_str);
 
         if (interpreter->current_token->col <= loop_col) report_error("Syntax", "Expected an indented block after 'for...from...to' statement.", loop_keyword_token_for_context);
         LexerState loop_body_start_lexer_state = get_lexer_state_for_token_start(interpreter->lexer,
@@ -1566,62 +1646,43 @@ static StatementExecStatus interpret_for_loop(Interpreter* interpreter, int loop
                                                                                   interpreter->current_token->col,
                                                                                   interpreter->current_token);
 
-
-        
-        while(1) { // Async-safe loop
-            // Get current loop state from scope
-            Value* i_val = symbol_table_get_local(interpreter->current_scope, var_name_str);
-            Value* end_val = symbol_table_get_local(interpreter->current_scope, end_var_name);
-            Value* step_val = symbol_table_get_local(interpreter->current_scope, step_var_name);
-
-            if (!i_val || !end_val || !step_val) report_error("Internal", "Loop state variables missing in for...from...to loop.", var_name_token);
-
-            double i_d = (i_val->type == VAL_INT) ? i_val->as.integer : i_val->as.floating;
-            double end_d = (end_val->type == VAL_INT) ? end_val->as.integer : end_val->as.floating;
-            double step_d = (step_val->type == VAL_INT) ? step_val->as.integer : step_val->as.floating;
-
-            // Check termination condition
-            if ((step_d > 0 && i_d > end_d) || (step_d < 0 && i_d < end_d)) {
-                break; // Exit while(1)
-            }
-
-            // Execute body
-            if (just_resumed) {
-                DEBUG_PRINTF("FOR_LOOP (Range): Resuming from await, not rewinding body lexer.%s", "");
-                just_resumed = false; // Consume the resume signal
-            } else {
-                rewind_lexer_and_token(interpreter, loop_body_start_lexer_state, NULL);
-            }
-            StatementExecStatus body_status = execute_loop_body_iteration(interpreter, loop_col, body_indent, "for...from...to");
-
-            if (body_status == STATEMENT_YIELDED_AWAIT) {
-                status = STATEMENT_YIELDED_AWAIT;
-                goto cleanup_for_loop;
+        if (start_val.type == VAL_INT && step_val.type == VAL_INT) {
+            long i = start_val.as.integer;
+            long step = step_val.as.integer;
+            long last = end_val.as.integer;
+            if (end_val.type == VAL_FLOAT) { // Last integer the counter may reach
+                double bound = step >= 0 ? floor(end_val.as.floating) : ceil(end_val.as.floating);
+                last = bound >= (double)LONG_MAX ? LONG_MAX : (bound <= (double)LONG_MIN ? LONG_MIN : (long)bound);
+            }
+            while (step > 0 ? i <= last : (step < 0 ? i >= last : true)) {
+                set_loop_counter(loop_var, i);
+                LoopBodyOutcome outcome = run_loop_body_pass(interpreter, loop_body_start_lexer_state, loop_col, body_indent, "for...from...to");
+                if (outcome == LOOP_BODY_PROPAGATE) { status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
+                if (outcome == LOOP_BODY_BREAK) break;
+                if (step > 0 ? i > LONG_MAX - step : i < LONG_MIN - step) break; // Next value is past any bound
+                i += step;
             }
-            if (interpreter->return_flag || interpreter->exception_is_active) {
-                status = STATEMENT_PROPAGATE_FLAG;
-                skip_to_loop_end(interpreter, loop_col);
-                goto cleanup_for_loop;
-            }
-            if (interpreter->break_flag) {
-                interpreter->break_flag = 0;
-                skip_to_loop_end(interpreter, loop_col);
-                break; // Exit while(1)
-            }
-            if (interpreter->continue_flag) {
-                interpreter->continue_flag = 0;
-                // Fall through to increment step
-            }
-
-            // Increment and update loop variable
-            i_d += step_d;
-            if (i_val->type == VAL_INT && step_val->type == VAL_INT) {
-                i_val->as.integer = (long)i_d;
-            } else {
-                i_val->type = VAL_FLOAT;
-                i_val->as.floating = i_d;
+        } else {
+            // A float start or step makes the variable a float from the second value on.
+            double i_d = (start_val.type == VAL_INT) ? (double)start_val.as.integer : start_val.as.floating;
+            double end_d = (end_val.type == VAL_INT) ? (double)end_val.as.integer : end_val.as.floating;
+            double step_d = (step_val.type == VAL_INT) ? (double)step_val.as.integer : step_val.as.floating;
+            bool first_pass = true;
+            while (!((step_d > 0 && i_d > end_d) || (step_d < 0 && i_d < end_d))) {
+                if (!first_pass) {
+                    if (loop_var->type != VAL_INT && loop_var->type != VAL_FLOAT) free_value_contents(*loop_var); // The body rebound it
+                    loop_var->type = VAL_FLOAT;
+                    loop_var->as.floating = i_d;
+                }
+                first_pass = false;
+                LoopBodyOutcome outcome = run_loop_body_pass(interpreter, loop_body_start_lexer_state, loop_col, body_indent, "for...from...to");
+                if (outcome == LOOP_BODY_PROPAGATE) { status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
+                if (outcome == LOOP_BODY_BREAK) break;
+                i_d += step_d;
             }
         }
+        // Without a break the lexer may still be inside the body (no iterations, or a final 'continue').
+        skip_statements_in_branch(interpreter, loop_col);
 
     } else if (interpreter->current_token->type == TOKEN_IN) { // Collection loop
         interpreter_eat(interpreter, TOKEN_IN);
@@ -1631,11 +1692,6 @@ static StatementExecStatus interpret_for_loop(Interpreter* interpreter, int loop
             status = STATEMENT_PROPAGATE_FLAG;
             goto cleanup_for_loop;
         }
-        if (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT) {
-            if (coll_res.is_freshly_created_container) free_value_contents(coll_res.value);
-            status = STATEMENT_YIELDED_AWAIT;
-            goto cleanup_for_loop;
-        }
         Value collection_val = coll_res.value; // Keep this for freeing if fresh
 
         // --- START: Stricter Syntax Check ---
@@ -1654,109 +1710,75 @@ static StatementExecStatus interpret_for_loop(Interpreter* interpreter, int loop
                                                                                  interpreter->current_token->col,
                                                                                  interpreter->current_token);
 
-        if (collection_val.type != VAL_ARRAY && collection_val.type != VAL_STRING && collection_val.type != VAL_DICT) report_error("Runtime", "Collection in 'for...in' loop must be an array, string, or dictionary.", var_name_token);
-
-        // Store the collection itself in a hidden variable to persist it across awaits.
-        char coll_var_name[256];
-        snprintf(coll_var_name, sizeof(coll_var_name), "__%s_coll", var_name_str);
-        bool just_resumed = (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_RESUMING);
-
-        symbol_table_define(interpreter->current_scope, coll_var_name, collection_val);
-        if (coll_res.is_freshly_created_container) free_value_contents(collection_val);
-
-        // Use a hidden index variable.
-        char idx_var_name[256];
-        snprintf(idx_var_name, sizeof(idx_var_name), "__%s_idx", var_name_str);
-        Value initial_idx_val = {.type = VAL_INT, .as.integer = 0};
-        symbol_table_define(interpreter->current_scope, idx_var_name, initial_idx_val);
-
-        while(1) { // Async-safe loop
-            Value* idx_ptr = symbol_table_get_local(interpreter->current_scope, idx_var_name);
-            Value* coll_ptr = symbol_table_get_local(interpreter->current_scope, coll_var_name);
-            if (!idx_ptr || !coll_ptr) report_error("Internal", "Loop state variables missing in for...in loop.", var_name_token);
-
-            if (just_resumed) {
-                DEBUG_PRINTF("FOR_LOOP (In): Resuming from await, not rewinding body lexer.%s", "");
-                just_resumed = false; // Consume the resume signal
-            }
-
-            long current_idx = idx_ptr->as.integer;
-            Value current_item;
-            bool has_more_items = false;
-
-            if (coll_ptr->type == VAL_ARRAY) {
-                if (current_idx < coll_ptr->as.array_val->count) {
-                    current_item = coll_ptr->as.array_val->elements[current_idx];
-                    has_more_items = true;
-                }
-            } else if (coll_ptr->type == VAL_STRING) {
-                if ((size_t)current_idx < strlen(coll_ptr->as.string_val)) {
-                    char* char_str = malloc(2);
-                    char_str[0] = coll_ptr->as.string_val[current_idx];
-                    char_str[1] = '\0';
-                    current_item.type = VAL_STRING;
-                    current_item.as.string_val = char_str;
-                    has_more_items = true;
-                }
-            } else if (coll_ptr->type == VAL_DICT) {
-                Dictionary* dict = coll_ptr->as.dict_val;
-                if (current_idx < dict->count) {
-                    long items_seen = 0;
-                    for (int i = 0; i < dict->num_buckets; ++i) {
-                        for (DictEntry* entry = dict->buckets[i]; entry != NULL; entry = entry->next) {
-                            if (items_seen == current_idx) {
-                                current_item.type = VAL_STRING;
-                                current_item.as.string_val = strdup(entry->key);
-                                has_more_items = true;
-                                goto found_dict_key;
-                            }
-                            items_seen++;
-                        }
-                    }
-                }
-                found_dict_key:;
-            }
-
-            if (!has_more_items) {
-                break; // Exit while(1)
-            }
-
-            // Update the loop variable in the single loop scope.
-            symbol_table_set(interpreter->current_scope, var_name_str, current_item);
-            if (coll_ptr->type == VAL_STRING || coll_ptr->type == VAL_DICT) {
-                // The string/key was freshly allocated for this iteration
-                free_value_contents(current_item);
-            }
-
-            // Execute body
-            if (!just_resumed) { // The just_resumed flag has been consumed by now
-                rewind_lexer_and_token(interpreter, loop_body_start_lexer_state, NULL);
-            }
-            StatementExecStatus body_status = execute_loop_body_iteration(interpreter, loop_col, body_indent, "for...in");
-
+        if (collection_val.type == VAL_RANGE) {
+            // Counted natively from a copy of the bounds; nothing per element touches the heap.
+            Range range = *collection_val.as.range_val;
+            if (coll_res.is_freshly_created_container) free_value_contents(collection_val);
+            Value first_val = {.type = VAL_INT, .as.integer = range.start};
+            symbol_table_define(interpreter->current_scope, var_name_str, first_val);
+            Value* loop_var = symbol_table_get_local(interpreter->current_scope, var_name_str);
+
+            long remaining = range_length(&range);
+            long i = range.start;
+            while (remaining-- > 0) {
+                set_loop_counter(loop_var, i);
+                LoopBodyOutcome outcome = run_loop_body_pass(interpreter, loop_body_start_lexer_state, loop_col, body_indent, "for...in");
+                if (outcome == LOOP_BODY_PROPAGATE) { status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
+                if (outcome == LOOP_BODY_BREAK) break;
+                if (remaining > 0) i += range.step;
+            }
+            skip_statements_in_branch(interpreter, loop_col);
+            goto cleanup_for_loop;
+        }
 
-            if (body_status == STATEMENT_YIELDED_AWAIT) {
-                status = STATEMENT_YIELDED_AWAIT;
-                goto cleanup_for_loop;
-            }
-            if (interpreter->return_flag || interpreter->exception_is_active) {
-                status = STATEMENT_PROPAGATE_FLAG;
-                skip_to_loop_end(interpreter, loop_col);
-                goto cleanup_for_loop;
-            }
-            if (interpreter->break_flag) {
-                interpreter->break_flag = 0;
-                skip_to_loop_end(interpreter, loop_col);
-                break; // Exit while(1)
-            }
-            if (interpreter->continue_flag) {
-                interpreter->continue_flag = 0;
-                // Fall through to increment step
+        if (collection_val.type != VAL_ARRAY && collection_val.type != VAL_PACKED_ARRAY && collection_val.type != VAL_STRING && collection_val.type != VAL_DICT) report_error("Runtime", "Collection in 'for...in' loop must be an array, range, string, or dictionary.", var_name_token);
+
+        // The loop holds its own reference to the collection and its position in this C frame
+        // (coroutines keep their own stacks across awaits). Copying the collection only takes a
+        // reference, so the body can neither free it nor change it under us.
+        Value collection = coll_res.is_freshly_created_container ? collection_val : value_deep_copy(collection_val);
+        size_t string_length = collection.type == VAL_STRING ? string_value_length(collection.as.string_val) : 0;
+        Value* loop_var = NULL; // The loop variable's symbol, found by the first iteration's set
+
+        for (long index = 0; ; ++index) {
+            // Elements are handed out in place; only the loop variable's own copy is made.
+            Value item;
+            bool item_is_fresh = false;
+            if (collection.type == VAL_ARRAY) {
+                if (index >= collection.as.array_val->count) break; // Re-read: the body may grow the array
+                item = collection.as.array_val->elements[index];
+            } else if (collection.type == VAL_PACKED_ARRAY) {
+                if (index >= collection.as.packed_array_val->count) break;
+                item = packed_array_get(collection.as.packed_array_val, (int)index);
+            } else if (collection.type == VAL_STRING) {
+                if ((size_t)index >= string_length) break;
+                item.type = VAL_STRING;
+                item.as.string_val = string_value_char((unsigned char)collection.as.string_val[index]);
+            } else { // VAL_DICT: keys in insertion order
+                if (index >= collection.as.dict_val->count) break;
+                item.type = VAL_STRING;
+                item.as.string_val = string_value_create(collection.as.dict_val->entries[index].key);
+                item_is_fresh = true;
+            }
+
+            if (!loop_var) {
+                symbol_table_set(interpreter->current_scope, var_name_str, item);
+                loop_var = symbol_table_get(interpreter->current_scope, var_name_str);
+                if (item_is_fresh) free_value_contents(item);
+            } else {
+                // Copy first: the item may live inside the old value
+                Value item_copy = item_is_fresh ? item : value_deep_copy(item);
+                free_value_contents(*loop_var);
+                *loop_var = item_copy;
             }
 
-            // Increment index for next iteration
-            idx_ptr->as.integer++;
+            LoopBodyOutcome outcome = run_loop_body_pass(interpreter, loop_body_start_lexer_state, loop_col, body_indent, "for...in");
+            if (outcome == LOOP_BODY_PROPAGATE) { free_value_contents(collection); status = STATEMENT_PROPAGATE_FLAG; goto cleanup_for_loop; }
+            if (outcome == LOOP_BODY_BREAK) break;
         }
+        free_value_contents(collection);
+        // Without a break the lexer may still be inside the body (no items, or a final 'continue').
+        skip_statements_in_branch(interpreter, loop_col);
     } else {
         report_error("Syntax", "Expected 'from' or 'in' after 'for <variable>'.", interpreter->current_token);
     }
@@ -1813,12 +1835,6 @@ static void interpret_raise_statement(Interpreter* interpreter) {
 static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
     StatementExecStatus status = STATEMENT_EXECUTED_OK;
     Token* try_keyword_token = token_deep_copy(interpreter->current_token);
-    bool yielded_in_block = false;
-    // Save the start state of the 'try' statement to potentially rewind to on async resume.
-    LexerState try_statement_start_state = get_lexer_state_for_token_start(
-        interpreter->lexer, try_keyword_token->line, try_keyword_token->col, try_keyword_token
-    );
-    (void)try_statement_start_state; // Suppress unused variable warning
     
     int try_col = try_keyword_token->col;
     interpreter_eat(interpreter, TOKEN_TRY); // Consume 'try'
@@ -1849,15 +1865,10 @@ static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
     frame->pending_exception_active_after_finally = 0;
     frame->prev = interpreter->try_catch_stack_top;
     interpreter->try_catch_stack_top = frame;
-    StatementExecStatus try_block_status = STATEMENT_EXECUTED_OK;
 
     // 1. Execute TRY block    
-    try_block_status = execute_statements_in_controlled_block(interpreter, try_col, "try", TOKEN_CATCH, TOKEN_FINALLY, TOKEN_EOF);
+    execute_statements_in_controlled_block(interpreter, try_col, "try", TOKEN_CATCH, TOKEN_FINALLY, TOKEN_EOF);
 
-    if (try_block_status == STATEMENT_YIELDED_AWAIT) {
-        free_token(try_keyword_token);
-        return STATEMENT_YIELDED_AWAIT;
-    }
 
     int exception_occurred_in_try = interpreter->exception_is_active;
     Value exception_from_try = create_null_value();
@@ -1899,7 +1910,7 @@ static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
             report_error("Syntax", "Expected an indented block after 'catch' clause.", interpreter->current_token);
         }
 
-        if (exception_occurred_in_try && !yielded_in_block) { // Only execute catch body
+        if (exception_occurred_in_try) { // Only execute catch body
             interpreter->exception_is_active = 0; // Exception is "caught" for now
             free_value_contents(interpreter->current_exception);
             interpreter->current_exception = create_null_value();
@@ -1909,10 +1920,7 @@ static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
                 symbol_table_set(interpreter->current_scope, frame->catch_clause->variable_name, exception_from_try);
             }
 
-            StatementExecStatus catch_block_status = execute_statements_in_controlled_block(interpreter, try_col, "catch", TOKEN_FINALLY, TOKEN_EOF, TOKEN_EOF);
-            if (catch_block_status == STATEMENT_YIELDED_AWAIT) { // A yield happened inside the catch block
-                yielded_in_block = true;
-            }
+            execute_statements_in_controlled_block(interpreter, try_col, "catch", TOKEN_FINALLY, TOKEN_EOF, TOKEN_EOF);
 
             exit_scope(interpreter); // Exit catch block scope
             // If catch block raised a new exception, interpreter->exception_is_active will be true.
@@ -1974,10 +1982,7 @@ static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
         interpreter->break_flag = 0;
         interpreter->continue_flag = 0;
         
-        StatementExecStatus finally_block_status = execute_statements_in_controlled_block(interpreter, try_col, "finally", TOKEN_EOF, TOKEN_EOF, TOKEN_EOF);
-        if (finally_block_status == STATEMENT_YIELDED_AWAIT) { // A yield happened inside the finally block
-            yielded_in_block = true;
-        }
+        execute_statements_in_controlled_block(interpreter, try_col, "finally", TOKEN_EOF, TOKEN_EOF, TOKEN_EOF);
         
         if (interpreter->exception_is_active || interpreter->return_flag || interpreter->break_flag || interpreter->continue_flag) { // If finally raised its own exception or control flow change
             free_value_contents(pending_exception); // Original/catch exception is superseded
@@ -2014,10 +2019,6 @@ static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
     free(frame);
     free_token(try_keyword_token);
 
-    if (yielded_in_block) {
-        return STATEMENT_YIELDED_AWAIT;
-    }
-
     if (interpreter->exception_is_active || interpreter->return_flag) { // If exception or return is active after try-catch-finally
         return STATEMENT_PROPAGATE_FLAG;
     }
@@ -2026,8 +2027,7 @@ static StatementExecStatus interpret_try_statement(Interpreter* interpreter) {
 
 static bool is_builtin_module(const char* module_name) {
     if (!module_name) return false;
-    // For now, only 'weaver' is built-in. This can be expanded later.
-    if (strcmp(module_name, "weaver") == 0) {
+    if (strcmp(module_name, "weaver") == 0 || strcmp(module_name, "numeric") == 0) {
         return true;
     }
     return false;
@@ -2056,9 +2056,10 @@ static void interpret_blueprint_statement(Interpreter* interpreter) {
     new_bp->name = bp_name_str;
     new_bp->parent_blueprint = NULL;
     new_bp->init_method_cache = NULL;
+    new_bp->root_shape = NULL; // Created with the first instance
 
     new_bp->definition_col = blueprint_def_col; // Use the saved int, which is safer
-    new_bp->class_attributes_and_methods = malloc(sizeof(Scope));
+    new_bp->class_attributes_and_methods = calloc(1, sizeof(Scope));
     if (!new_bp->class_attributes_and_methods) {
         free(new_bp->name); free(new_bp); free_token(bp_name_token);
         report_error("System", "Failed to allocate memory for blueprint scope.", blueprint_keyword_token);
@@ -2223,10 +2224,20 @@ static void interpret_load_statement(Interpreter* interpreter) {
                 free(abs_path);
             }
 
+            if (module_namespace.type != VAL_DICT) { // The circular-import placeholder
+                char err_msg[300];
+                snprintf(err_msg, sizeof(err_msg), "Cannot load items from module '%s' while it is still being loaded (circular import).", module_name_or_path_str);
+                report_error("Runtime", err_msg, module_origin_token);
+            }
             for (int i = 0; i < item_count; ++i) {
-                Value item_val = dictionary_get(module_namespace.as.dict_val, item_names[i], module_origin_token);
-                symbol_table_set(interpreter->current_scope, item_aliases[i], item_val);
-                free_value_contents(item_val);
+                // Bind straight from the module's own entry: symbol_table_set makes the only copy.
+                Value* item_val = dictionary_try_get_value_ptr(module_namespace.as.dict_val, item_names[i]);
+                if (!item_val) {
+                    char err_msg[300];
+                    snprintf(err_msg, sizeof(err_msg), "Key '%s' not found in dictionary.", item_names[i]);
+                    report_error("Runtime", err_msg, module_origin_token);
+                }
+                symbol_table_set(interpreter->current_scope, item_aliases[i], *item_val);
             }
             free_value_contents(module_namespace);
 
@@ -2289,57 +2300,62 @@ static void interpret_load_statement(Interpreter* interpreter) {
     interpreter_eat(interpreter, TOKEN_COLON); // Final colon for the load statement
 }
 
-// Executes the body of an EchoC-defined coroutine.
-// This function is called by the event loop when a coroutine is scheduled to run.
-StatementExecStatus interpret_coroutine_body(Interpreter* interpreter, Coroutine* coro_to_run) {
-    Scope* old_scope = interpreter->current_scope;
-
-    Object* old_self_obj_ctx = interpreter->current_self_object;
-    LexerState old_lexer_state = get_lexer_state(interpreter->lexer);
-    Token* old_current_token = token_deep_copy(interpreter->current_token);
-    
-    // --- START of changes for coroutine-specific try-catch stack ---
-    TryCatchFrame* old_try_catch_stack = interpreter->try_catch_stack_top;
-    interpreter->try_catch_stack_top = coro_to_run->try_catch_stack_top;
-    // --- END of changes for coroutine-specific try-catch stack ---
-
-    // Set up interpreter context for this coroutine
-    interpreter->current_scope = coro_to_run->execution_scope;
-    // If resuming from an await, we use the more precise post_await_resume_state.
-    // Otherwise (e.g., first run, or after a different kind of yield if introduced later),
-    // we use the general statement_resume_state.
-    if (coro_to_run->has_yielding_await_state) {
-        interpreter->prevent_side_effects = true;
-        DEBUG_PRINTF("CORO_BODY_EXEC: Resuming coro '%s'. Fast-forward mode ENABLED.", coro_to_run->name ? coro_to_run->name : "unnamed");
-    }
-
-    DEBUG_PRINTF("CORO_BODY_EXEC: Resuming coro '%s'. ALWAYS resuming from STATEMENT_RESUME state: Pos=%d, Line=%d, Col=%d", coro_to_run->name ? coro_to_run->name : "unnamed", coro_to_run->statement_resume_state.pos, coro_to_run->statement_resume_state.line, coro_to_run->statement_resume_state.col);
-    // ALWAYS resume from the start of the statement that yielded.
-    // The 'await' expression handler will detect it's a resume and fast-forward the expression parsing.
-    set_lexer_state(interpreter->lexer, coro_to_run->statement_resume_state); 
-
-    interpreter->current_self_object = NULL; // Coroutines are not methods in the OOP sense here
-
-    interpreter->function_nesting_level++; // Increment nesting level for the coroutine's execution
-
-    free_token(interpreter->current_token); 
-    interpreter->current_token = get_next_token(interpreter->lexer); 
-
-    interpreter->current_executing_coroutine = coro_to_run; // Set context AFTER setting up lexer
-    interpreter->return_flag = 0; // Reset for this coroutine execution slice
+// --- Coroutine execution ---
+// A coroutine body runs on its own C stack (see coro_context.h). An 'await' that has
+// to wait switches back to the event loop with every C frame between the body and the
+// await left intact, so resuming continues directly after that await.
+
+static void coroutine_registers_save(Interpreter* interpreter, CoroutineRegisters* regs) {
+    regs->lexer = interpreter->lexer;
+    regs->lexer_state = get_lexer_state(interpreter->lexer);
+    regs->current_token = interpreter->current_token;
+    regs->current_scope = interpreter->current_scope;
+    regs->current_self_object = interpreter->current_self_object;
+    regs->try_catch_stack_top = interpreter->try_catch_stack_top;
+    regs->loop_depth = interpreter->loop_depth;
+    regs->break_flag = interpreter->break_flag;
+    regs->continue_flag = interpreter->continue_flag;
+    regs->function_nesting_level = interpreter->function_nesting_level;
+    regs->return_flag = interpreter->return_flag;
+    regs->current_function_return_value = interpreter->current_function_return_value;
+    regs->exception_is_active = interpreter->exception_is_active;
+    regs->current_exception = interpreter->current_exception;
+    regs->current_executing_file_path = interpreter->current_executing_file_path;
+    regs->current_executing_file_directory = interpreter->current_executing_file_directory;
+    regs->prevent_side_effects = interpreter->prevent_side_effects;
+    regs->current_executing_coroutine = interpreter->current_executing_coroutine;
+    regs->scratch = interpreter->scratch;
+}
 
-    DEBUG_PRINTF("CORO_BODY_EXEC: Starting/Resuming coro %s (%p). Scope: %p. Lexer state: Pos=%d, Line=%d, Col=%d. Token: %s ('%s')",
-                 coro_to_run->name ? coro_to_run->name : "unnamed", (void*)coro_to_run,
-                 (void*)interpreter->current_scope,
-                 interpreter->lexer->pos, interpreter->lexer->line, interpreter->lexer->col,
-                 token_type_to_string(interpreter->current_token->type),
-                 interpreter->current_token->value ? interpreter->current_token->value : "N/A");
+static void coroutine_registers_restore(Interpreter* interpreter, const CoroutineRegisters* regs) {
+    interpreter->lexer = regs->lexer;
+    set_lexer_state(interpreter->lexer, regs->lexer_state);
+    interpreter->current_token = regs->current_token;
+    interpreter->current_scope = regs->current_scope;
+    interpreter->current_self_object = regs->current_self_object;
+    interpreter->try_catch_stack_top = regs->try_catch_stack_top;
+    interpreter->loop_depth = regs->loop_depth;
+    interpreter->break_flag = regs->break_flag;
+    interpreter->continue_flag = regs->continue_flag;
+    interpreter->function_nesting_level = regs->function_nesting_level;
+    interpreter->return_flag = regs->return_flag;
+    interpreter->current_function_return_value = regs->current_function_return_value;
+    interpreter->exception_is_active = regs->exception_is_active;
+    interpreter->current_exception = regs->current_exception;
+    interpreter->current_executing_file_path = regs->current_executing_file_path;
+    interpreter->current_executing_file_directory = regs->current_executing_file_directory;
+    interpreter->prevent_side_effects = regs->prevent_side_effects;
+    interpreter->current_executing_coroutine = regs->current_executing_coroutine;
+    interpreter->scratch = regs->scratch;
+}
 
-    if (!coro_to_run->function_def) {
-        report_error("Internal", "interpret_coroutine_body called on coroutine with no function_def.", interpreter->current_token);
-        goto cleanup_and_return_coro_body; // Use goto for cleanup path
-    }
+typedef struct {
+    Interpreter* interpreter;
+    Coroutine* coro;
+} CoroutineStart;
 
+// Interprets the body from its first statement to its end.
+static void coroutine_body_run(Interpreter* interpreter, Coroutine* coro_to_run) {
     bool returned = false;
 
     while (true) {
@@ -2355,22 +2371,13 @@ StatementExecStatus interpret_coroutine_body(Interpreter* interpreter, Coroutine
             break; // Exit the while loop
         }
 
-		// Save resume state BEFORE executing the statement.
-		if (coro_to_run) {
-			coro_to_run->statement_resume_state = get_lexer_state_for_token_start(interpreter->lexer, interpreter->current_token->line, interpreter->current_token->col, interpreter->current_token);
-		}
-
         DEBUG_PRINTF("CORO_BODY_EXEC: About to interpret statement. Token: %s ('%s') at L%d C%d",
              token_type_to_string(interpreter->current_token->type),
              interpreter->current_token->value ? interpreter->current_token->value : "N/A",
              interpreter->current_token->line, interpreter->current_token->col);
         StatementExecStatus status = interpret_statement(interpreter);
 
-        if (status == STATEMENT_YIELDED_AWAIT) {
-            // The coroutine yielded. Its state is set to SUSPENDED by await.
-            // We need to break out of this execution loop. The resume state is already saved.
-            break;
-        } else if (status == STATEMENT_PROPAGATE_FLAG) {
+        if (status == STATEMENT_PROPAGATE_FLAG) {
             // A 'return' or 'raise' occurred.
             if (interpreter->return_flag) {
                 returned = true;
@@ -2397,25 +2404,99 @@ StatementExecStatus interpret_coroutine_body(Interpreter* interpreter, Coroutine
             report_error("Syntax", "Unreachable code after 'return:' statement.", interpreter->current_token);
         }
     }
+}
 
-cleanup_and_return_coro_body:
-    DEBUG_PRINTF("CORO_BODY_CLEANUP: Coro %s (%p). Final state: %d. Overall status for event loop: %d",
+// Runs on the coroutine's own stack. A fatal error must neither longjmp off this stack
+// nor exit on it (leak checking would no longer see the resumer's frames): it lands
+// here instead, the context finishes normally, and the resumer passes the error on
+// from its own stack (see interpret_coroutine_body).
+static void coroutine_body_entry(void* arg) {
+    Interpreter* interpreter = ((CoroutineStart*)arg)->interpreter;
+    Coroutine* coro_to_run = ((CoroutineStart*)arg)->coro;
+    jmp_buf recovery;
+    if (setjmp(recovery) != 0) {
+        coro_to_run->error_recovery_point = NULL;
+        coro_to_run->aborted_by_error = true;
+        coro_to_run->state = CORO_DONE;
+        return;
+    }
+    coro_to_run->error_recovery_point = &recovery;
+    g_error_recovery_point = &recovery;
+    coroutine_body_run(interpreter, coro_to_run);
+}
+
+void coroutine_suspend(Interpreter* interpreter, Coroutine* coro) {
+    coroutine_registers_save(interpreter, &coro->saved_registers);
+    coro->try_catch_stack_top = interpreter->try_catch_stack_top; // Freed with the coroutine if it never resumes
+    coro_context_yield(coro->context);
+    // interpret_coroutine_body restored the registers before switching back in.
+}
+
+// Executes the body of an EchoC-defined coroutine until it finishes or suspends at an 'await'.
+// This function is called by the event loop when a coroutine is scheduled to run.
+StatementExecStatus interpret_coroutine_body(Interpreter* interpreter, Coroutine* coro_to_run) {
+    if (!coro_to_run->function_def) {
+        report_error("Internal", "interpret_coroutine_body called on coroutine with no function_def.", interpreter->current_token);
+    }
+
+    CoroutineRegisters caller_registers;
+    coroutine_registers_save(interpreter, &caller_registers);
+
+    CoroutineStart start = { interpreter, coro_to_run };
+    if (!coro_to_run->context) {
+        // First run: fresh registers positioned at the start of the body.
+        interpreter->current_scope = coro_to_run->execution_scope;
+        interpreter->current_self_object = NULL; // Coroutines are not methods in the OOP sense here
+        interpreter->try_catch_stack_top = coro_to_run->try_catch_stack_top;
+        interpreter->loop_depth = 0;
+        interpreter->break_flag = 0;
+        interpreter->continue_flag = 0;
+        interpreter->function_nesting_level = caller_registers.function_nesting_level + 1;
+        interpreter->return_flag = 0;
+        interpreter->current_function_return_value = create_null_value();
+        interpreter->exception_is_active = 0;
+        interpreter->current_exception = create_null_value();
+        interpreter->prevent_side_effects = false;
+        interpreter->scratch = &coro_to_run->scratch;
+        set_lexer_state(interpreter->lexer, coro_to_run->function_def->body_start_state);
+        interpreter->current_token = get_next_token(interpreter->lexer);
+        coro_to_run->context = coro_context_create(coroutine_body_entry, &start);
+    } else {
+        coroutine_registers_restore(interpreter, &coro_to_run->saved_registers);
+    }
+    interpreter->current_executing_coroutine = coro_to_run;
+    coro_to_run->state = CORO_RUNNABLE;
+
+    DEBUG_PRINTF("CORO_BODY_EXEC: Switching into coro %s (%p). Scope: %p. Token: %s ('%s') at L%d C%d",
                  coro_to_run->name ? coro_to_run->name : "unnamed", (void*)coro_to_run,
-                 coro_to_run->state, coro_to_run->state == CORO_SUSPENDED_AWAIT ? STATEMENT_YIELDED_AWAIT : STATEMENT_EXECUTED_OK);
-
-    // --- START of changes for coroutine-specific try-catch stack (cleanup) ---
-    // Save the (potentially modified) stack top back to the coroutine
-    coro_to_run->try_catch_stack_top = interpreter->try_catch_stack_top;
-    // Restore the interpreter's original stack top
-    interpreter->try_catch_stack_top = old_try_catch_stack;
-    // --- END of changes for coroutine-specific try-catch stack (cleanup) ---
-    interpreter->function_nesting_level--; // Decrement nesting level
-    interpreter->current_executing_coroutine = NULL; // Unset context
-    interpreter->current_scope = old_scope;
-    interpreter->current_self_object = old_self_obj_ctx;
-    set_lexer_state(interpreter->lexer, old_lexer_state);
-    free_token(interpreter->current_token);
-    interpreter->current_token = old_current_token;
-
-    return (coro_to_run->state == CORO_SUSPENDED_AWAIT) ? STATEMENT_YIELDED_AWAIT : STATEMENT_EXECUTED_OK;
+                 (void*)interpreter->current_scope,
+                 token_type_to_string(interpreter->current_token->type),
+                 interpreter->current_token->value ? interpreter->current_token->value : "N/A",
+                 interpreter->current_token->line, interpreter->current_token->col);
+    jmp_buf* resumer_recovery_point = g_error_recovery_point;
+    if (coro_to_run->error_recovery_point) g_error_recovery_point = coro_to_run->error_recovery_point;
+    coro_context_resume(coro_to_run->context);
+    g_error_recovery_point = resumer_recovery_point;
+    if (coro_to_run->aborted_by_error && !g_error_recovery_point) {
+        report_recovered_error(); // Exits while the body's stack is still allocated
+    }
+
+    if (coro_context_finished(coro_to_run->context)) {
+        coro_context_free(coro_to_run->context);
+        coro_to_run->context = NULL;
+        // The body's registers die with it; suspended bodies saved theirs in coroutine_suspend.
+        coro_to_run->try_catch_stack_top = interpreter->try_catch_stack_top;
+        free_token(interpreter->current_token);
+        free_value_contents(interpreter->current_function_return_value);
+        free_value_contents(interpreter->current_exception);
+        arena_free(&coro_to_run->scratch);
+    }
+    coroutine_registers_restore(interpreter, &caller_registers);
+    if (coro_to_run->aborted_by_error) {
+        report_recovered_error(); // g_error_recovery_message already holds the error
+    }
+
+    DEBUG_PRINTF("CORO_BODY_EXEC: Back from coro %s (%p). State: %d",
+                 coro_to_run->name ? coro_to_run->name : "unnamed", (void*)coro_to_run, coro_to_run->state);
+    return STATEMENT_EXECUTED_OK;
 }
\ No newline at end of file
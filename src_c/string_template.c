@@ -0,0 +1,258 @@
+// src_c/string_template.c
+#include "string_template.h"
+#include "source_unit.h"       // For source_unit_create, source_unit_init_lexer
+#include "expression_parser.h" // For interpret_expression
+#include "value_utils.h"       // For value_to_string_representation, MAX_REPR_DEPTH
+#include "string_value.h"      // For string_value_alloc, string_value_length
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h> // For offsetof
+
+typedef struct StringTemplateSlot {
+    size_t literal_end;     // The slot's text goes after literal[0 .. literal_end)
+    SourceUnit* expr_unit;  // The expression between %{ and }, lexed on first evaluation
+} StringTemplateSlot;
+
+struct StringTemplate {
+    char* literal;          // Every literal segment, concatenated
+    size_t literal_length;
+    StringTemplateSlot* slots;
+    int slot_count;
+};
+
+// The text one slot contributes to the result.
+typedef struct {
+    const char* text;
+    size_t length;
+    char* owned_text;       // Set when 'text' was allocated for this render
+    Value owned_value;      // A fresh string value 'text' points into
+    bool owns_value;
+    char number_buffer[32]; // Integers, floats and booleans are formatted in place
+} StringTemplatePiece;
+
+#define STRING_TEMPLATE_STACK_PIECES 8
+
+void string_template_free(StringTemplate* tmpl) {
+    if (!tmpl) return;
+    for (int i = 0; i < tmpl->slot_count; ++i) {
+        source_unit_decref(tmpl->slots[i].expr_unit);
+    }
+    free(tmpl->slots);
+    free(tmpl->literal);
+    free(tmpl);
+}
+
+static void string_template_fail(StringTemplate* tmpl, const char* type, const char* message, Token* string_token_for_errors) {
+    string_template_free(tmpl);
+    report_error(type, message, string_token_for_errors);
+}
+
+// Returns the closing '}' of the %{ block whose content starts at 'p'.
+static const char* string_template_find_block_end(StringTemplate* tmpl, const char* p, Token* string_token_for_errors) {
+    int brace_level = 1;   // Start at 1 to account for the opening '{' of %{
+    int bracket_level = 0; // For []
+    int paren_level = 0;   // For ()
+
+    while (*p != '\0') {
+        char c = *p;
+
+        // Skip over any nested strings within the expression
+        if (c == '"' || c == '\'') {
+            char quote_type = c;
+            p++; // Move past opening quote
+            while (*p != '\0' && *p != quote_type) {
+                if (*p == '\\') {
+                    p++; // Skip escaped character
+                }
+                if (*p == '\0') break; // Avoid incrementing past null terminator
+                p++;
+            }
+            if (*p == '\0') { // Unterminated string inside expression
+                string_template_fail(tmpl, "Syntax", "Unterminated string literal within interpolated expression.", string_token_for_errors);
+            }
+            p++; // Past the closing quote
+            continue;
+        } else if (c == '{') {
+            brace_level++;
+        } else if (c == '}') {
+            brace_level--;
+            if (brace_level == 0) {
+                // Found the matching brace for our %{; other brackets must be balanced too
+                if (bracket_level != 0 || paren_level != 0) {
+                    string_template_fail(tmpl, "Syntax", "Mismatched brackets/parentheses within balanced %{...} in interpolated expression.", string_token_for_errors);
+                }
+                return p;
+            }
+        } else if (c == '[') {
+            bracket_level++;
+        } else if (c == ']') {
+            bracket_level--;
+            if (bracket_level < 0) {
+                string_template_fail(tmpl, "Syntax", "Mismatched ']' in interpolated expression.", string_token_for_errors);
+            }
+        } else if (c == '(') {
+            paren_level++;
+        } else if (c == ')') {
+            paren_level--;
+            if (paren_level < 0) {
+                string_template_fail(tmpl, "Syntax", "Mismatched ')' in interpolated expression.", string_token_for_errors);
+            }
+        }
+        p++;
+    }
+    string_template_fail(tmpl, "Syntax", "Unterminated '%{' in string interpolation (matching '}' not found).", string_token_for_errors);
+    return NULL; // Not reached
+}
+
+StringTemplate* string_template_compile(const char* raw_string, Token* string_token_for_errors) {
+    StringTemplate* tmpl = calloc(1, sizeof(StringTemplate));
+    size_t raw_length = strlen(raw_string);
+    if (tmpl) tmpl->literal = malloc(raw_length + 1); // Literal text is never longer than the raw string
+    if (!tmpl || !tmpl->literal) string_template_fail(tmpl, "System", "Failed to allocate memory for string template.", string_token_for_errors);
+    DEBUG_PRINTF("STRING_TEMPLATE_COMPILE: \"%s\" at line %d, col %d", raw_string, string_token_for_errors->line, string_token_for_errors->col);
+
+    int slot_capacity = 0;
+    const char* p = raw_string;
+    while (*p) {
+        if (p[0] != '%' || p[1] != '{') {
+            tmpl->literal[tmpl->literal_length++] = *p++;
+            continue;
+        }
+        const char* expr_start = p + 2; // Skip "%{"
+        const char* expr_end = string_template_find_block_end(tmpl, expr_start, string_token_for_errors);
+
+        size_t expr_length = (size_t)(expr_end - expr_start);
+        char* expr_text = malloc(expr_length + 1);
+        if (!expr_text) string_template_fail(tmpl, "System", "Failed to allocate memory for interpolated expression string.", string_token_for_errors);
+        memcpy(expr_text, expr_start, expr_length);
+        expr_text[expr_length] = '\0';
+
+        if (tmpl->slot_count == slot_capacity) {
+            slot_capacity = slot_capacity ? slot_capacity * 2 : 2;
+            StringTemplateSlot* new_slots = realloc(tmpl->slots, slot_capacity * sizeof(StringTemplateSlot));
+            if (!new_slots) { free(expr_text); string_template_fail(tmpl, "System", "Failed to grow string template.", string_token_for_errors); }
+            tmpl->slots = new_slots;
+        }
+        StringTemplateSlot* slot = &tmpl->slots[tmpl->slot_count++];
+        slot->literal_end = tmpl->literal_length;
+        slot->expr_unit = source_unit_create(expr_text, expr_length); // Parsed as a self-contained unit, like before
+        p = expr_end + 1; // Skip "}"
+    }
+    tmpl->literal[tmpl->literal_length] = '\0';
+    return tmpl;
+}
+
+static void string_template_release_piece(StringTemplatePiece* piece) {
+    free(piece->owned_text);
+    if (piece->owns_value) free_value_contents(piece->owned_value);
+}
+
+// Evaluates one slot's expression with the interpreter reading from the slot's unit.
+static ExprResult string_template_eval_slot(Interpreter* interpreter, const StringTemplateSlot* slot) {
+    Lexer* old_lexer = interpreter->lexer;
+    Token* old_main_token = interpreter->current_token;
+
+    Lexer expr_lexer;
+    source_unit_init_lexer(slot->expr_unit, &expr_lexer);
+    interpreter->lexer = &expr_lexer;
+    interpreter->current_token = get_next_token(&expr_lexer);
+
+    ExprResult result = interpret_expression(interpreter);
+
+    free_token(interpreter->current_token); // Borrowed from the unit, so this is a no-op
+    interpreter->lexer = old_lexer;
+    interpreter->current_token = old_main_token;
+    return result;
+}
+
+// Turns a slot's value into text. A string that is not fresh is only borrowed when
+// no later slot can run code that might replace it.
+static void string_template_fill_piece(Interpreter* interpreter, StringTemplatePiece* piece, ExprResult res, bool is_last_slot, Token* string_token_for_errors) {
+    Value val = res.value;
+    if (interpreter->repr_depth_count < MAX_REPR_DEPTH) {
+        switch (val.type) {
+            case VAL_STRING:
+                if (res.is_freshly_created_container) {
+                    piece->owned_value = val;
+                    piece->owns_value = true;
+                    piece->text = val.as.string_val;
+                } else if (is_last_slot) {
+                    piece->text = val.as.string_val;
+                } else {
+                    break;
+                }
+                piece->length = string_value_length(piece->text);
+                return;
+            case VAL_INT:
+                piece->length = (size_t)snprintf(piece->number_buffer, sizeof(piece->number_buffer), "%ld", val.as.integer);
+                piece->text = piece->number_buffer;
+                return;
+            case VAL_FLOAT:
+                piece->length = (size_t)snprintf(piece->number_buffer, sizeof(piece->number_buffer), "%g", val.as.floating);
+                piece->text = piece->number_buffer;
+                return;
+            case VAL_BOOL:
+                piece->text = val.as.bool_val ? "true" : "false";
+                piece->length = strlen(piece->text);
+                return;
+            default:
+                break;
+        }
+    }
+    piece->owned_text = value_to_string_representation(val, interpreter, string_token_for_errors);
+    piece->text = piece->owned_text;
+    piece->length = strlen(piece->text);
+    if (res.is_freshly_created_container) free_value_contents(val);
+}
+
+Value string_template_render(Interpreter* interpreter, const StringTemplate* tmpl, Token* string_token_for_errors) {
+    StringTemplatePiece stack_pieces[STRING_TEMPLATE_STACK_PIECES];
+    StringTemplatePiece* pieces = stack_pieces;
+    if (tmpl->slot_count > STRING_TEMPLATE_STACK_PIECES) {
+        pieces = malloc(tmpl->slot_count * sizeof(StringTemplatePiece));
+        if (!pieces) report_error("System", "Failed to allocate memory for string interpolation.", string_token_for_errors);
+    }
+
+    size_t total_length = tmpl->literal_length;
+    for (int i = 0; i < tmpl->slot_count; ++i) {
+        StringTemplatePiece* piece = &pieces[i];
+        memset(piece, 0, offsetof(StringTemplatePiece, number_buffer));
+
+        ExprResult res = string_template_eval_slot(interpreter, &tmpl->slots[i]);
+        if (!interpreter->exception_is_active) {
+            string_template_fill_piece(interpreter, piece, res, i == tmpl->slot_count - 1, string_token_for_errors);
+        } else if (res.is_freshly_created_container) {
+            free_value_contents(res.value);
+        }
+        // The expression or its op_str may have raised: stop and let the caller see the exception.
+        if (interpreter->exception_is_active) {
+            DEBUG_PRINTF("STRING_TEMPLATE_RENDER: Exception in slot %d. Aborting.", i);
+            for (int j = 0; j <= i; ++j) string_template_release_piece(&pieces[j]);
+            if (pieces != stack_pieces) free(pieces);
+            return create_null_value();
+        }
+        total_length += piece->length;
+    }
+
+    char* buffer = string_value_alloc(total_length);
+    char* out = buffer;
+    size_t literal_pos = 0;
+    for (int i = 0; i < tmpl->slot_count; ++i) {
+        size_t literal_end = tmpl->slots[i].literal_end;
+        memcpy(out, tmpl->literal + literal_pos, literal_end - literal_pos);
+        out += literal_end - literal_pos;
+        literal_pos = literal_end;
+        memcpy(out, pieces[i].text, pieces[i].length);
+        out += pieces[i].length;
+        string_template_release_piece(&pieces[i]);
+    }
+    memcpy(out, tmpl->literal + literal_pos, tmpl->literal_length - literal_pos);
+    out[tmpl->literal_length - literal_pos] = '\0';
+    if (pieces != stack_pieces) free(pieces);
+
+    Value result;
+    result.type = VAL_STRING;
+    result.as.string_val = buffer;
+    return result;
+}
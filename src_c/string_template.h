@@ -0,0 +1,23 @@
+// src_c/string_template.h
+#ifndef ECHOC_STRING_TEMPLATE_H
+#define ECHOC_STRING_TEMPLATE_H
+
+#include "header.h" // Provides Interpreter, Token, Value
+
+// A string literal with %{expr} blocks, split once into its literal text and
+// expression slots. Each slot's expression is kept as its own SourceUnit, so
+// evaluating it reads pre-lexed tokens (and their caches) instead of copying
+// and re-scanning the expression text every time the literal runs.
+typedef struct StringTemplate StringTemplate;
+
+// Splits 'raw_string' (a string token's value) into a template. Syntax errors in
+// the %{...} blocks are reported against 'string_token_for_errors'.
+StringTemplate* string_template_compile(const char* raw_string, Token* string_token_for_errors);
+
+void string_template_free(StringTemplate* tmpl);
+
+// Evaluates every slot in order and builds the resulting VAL_STRING in a single
+// allocation. If a slot raises, returns null with the exception left active.
+Value string_template_render(Interpreter* interpreter, const StringTemplate* tmpl, Token* string_token_for_errors);
+
+#endif // ECHOC_STRING_TEMPLATE_H
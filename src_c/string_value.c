@@ -0,0 +1,143 @@
+// src_c/string_value.c
+#include "string_value.h"
+#include "dictionary.h" // For hash_string
+#include <stddef.h> // For offsetof
+#include <string.h> // For memcpy, memcmp, strlen
+#include <stdlib.h> // For malloc, realloc, free
+#include <limits.h> // For INT_MAX
+
+#define STRING_STATIC_REFS INT_MAX // ref_count of the preallocated strings, which never changes
+
+// A string value: holders point at 'text', the header sits just before it.
+typedef struct StringHeader {
+    int ref_count;
+    uint32_t hash;   // Valid when has_hash
+    size_t length;
+    size_t capacity; // Bytes allocated for 'text', including the NUL
+    bool has_hash;
+    char text[];
+} StringHeader;
+
+// The empty string and the one-character strings, created on first use.
+static char* single_char_strings[256];
+
+static StringHeader* string_header(const char* string) {
+    return (StringHeader*)(string - offsetof(StringHeader, text));
+}
+
+static StringHeader* string_header_alloc(size_t capacity) {
+    StringHeader* header = malloc(sizeof(StringHeader) + capacity);
+    if (!header) report_error("System", "Failed to allocate memory for string", NULL);
+    header->ref_count = 1;
+    header->has_hash = false;
+    header->capacity = capacity;
+    return header;
+}
+
+char* string_value_alloc(size_t length) {
+    StringHeader* header = string_header_alloc(length + 1);
+    header->length = length;
+    header->text[length] = '\0';
+    return header->text;
+}
+
+char* string_value_create_n(const char* text, size_t length) {
+    char* string = string_value_alloc(length);
+    memcpy(string, text, length);
+    return string;
+}
+
+char* string_value_create(const char* text) {
+    return string_value_create_n(text, strlen(text));
+}
+
+char* string_value_char(unsigned char c) {
+    char* string = single_char_strings[c];
+    if (!string) {
+        string = string_value_alloc(c ? 1 : 0);
+        string[0] = (char)c;
+        string_header(string)->ref_count = STRING_STATIC_REFS;
+        single_char_strings[c] = string;
+    }
+    return string;
+}
+
+char* string_value_repeat(const char* string, size_t times) {
+    size_t length = string_value_length(string);
+    size_t total = length * times;
+    char* repeated = string_value_alloc(total);
+    if (total == 0) return repeated;
+    // Copy once, then keep doubling the filled prefix: log2(times) memcpy calls.
+    memcpy(repeated, string, length);
+    size_t filled = length;
+    while (filled < total) {
+        size_t chunk = filled <= total - filled ? filled : total - filled;
+        memcpy(repeated + filled, repeated, chunk);
+        filled += chunk;
+    }
+    return repeated;
+}
+
+char* string_value_retain(char* string) {
+    StringHeader* header = string_header(string);
+    if (header->ref_count != STRING_STATIC_REFS) header->ref_count++;
+    return string;
+}
+
+void string_value_release(char* string) {
+    if (!string) return;
+    StringHeader* header = string_header(string);
+    if (header->ref_count == STRING_STATIC_REFS) return;
+    if (--header->ref_count == 0) free(header);
+}
+
+size_t string_value_length(const char* string) {
+    return string_header(string)->length;
+}
+
+uint32_t string_value_hash(const char* string) {
+    StringHeader* header = string_header(string);
+    if (!header->has_hash) {
+        header->hash = (uint32_t)hash_string(string);
+        header->has_hash = true;
+    }
+    return header->hash;
+}
+
+bool string_value_equal(const char* a, const char* b) {
+    if (a == b) return true;
+    const StringHeader* header_a = string_header(a);
+    const StringHeader* header_b = string_header(b);
+    if (header_a->length != header_b->length) return false;
+    if (header_a->has_hash && header_b->has_hash && header_a->hash != header_b->hash) return false;
+    return memcmp(a, b, header_a->length) == 0;
+}
+
+void string_value_append(Value* target, const char* text, size_t length, bool will_grow_again) {
+    if (length == 0) return;
+    StringHeader* header = string_header(target->as.string_val);
+    size_t new_length = header->length + length;
+    size_t capacity = new_length + 1;
+    if (will_grow_again && header->capacity * 2 > capacity) capacity = header->capacity * 2;
+
+    if (header->ref_count != 1) { // Shared: others keep the original text
+        StringHeader* copy = string_header_alloc(capacity);
+        memcpy(copy->text, header->text, header->length);
+        memcpy(copy->text + header->length, text, length);
+        copy->length = new_length;
+        copy->text[new_length] = '\0';
+        string_value_release(header->text);
+        target->as.string_val = copy->text;
+        return;
+    }
+    if (new_length + 1 > header->capacity) {
+        header = realloc(header, sizeof(StringHeader) + capacity);
+        if (!header) report_error("System", "Failed to grow string while concatenating", NULL);
+        header->capacity = capacity;
+    }
+    memcpy(header->text + header->length, text, length);
+    header->length = new_length;
+    header->text[new_length] = '\0';
+    header->has_hash = false;
+    target->as.string_val = header->text;
+}
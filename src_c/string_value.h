@@ -0,0 +1,54 @@
+// src_c/string_value.h
+#ifndef ECHOC_STRING_VALUE_H
+#define ECHOC_STRING_VALUE_H
+
+#include "header.h" // Provides Value, uint32_t, size_t, report_error
+
+// The text held by a VAL_STRING. 'string_val' points at NUL-terminated characters
+// preceded by a header with their length, the bytes allocated for them, a hash that
+// is computed on first use and a reference count. Strings are immutable once shared:
+// value_deep_copy takes a reference instead of copying the text, and only a string
+// nothing else refers to may be extended in place (string_value_append). The empty
+// string and every one-character string are preallocated and never freed, so indexing
+// a string or iterating over its characters allocates nothing.
+
+// New string holding a copy of the first 'length' bytes of 'text', with one reference.
+char* string_value_create_n(const char* text, size_t length);
+
+// New string holding a copy of the C string 'text'.
+char* string_value_create(const char* text);
+
+// New string of 'length' bytes for the caller to fill in; the terminating NUL is set.
+char* string_value_alloc(size_t length);
+
+// The shared, never freed string holding just 'c' ('\0' gives the empty string).
+char* string_value_char(unsigned char c);
+
+// Takes another reference to 'string' and returns it.
+char* string_value_retain(char* string);
+
+// Drops a reference to 'string' and frees it when that was the last one (NULL is ignored).
+void string_value_release(char* string);
+
+// Length in bytes, stored in the header.
+size_t string_value_length(const char* string);
+
+// hash_string of the text, computed on the first call and cached until it changes.
+uint32_t string_value_hash(const char* string);
+
+// True if both strings hold the same text. Compares lengths, then cached hashes, and
+// only then the characters.
+bool string_value_equal(const char* a, const char* b);
+
+// New string holding 'times' copies of 'string'. The caller checks that the result's
+// length fits in a size_t.
+char* string_value_repeat(const char* string, size_t times);
+
+// Appends 'length' bytes of 'text' to the string held in 'target', which may move. A
+// shared string is first replaced by a private copy (dropping one reference to it).
+// With 'will_grow_again' the buffer is over-allocated geometrically, so repeated
+// appends to the same string take amortized constant time per byte. 'text' must not
+// point into the target's buffer.
+void string_value_append(Value* target, const char* text, size_t length, bool will_grow_again);
+
+#endif // ECHOC_STRING_VALUE_H
@@ -0,0 +1,315 @@
+// src_c/unit_cache.c
+#include "unit_cache.h"
+
+#ifndef _WIN32
+
+#include "intern.h" // Cached token values are interned like lexed ones
+#include <errno.h>
+#include <limits.h> // For INT_MAX
+#include <stdint.h>
+#include <unistd.h> // For getpid
+
+#define UNIT_CACHE_MAGIC "ECTOKEN"
+#define UNIT_CACHE_FORMAT_VERSION 1u
+// Any rebuild of the interpreter may change token types or lexing rules, so entries
+// are tied to the build that wrote them, not just to ECHOC_VERSION.
+#define UNIT_CACHE_BUILD_ID ECHOC_VERSION " " __DATE__ " " __TIME__
+
+// Entry layout: header, the source's absolute path, token_count records, then the
+// NUL-terminated token values back to back. Native byte order: entries are only
+// ever read back by the build that wrote them.
+typedef struct {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t token_type_count; // TOKEN_UNKNOWN + 1 when written
+    char build_id[64];
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t source_hash;      // unit_cache_hash of the text
+    uint32_t path_length;
+    uint32_t token_count;
+    uint32_t string_size;
+    uint32_t reserved;
+} UnitCacheHeader;
+
+typedef struct {
+    int32_t type;
+    int32_t value_offset; // Into the string section, or -1 for a NULL value
+    int32_t line, col;
+    int32_t start_pos, end_pos, end_line, end_col;
+    int32_t slot, frame_size;
+    int32_t frame_owner;  // Token index of SourceUnitToken.frame_owner, or -1
+} UnitCacheToken;
+
+// Values of tokens that do not own their value are these literals (see get_next_token).
+static const char* const unit_cache_fixed_values[] = {
+    "+", "-", "*", "/", "%", "^", "(", ")", ":", "{", "}", "?", ",",
+    "[", ".", "]", "=", "<", ">", ""
+};
+
+// 64-bit FNV-1a.
+static uint64_t unit_cache_hash(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Directory holding the entries, or NULL when caching is disabled. Caller frees.
+static char* unit_cache_directory(void) {
+    const char* override = getenv("ECHOC_CACHE_DIR");
+    if (override) return override[0] ? strdup(override) : NULL;
+    const char* base = getenv("XDG_CACHE_HOME");
+    const char* suffix = "/echoc";
+    if (!base || !base[0]) {
+        base = getenv("HOME");
+        suffix = "/.cache/echoc";
+    }
+    if (!base || !base[0]) return NULL;
+    char* directory = malloc(strlen(base) + strlen(suffix) + 1);
+    if (!directory) return NULL;
+    sprintf(directory, "%s%s", base, suffix);
+    return directory;
+}
+
+// Entry file for 'absolute_path' inside 'directory', named by the hash of the path
+// (the header repeats the full path, so a hash collision is a miss). Caller frees.
+static char* unit_cache_entry_path(const char* directory, const char* absolute_path) {
+    char* entry_path = malloc(strlen(directory) + 32);
+    if (!entry_path) return NULL;
+    sprintf(entry_path, "%s/%016llx.etok", directory, (unsigned long long)unit_cache_hash(absolute_path, strlen(absolute_path)));
+    return entry_path;
+}
+
+// mkdir -p; returns false if 'directory' does not exist afterwards.
+static bool unit_cache_make_directory(char* directory) {
+    for (char* p = directory + 1; *p; ++p) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(directory, 0755);
+        *p = '/';
+    }
+    return mkdir(directory, 0755) == 0 || errno == EEXIST;
+}
+
+static const char* unit_cache_fixed_value(const char* value) {
+    for (size_t i = 0; i < sizeof(unit_cache_fixed_values) / sizeof(unit_cache_fixed_values[0]); ++i) {
+        if (strcmp(unit_cache_fixed_values[i], value) == 0) return unit_cache_fixed_values[i];
+    }
+    return NULL;
+}
+
+// Checks a whole entry against 'unit' before anything is copied out of it, so a stale,
+// truncated or foreign file is rejected without touching the unit.
+static bool unit_cache_entry_is_valid(const SourceUnit* unit, const char* data, size_t size) {
+    if (size < sizeof(UnitCacheHeader)) return false;
+    UnitCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, UNIT_CACHE_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.format_version != UNIT_CACHE_FORMAT_VERSION || header.token_type_count != (uint32_t)TOKEN_UNKNOWN + 1) return false;
+    if (strncmp(header.build_id, UNIT_CACHE_BUILD_ID, sizeof(header.build_id)) != 0) return false;
+    if (header.source_size != unit->text_length || header.source_mtime != unit->source_mtime) return false;
+    if (header.token_count == 0 || header.token_count > (uint32_t)INT_MAX / sizeof(UnitCacheToken)) return false;
+    size_t expected = sizeof(header) + (size_t)header.path_length + (size_t)header.token_count * sizeof(UnitCacheToken) + header.string_size;
+    if (size != expected) return false;
+    if (header.path_length != strlen(unit->source_path) || memcmp(data + sizeof(header), unit->source_path, header.path_length) != 0) return false;
+    if (header.string_size > 0 && data[size - 1] != '\0') return false;
+
+    const char* records = data + sizeof(header) + header.path_length;
+    const char* strings = data + size - header.string_size;
+    for (uint32_t i = 0; i < header.token_count; ++i) {
+        UnitCacheToken record;
+        memcpy(&record, records + (size_t)i * sizeof(record), sizeof(record));
+        if (record.type < 0 || record.type >= (int32_t)TOKEN_UNKNOWN) return false;
+        if ((record.type == TOKEN_EOF) != (i == header.token_count - 1)) return false; // EOF exactly once, last
+        if (record.value_offset < -1 || (record.value_offset >= 0 && (uint32_t)record.value_offset >= header.string_size)) return false;
+        if (record.value_offset >= 0 && !token_type_owns_value((TokenType)record.type) &&
+            !unit_cache_fixed_value(strings + record.value_offset)) return false;
+        if (record.frame_owner < -1 || record.frame_owner > (int32_t)i) return false; // Owners precede their body
+        if (record.slot >= 0) { // Slots index the owner's frame
+            UnitCacheToken owner;
+            if (record.frame_owner < 0) return false;
+            memcpy(&owner, records + (size_t)record.frame_owner * sizeof(owner), sizeof(owner));
+            if (owner.frame_owner != record.frame_owner || record.slot >= owner.frame_size) return false;
+        }
+    }
+    // The text hash last: it is the only check that reads the whole source.
+    return header.source_hash == unit_cache_hash(unit->text, unit->text_length);
+}
+
+bool unit_cache_load(SourceUnit* unit, const char* path, const struct stat* file_stat) {
+    char* directory = unit_cache_directory();
+    if (!directory) return false;
+    unit->source_path = realpath(path, NULL);
+    unit->source_mtime = (long long)file_stat->st_mtime;
+    char* entry_path = unit->source_path ? unit_cache_entry_path(directory, unit->source_path) : NULL;
+    free(directory);
+    if (!entry_path) return false;
+
+    FILE* file = fopen(entry_path, "rb");
+    free(entry_path);
+    if (!file) return false;
+    struct stat entry_stat;
+    char* data = NULL;
+    size_t size = 0;
+    if (fstat(fileno(file), &entry_stat) == 0 && entry_stat.st_size > 0) {
+        size = (size_t)entry_stat.st_size;
+        data = malloc(size);
+        if (data && fread(data, 1, size, file) != size) { free(data); data = NULL; }
+    }
+    fclose(file);
+    if (!data || !unit_cache_entry_is_valid(unit, data, size)) { free(data); return false; }
+
+    UnitCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    const char* records = data + sizeof(header) + header.path_length;
+    const char* strings = data + size - header.string_size;
+    for (uint32_t i = 0; i < header.token_count; ++i) {
+        UnitCacheToken record;
+        memcpy(&record, records + (size_t)i * sizeof(record), sizeof(record));
+        SourceUnitToken* entry = source_unit_append_entry(unit);
+        entry->token.type = (TokenType)record.type;
+        entry->token.value = NULL;
+        if (record.value_offset >= 0) {
+            const char* value = strings + record.value_offset;
+            entry->token.value = (char*)(token_type_owns_value(entry->token.type) ? intern_acquire(value) : unit_cache_fixed_value(value));
+        }
+        entry->token.line = record.line;
+        entry->token.col = record.col;
+        entry->token.is_borrowed = true;
+        entry->start_pos = record.start_pos;
+        entry->end_pos = record.end_pos;
+        entry->end_line = record.end_line;
+        entry->end_col = record.end_col;
+        entry->slot = record.slot;
+        entry->frame_size = record.frame_size;
+        entry->frame_owner = record.frame_owner >= 0 ? SOURCE_UNIT_ENTRY(unit, record.frame_owner) : NULL;
+        entry->attr_shape_id = 0;
+        entry->attr_slot = -1;
+        entry->attr_class_value = NULL;
+        entry->attr_transition = NULL;
+        entry->string_template = NULL;
+        entry->literal_string = NULL;
+        entry->next_dedent = -1;
+    }
+    free(data);
+
+    // Leave the scan lexer where lexing the whole text would have.
+    const SourceUnitToken* eof = SOURCE_UNIT_ENTRY(unit, unit->token_count - 1);
+    unit->scan_lexer.pos = (int)unit->text_length;
+    unit->scan_lexer.current_char = '\0';
+    unit->scan_lexer.line = eof->end_line;
+    unit->scan_lexer.col = eof->end_col;
+    unit->reached_eof = true;
+    unit->loaded_from_cache = true;
+    DEBUG_PRINTF("UNIT_CACHE_HIT: %s (%d tokens)", unit->source_path, unit->token_count);
+    return true;
+}
+
+// Token index of 'owner'. Tokens of one body share an owner, so the last answer is remembered.
+static int32_t unit_cache_owner_index(const SourceUnit* unit, const SourceUnitToken* owner,
+                                      const SourceUnitToken** last_owner, int32_t* last_index) {
+    if (!owner) return -1;
+    if (owner == *last_owner) return *last_index;
+    for (int b = 0; b < unit->block_count; ++b) {
+        const SourceUnitToken* block = unit->token_blocks[b];
+        if (owner >= block && owner < block + SOURCE_UNIT_TOKEN_BLOCK) {
+            *last_owner = owner;
+            *last_index = (int32_t)(b * SOURCE_UNIT_TOKEN_BLOCK + (owner - block));
+            return *last_index;
+        }
+    }
+    return -1;
+}
+
+void unit_cache_store(SourceUnit* unit) {
+    if (!unit->source_path || unit->loaded_from_cache || !unit->reached_eof) return;
+    char* directory = unit_cache_directory();
+    if (!directory) return;
+    char* entry_path = unit_cache_make_directory(directory) ? unit_cache_entry_path(directory, unit->source_path) : NULL;
+    free(directory);
+    if (!entry_path) return;
+
+    UnitCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, UNIT_CACHE_MAGIC, sizeof(header.magic));
+    header.format_version = UNIT_CACHE_FORMAT_VERSION;
+    header.token_type_count = (uint32_t)TOKEN_UNKNOWN + 1;
+    strncpy(header.build_id, UNIT_CACHE_BUILD_ID, sizeof(header.build_id) - 1);
+    header.source_size = unit->text_length;
+    header.source_mtime = unit->source_mtime;
+    header.source_hash = unit_cache_hash(unit->text, unit->text_length);
+    header.path_length = (uint32_t)strlen(unit->source_path);
+    header.token_count = (uint32_t)unit->token_count;
+
+    UnitCacheToken* records = malloc((size_t)unit->token_count * sizeof(UnitCacheToken));
+    size_t string_capacity = 4096;
+    char* strings = malloc(string_capacity);
+    bool ok = records && strings;
+    const SourceUnitToken* last_owner = NULL;
+    int32_t last_owner_index = -1;
+    for (int i = 0; ok && i < unit->token_count; ++i) {
+        const SourceUnitToken* entry = SOURCE_UNIT_ENTRY(unit, i);
+        UnitCacheToken* record = &records[i];
+        memset(record, 0, sizeof(*record));
+        record->type = entry->token.type;
+        record->value_offset = -1;
+        if (entry->token.value) {
+            size_t length = strlen(entry->token.value) + 1;
+            if (header.string_size + length > string_capacity) {
+                while (header.string_size + length > string_capacity) string_capacity *= 2;
+                char* new_strings = realloc(strings, string_capacity);
+                if (!new_strings) { ok = false; break; }
+                strings = new_strings;
+            }
+            record->value_offset = (int32_t)header.string_size;
+            memcpy(strings + header.string_size, entry->token.value, length);
+            header.string_size += (uint32_t)length;
+        }
+        record->line = entry->token.line;
+        record->col = entry->token.col;
+        record->start_pos = entry->start_pos;
+        record->end_pos = entry->end_pos;
+        record->end_line = entry->end_line;
+        record->end_col = entry->end_col;
+        record->slot = entry->slot;
+        record->frame_size = entry->frame_size;
+        record->frame_owner = unit_cache_owner_index(unit, entry->frame_owner, &last_owner, &last_owner_index);
+    }
+
+    // Write a private temporary file and rename it over the entry, so concurrent runs
+    // never read a half-written entry.
+    char* temp_path = ok ? malloc(strlen(entry_path) + 32) : NULL;
+    if (temp_path) {
+        sprintf(temp_path, "%s.%ld.tmp", entry_path, (long)getpid());
+        FILE* file = fopen(temp_path, "wb");
+        if (file) {
+            ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 fwrite(unit->source_path, 1, header.path_length, file) == header.path_length &&
+                 fwrite(records, sizeof(UnitCacheToken), (size_t)unit->token_count, file) == (size_t)unit->token_count &&
+                 fwrite(strings, 1, header.string_size, file) == header.string_size;
+            ok = fclose(file) == 0 && ok;
+            if (!ok || rename(temp_path, entry_path) != 0) remove(temp_path);
+            else DEBUG_PRINTF("UNIT_CACHE_STORE: %s (%d tokens)", unit->source_path, unit->token_count);
+        }
+        free(temp_path);
+    }
+    free(records);
+    free(strings);
+    free(entry_path);
+}
+
+#else // _WIN32: no persistent cache.
+
+bool unit_cache_load(SourceUnit* unit, const char* path, const struct stat* file_stat) {
+    (void)unit; (void)path; (void)file_stat;
+    return false;
+}
+
+void unit_cache_store(SourceUnit* unit) {
+    (void)unit;
+}
+
+#endif
@@ -0,0 +1,28 @@
+// src_c/unit_cache.h
+#ifndef ECHOC_UNIT_CACHE_H
+#define ECHOC_UNIT_CACHE_H
+
+#include "source_unit.h"
+#include <sys/stat.h> // For struct stat
+
+// Persistent, on-disk cache of lexed source units. After a file has been fully
+// tokenized its token stream (with positions and the frame slots resolved so far)
+// is written to one entry per source file; a later run that opens the same, unchanged
+// file fills its unit from that entry instead of lexing the text again.
+//
+// Entries live in $ECHOC_CACHE_DIR, else $XDG_CACHE_HOME/echoc, else $HOME/.cache/echoc;
+// setting ECHOC_CACHE_DIR to an empty string disables the cache. An entry is used only
+// when the absolute path, size, modification time and content hash of the file and the
+// interpreter build that wrote it all match, so editing the file or rebuilding EchoC
+// invalidates it. Every cache failure is silent and falls back to lexing.
+
+// Called by source_unit_load_file with a freshly created 'unit' for 'path'. Remembers
+// where the unit's entry lives, and returns true if the unit was filled from it (the
+// unit is then fully lexed, with reached_eof set).
+bool unit_cache_load(SourceUnit* unit, const char* path, const struct stat* file_stat);
+
+// Writes the unit's entry once the whole text has been lexed. Does nothing for units
+// that were not loaded from a file, came from the cache, or stopped short of EOF.
+void unit_cache_store(SourceUnit* unit);
+
+#endif // ECHOC_UNIT_CACHE_H
@@ -4,9 +4,18 @@
 #include "scope.h" // For symbol_table_get
 #include "dictionary.h" // For dictionary_try_get
 #include "modules/builtins.h" // For builtin_append
+#include "modules/string_methods.h" // For string_method_name
+#include "coro_context.h" // For coro_context_free
+#include "arena.h" // For arena_free
+#include "source_unit.h" // For SourceUnitToken (cached string templates)
+#include "string_template.h" // For string_template_compile, string_template_render
+#include "packed_array.h" // For packed_array_clone
+#include "intern.h" // For the interned 'self' symbol name
+#include "string_value.h" // For string_value_create, string_value_length
 #include <stdio.h>  // For sprintf, snprintf
 #include <string.h> // For strdup, strcpy, strcat, strncpy, strlen
 #include <stdlib.h> // For malloc, free
+#include <stddef.h> // For offsetof
 
 extern void interpret_statement(Interpreter* interpreter); // From statement_parser.c
 
@@ -90,8 +99,7 @@ static char* call_op_str_on_object(Interpreter* interpreter, Object* self_obj, F
     // Manually insert 'self' as a direct reference, similar to execute_echoc_function
     SymbolNode* self_node_for_op_str = (SymbolNode*)malloc(sizeof(SymbolNode));
     if (!self_node_for_op_str) report_error("System", "Failed to allocate memory for 'self' symbol in op_str", error_token_context);
-    self_node_for_op_str->name = strdup("self");
-    if (!self_node_for_op_str->name) { free(self_node_for_op_str); report_error("System", "Failed to strdup 'self' name for op_str", error_token_context); }
+    self_node_for_op_str->name = intern_acquire("self");
     self_node_for_op_str->value.type = VAL_OBJECT;
     self_node_for_op_str->value.as.object_val = self_obj; // Direct reference, not a deep copy
     self_node_for_op_str->next = interpreter->current_scope->symbols;
@@ -103,7 +111,7 @@ static char* call_op_str_on_object(Interpreter* interpreter, Object* self_obj, F
         interpreter->exception_is_active = 1;
         free_value_contents(interpreter->current_exception);
         interpreter->current_exception.type = VAL_STRING;
-        interpreter->current_exception.as.string_val = strdup("op_str method must only take 'self' as a parameter.");
+        interpreter->current_exception.as.string_val = string_value_create("op_str method must only take 'self' as a parameter.");
         exit_scope(interpreter);
         interpreter->current_scope = old_scope;
         interpreter->current_self_object = old_self_obj_ctx;
@@ -115,12 +123,8 @@ static char* call_op_str_on_object(Interpreter* interpreter, Object* self_obj, F
     }
 
     // Prepare and set lexer state for op_str body execution
-    LexerState effective_op_str_body_start_state = op_str_func->body_start_state;
-    // Ensure the lexer state uses the function's persistent owned copy of the source text.
-    effective_op_str_body_start_state.text = op_str_func->source_text_owned_copy;
-    effective_op_str_body_start_state.text_length = op_str_func->source_text_length;
-    // The pos, line, col, current_char from body_start_state are valid for this text.
-    set_lexer_state(interpreter->lexer, effective_op_str_body_start_state);
+    // body_start_state points into the function's shared source unit, which outlives this call.
+    set_lexer_state(interpreter->lexer, op_str_func->body_start_state);
 
 
     // Free the token that was current in the caller's context before fetching the new one
@@ -140,13 +144,13 @@ static char* call_op_str_on_object(Interpreter* interpreter, Object* self_obj, F
         interpret_statement(interpreter); // interpret_statement is in statement_parser.h
         
         // If op_str itself yields or contains other illegal control flow, it's an error.
-        if (interpreter->break_flag || interpreter->continue_flag || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
+        if (interpreter->break_flag || interpreter->continue_flag) {
             // FIX: Instead of calling report_error (which exits and leaks), set the exception flag
             // and return an error string. This allows the caller to clean up.
             interpreter->exception_is_active = 1;
             free_value_contents(interpreter->current_exception);
             interpreter->current_exception.type = VAL_STRING;
-            interpreter->current_exception.as.string_val = strdup("op_str method cannot contain yield (await) or loop control statements (break, continue).");
+            interpreter->current_exception.as.string_val = string_value_create("op_str method cannot contain yield (await) or loop control statements (break, continue).");
 
             // Restore state before returning
             set_lexer_state(interpreter->lexer, state_before_op_str_call);
@@ -207,7 +211,7 @@ static char* call_op_str_on_object(Interpreter* interpreter, Object* self_obj, F
         interpreter->exception_is_active = 1;
         free_value_contents(interpreter->current_exception);
         interpreter->current_exception.type = VAL_STRING;
-        interpreter->current_exception.as.string_val = strdup("op_str method must return a string.");
+        interpreter->current_exception.as.string_val = string_value_create("op_str method must return a string.");
         free_value_contents(result_val);
 
         return strdup("<op_str error>");
@@ -217,11 +221,9 @@ static char* call_op_str_on_object(Interpreter* interpreter, Object* self_obj, F
     return str_to_return;
 }
 
-#define MAX_REPR_DEPTH 8 // A reasonable depth limit
-
 char* value_to_string_representation(Value val, Interpreter* interpreter, Token* error_token_context) {
     if (interpreter->repr_depth_count >= MAX_REPR_DEPTH) {
-        if (val.type == VAL_ARRAY) return strdup("[...]");
+        if (val.type == VAL_ARRAY || val.type == VAL_PACKED_ARRAY) return strdup("[...]");
         if (val.type == VAL_TUPLE) return strdup("(...)");
         if (val.type == VAL_DICT) return strdup("{...}");
         if (val.type == VAL_OBJECT) return strdup("<...>");
@@ -269,6 +271,29 @@ char* value_to_string_representation(Value val, Interpreter* interpreter, Token*
             result = ds_finalize(&ds);
             break;
         }
+        case VAL_PACKED_ARRAY: {
+            // Printed like the generic array holding the same numbers.
+            PackedArray* arr = val.as.packed_array_val;
+            DynamicString ds;
+            ds_init(&ds, 128);
+            ds_append_str(&ds, "[");
+            for (int i = 0; i < arr->count; ++i) {
+                if (arr->kind == PACKED_INT) sprintf(num_buffer, "%ld", (long)arr->data.ints[i]);
+                else sprintf(num_buffer, "%g", arr->data.floats[i]);
+                ds_append_str(&ds, num_buffer);
+                if (i < arr->count - 1) ds_append_str(&ds, ", ");
+            }
+            ds_append_str(&ds, "]");
+            result = ds_finalize(&ds);
+            break;
+        }
+        case VAL_RANGE: {
+            Range* range = val.as.range_val;
+            if (range->step == 1) sprintf(num_buffer, "range(%ld, %ld)", range->start, range->stop);
+            else sprintf(num_buffer, "range(%ld, %ld, %ld)", range->start, range->stop, range->step);
+            result = strdup(num_buffer);
+            break;
+        }
         case VAL_TUPLE: {
             DynamicString ds;
             ds_init(&ds, 128);
@@ -292,21 +317,18 @@ char* value_to_string_representation(Value val, Interpreter* interpreter, Token*
             ds_append_str(&ds, "{");
             int first_entry = 1;
             Dictionary* dict = val.as.dict_val; // Get the dictionary pointer
-            for (int i = 0; i < dict->num_buckets; ++i) {
-                DictEntry* entry = dict->buckets[i];
-                while (entry) {
-                    if (!first_entry) {
-                        ds_append_str(&ds, ", ");
-                    }
-                    ds_append_str(&ds, "\""); // Add quotes around the key
-                    ds_append_str(&ds, entry->key); // Add the key string
-                    ds_append_str(&ds, "\": "); // Add closing quote and colon-space
-                    char* val_str = value_to_string_representation(entry->value, interpreter, error_token_context); // Recursive call for value
-                    ds_append_str(&ds, val_str);
-                    free(val_str);
-                    first_entry = 0;
-                    entry = entry->next;
+            for (int i = 0; i < dict->count; ++i) {
+                DictEntry* entry = &dict->entries[i];
+                if (!first_entry) {
+                    ds_append_str(&ds, ", ");
                 }
+                ds_append_str(&ds, "\""); // Add quotes around the key
+                ds_append_str(&ds, entry->key); // Add the key string
+                ds_append_str(&ds, "\": "); // Add closing quote and colon-space
+                char* val_str = value_to_string_representation(entry->value, interpreter, error_token_context); // Recursive call for value
+                ds_append_str(&ds, val_str);
+                free(val_str);
+                first_entry = 0;
             }
             ds_append_str(&ds, "}"); // Add closing brace
             result = ds_finalize(&ds);
@@ -367,6 +389,8 @@ char* value_to_string_representation(Value val, Interpreter* interpreter, Token*
                 owner_type_name = bm->self_value.as.object_val->blueprint->name;
             } else if (bm->self_value.type == VAL_ARRAY) {
                 owner_type_name = "Array"; // For methods like array.append
+            } else if (bm->self_value.type == VAL_STRING) {
+                owner_type_name = "String";
             }
             // Add other self_value types here if they can have bound methods
 
@@ -376,6 +400,8 @@ char* value_to_string_representation(Value val, Interpreter* interpreter, Token*
                 // Attempt to identify common C built-ins if possible
                 if (bm->self_value.type == VAL_ARRAY && bm->func_ptr.c_builtin == builtin_append) {
                      method_name = "append";
+                } else if (bm->self_value.type == VAL_STRING && string_method_name(bm->func_ptr.c_builtin)) {
+                     method_name = string_method_name(bm->func_ptr.c_builtin);
                 } else {
                     method_name = "c_builtin"; // Generic name for other C built-ins
                 }
@@ -390,7 +416,7 @@ char* value_to_string_representation(Value val, Interpreter* interpreter, Token*
             interpreter->current_exception.type = VAL_STRING;
             char err_msg[100];
             snprintf(err_msg, sizeof(err_msg), "Cannot convert unknown value type %d to string.", val.type);
-            interpreter->current_exception.as.string_val = strdup(err_msg);
+            interpreter->current_exception.as.string_val = string_value_create(err_msg);
             result = strdup("<conversion error>");
             break;
     }
@@ -400,231 +426,37 @@ char* value_to_string_representation(Value val, Interpreter* interpreter, Token*
 }
 
 Value evaluate_interpolated_string(Interpreter* interpreter, const char* raw_string, Token* string_token_for_errors) {
+    // A literal from a source unit keeps its compiled template, or its value when it has
+    // no interpolations, on its cache entry.
+    SourceUnitToken* entry = NULL;
+    Value val;
+    val.type = VAL_STRING;
+    if (string_token_for_errors && string_token_for_errors->is_borrowed && string_token_for_errors->value == raw_string) {
+        entry = (SourceUnitToken*)string_token_for_errors; // Borrowed tokens live inside their cache entry
+        if (entry->literal_string) {
+            val.as.string_val = string_value_retain(entry->literal_string);
+            return val;
+        }
+        if (entry->string_template) return string_template_render(interpreter, entry->string_template, string_token_for_errors);
+    }
+
     // If the string does not contain a '%', it cannot have an interpolation block.
-    // In this common case, we can skip the complex dynamic string logic and just duplicate the string.
+    // In this common case, we can skip the template and just copy the string.
     if (strchr(raw_string, '%') == NULL) {
-        Value val;
-        val.type = VAL_STRING;
-        val.as.string_val = strdup(raw_string);
-        if (!val.as.string_val) report_error("System", "Failed to strdup non-interpolated string.", string_token_for_errors);
+        val.as.string_val = string_value_create(raw_string);
+        if (entry) entry->literal_string = string_value_retain(val.as.string_val);
         return val;
     }
 
-    DynamicString ds;
-    memset(&ds, 0, sizeof(DynamicString)); // Initialize to zero
-    ds_init(&ds, strlen(raw_string) + 64); // Initial guess for capacity
-
-    DEBUG_PRINTF("INTERPOLATE_STRING: Raw: \"%s\". At line %d, col %d. Current scope: %p",
-                 raw_string,
-                 string_token_for_errors->line,
-                 string_token_for_errors->col,
-                 (void*)interpreter->current_scope);
-
-    // Add error handling for ds_init failure
-    if (!ds.buffer) {
-        ds_free(&ds);
-        report_error("System", "Failed to initialize dynamic string for interpolation", string_token_for_errors);
+    StringTemplate* tmpl = string_template_compile(raw_string, string_token_for_errors);
+    if (entry) {
+        entry->string_template = tmpl;
+        return string_template_render(interpreter, tmpl, string_token_for_errors);
     }
-
-    // string_token_for_errors is the original TOKEN_STRING, useful for errors like unterminated %{
-    const char* p = raw_string;
-    while (*p) {
-        if (p[0] == '%' && p[1] == '{') { // Found an interpolation start
-            p += 2; // Skip "%{"
-
-            const char* expr_content_start = p;
-
-            // --- START OF NEW BLOCK ---
-            const char* expr_scan_ptr = p; // p is currently at the start of the expression content
-            int brace_level = 1;   // Start at 1 to account for the opening '{' of %{
-            int bracket_level = 0;  // For []
-            int paren_level = 0;    // For ()
-
-            while (*expr_scan_ptr != '\0') {
-                char c = *expr_scan_ptr;
-
-                // Skip over any nested strings within the expression
-                if (c == '"' || c == '\'') {
-                    char quote_type = c;
-                    expr_scan_ptr++; // Move past opening quote
-                    while (*expr_scan_ptr != '\0' && *expr_scan_ptr != quote_type) {
-                        if (*expr_scan_ptr == '\\') {
-                            expr_scan_ptr++; // Skip escaped character
-                        }
-                        if (*expr_scan_ptr == '\0') break; // Avoid incrementing past null terminator
-                        expr_scan_ptr++;
-                    }
-                    if (*expr_scan_ptr == '\0') { // Unterminated string inside expression
-                        ds_free(&ds);
-                        report_error("Syntax", "Unterminated string literal within interpolated expression.", string_token_for_errors);
-                    }
-                    // After loop, expr_scan_ptr is on the closing quote. Advance past it.
-                    expr_scan_ptr++;
-                    // Continue to the next outer loop iteration to avoid the final expr_scan_ptr++
-                    continue;
-                } else if (c == '{') {
-                    brace_level++;
-                } else if (c == '}') {
-                    brace_level--;
-                    if (brace_level < 0) { // Mismatched '}'
-                        ds_free(&ds);
-                        report_error("Syntax", "Mismatched '}' in interpolated expression.", string_token_for_errors);
-                    }
-                    if (brace_level == 0) {
-                        // Found the matching brace for our %{
-                        // Now, ensure other brackets are balanced for a valid expression
-                        if (bracket_level != 0 || paren_level != 0) {
-                            ds_free(&ds);
-                            report_error("Syntax", "Mismatched brackets/parentheses within balanced %{...} in interpolated expression.", string_token_for_errors);
-                        }
-                        p = expr_scan_ptr; // Set p to the position of the closing brace
-                        break; // Exit the scanning loop
-                    }
-                } else if (c == '[') {
-                    bracket_level++;
-                } else if (c == ']') {
-                    bracket_level--;
-                    if (bracket_level < 0) { // Mismatched ']'
-                        ds_free(&ds);
-                        report_error("Syntax", "Mismatched ']' in interpolated expression.", string_token_for_errors);
-                    }
-                } else if (c == '(') {
-                    paren_level++;
-                } else if (c == ')') {
-                    paren_level--;
-                    if (paren_level < 0) { // Mismatched ')'
-                        ds_free(&ds);
-                        report_error("Syntax", "Mismatched ')' in interpolated expression.", string_token_for_errors);
-                    }
-                }
-                expr_scan_ptr++;
-            }
-            // After the loop, if 'p' hasn't been updated to point to the closing '}',
-            // it means the loop terminated due to *expr_scan_ptr == '\0' before finding the match.
-            // The original 'p' (before this block) pointed to the start of the expression content.
-            // If the break was hit, 'p' now points to the '}'.
-            if (*p != '}' || p < expr_content_start) { // Check if p was updated and points to '}'
-                ds_free(&ds);
-                report_error("Syntax", "Unterminated '%{' in string interpolation (matching '}' not found).", string_token_for_errors);
-            }
-            
-            size_t expr_len = (size_t)(p - expr_content_start);
-            char* expr_str_for_parsing = malloc(expr_len + 1);
-            if (!expr_str_for_parsing) {
-                ds_free(&ds);
-                report_error("System", "Failed to allocate memory for interpolated expression string.", string_token_for_errors);
-            }
-            // Ensure null termination even if strncpy doesn't fill the buffer
-            if (expr_len < expr_len + 1) { // Check to prevent writing out of bounds if expr_len is SIZE_MAX
-                 expr_str_for_parsing[expr_len] = '\0';
-            }
-            strncpy(expr_str_for_parsing, expr_content_start, expr_len);
-            expr_str_for_parsing[expr_len] = '\0';
-            DEBUG_PRINTF("  Interpolating expression: '%s'", expr_str_for_parsing);
-
-            // --- START: New, Safer Sub-Expression Evaluation ---
-
-            // 1. Save the main interpreter's current lexer and token.
-            Lexer* old_lexer = interpreter->lexer;
-            Token* old_main_token = interpreter->current_token;
-
-            // 2. Create a temporary lexer instance on the stack for the expression string.
-            Lexer temp_expr_lexer;
-            temp_expr_lexer.text = expr_str_for_parsing;
-            temp_expr_lexer.pos = 0;
-            temp_expr_lexer.current_char = expr_str_for_parsing[0];
-            temp_expr_lexer.line = 1; // Parse as a self-contained unit
-            temp_expr_lexer.col = 1;
-            temp_expr_lexer.text_length = expr_len;
-
-            // 3. Temporarily point the main interpreter to our new lexer and get the first token.
-            interpreter->lexer = &temp_expr_lexer;
-            interpreter->current_token = get_next_token(interpreter->lexer); // This overwrites the pointer, which is fine since we saved it.
-
-            // 4. Evaluate the expression using the main interpreter, which now has its full context
-            //    but is reading from our temporary string.
-            ExprResult sub_expr_res = interpret_expression(interpreter);
-            
-            // Check if the sub-expression evaluation raised an exception.
-            if (interpreter->exception_is_active || (interpreter->current_executing_coroutine && interpreter->current_executing_coroutine->state == CORO_SUSPENDED_AWAIT)) {
-                // An error occurred. We must stop interpolation immediately.
-                DEBUG_PRINTF("INTERPOLATE_STRING: Exception or Yield detected during sub-expression evaluation. Aborting.%s", "");
-                
-                // The sub-interpreter run failed, but we must clean up the resources for this interpolation.
-                // Clean up resources allocated by this function.
-                ds_free(&ds);
-                free(expr_str_for_parsing);
-                if (sub_expr_res.is_freshly_created_container) {
-                    free_value_contents(sub_expr_res.value);
-                }
-
-                // Restore the interpreter's original state.
-                interpreter->lexer = old_lexer;
-                free_token(interpreter->current_token); // Free the token from the temp lexer
-                interpreter->current_token = old_main_token; // Restore the original token pointer
-
-                // Return a dummy value. The caller (e.g., interpret_primary_expr)
-                // must also check the exception_is_active flag and handle it.
-                // This ensures the caller knows an error occurred and can abort correctly.
-                interpreter->exception_is_active = 1;
-                return create_null_value();
-            }
-
-            // 5. Clean up and restore the interpreter's state.
-            free_token(interpreter->current_token); // Free the EOF token from the sub-expression.
-
-            interpreter->lexer = old_lexer; // Restore the original lexer pointer.
-            interpreter->current_token = old_main_token; // Restore the original token pointer.
-
-            // --- END: New, Safer Sub-Expression Evaluation ---
-
-            // If sub_expr_res evaluation caused an error, interpret_expression would call report_error and exit.
-            // So, if we are here, the sub-expression was evaluated successfully (or returned a dummy on error if report_error didn't exit).
-
-            Value resolved_value = sub_expr_res.value;
-            bool resolved_value_is_owned = sub_expr_res.is_freshly_created_container;
-            // Cleanup token from temp_interpreter_instance (should be EOF from sub-expression)
-            // Convert the resolved value to its string representation
-            char* var_str_repr = value_to_string_representation(resolved_value, interpreter, string_token_for_errors);
-
-            // Check if value_to_string_representation (e.g., via op_str) raised an exception.
-            if (interpreter->exception_is_active) {
-                // An error occurred while converting the sub-expression's result to a string. Clean up.
-                free(var_str_repr); // Free the placeholder string from the failed call.
-                ds_free(&ds);
-                free(expr_str_for_parsing);
-                if (resolved_value_is_owned) free_value_contents(resolved_value);
-                // The interpreter's lexer and token are already restored by the sub-expression evaluation logic.
-                // We just need to return a dummy value; the caller will see the exception flag.
-                return create_null_value();
-            }
-
-            ds_append_str(&ds, var_str_repr);
-            free(var_str_repr);
-
-            // Free the resolved value if it was freshly created by the sub-expression
-            if (resolved_value_is_owned) {
-                free_value_contents(resolved_value);
-            }
-
-            free(expr_str_for_parsing); // Free the malloc'd expression string after use.
-
-            p++; // Skip "}"
-        } else {
-            ds_ensure_capacity(&ds, 1);
-            ds.buffer[ds.length++] = *p;
-            ds.buffer[ds.length] = '\0';
-            p++;
-        }
-    }
-	Value final_val;
-	final_val.type = VAL_STRING;
-	// ds_finalize transfers ownership, so no need to call ds_free after this
-	final_val.as.string_val = ds_finalize(&ds);
-    // This function should not modify the caller's token stream.
-    // The state is restored inside the loop, but if the loop is empty (no interpolation),
-    // we ensure the state is consistent here. The caller is responsible for advancing its own token.
-    return final_val;
+    // Ad-hoc text (no cache entry to hold the template): compile, render, discard.
+    Value result = string_template_render(interpreter, tmpl, string_token_for_errors);
+    string_template_free(tmpl);
+    return result;
 }
 
 // Helper to free a single TryCatchFrame and its contents
@@ -723,7 +555,14 @@ void coroutine_decref_and_free_if_zero(Coroutine* coro) {
         free_value_contents(coro->result_value);
         free_value_contents(coro->exception_value);
         free_value_contents(coro->value_from_await);
-        if (coro->yielding_await_token) free_token(coro->yielding_await_token);
+        if (coro->context) {
+            // Still suspended at an 'await' that will never complete: drop its stack and saved registers.
+            free_token(coro->saved_registers.current_token);
+            free_value_contents(coro->saved_registers.current_function_return_value);
+            free_value_contents(coro->saved_registers.current_exception);
+            coro_context_free(coro->context);
+        }
+        arena_free(&coro->scratch);
 
 
         // Free the try-catch stack associated with the coroutine
@@ -744,4 +583,159 @@ void coroutine_decref_and_free_if_zero(Coroutine* coro) {
         // Phase 3: Finally, free the coroutine struct itself
         free(coro);
     }
-}
\ No newline at end of file
+}
+long range_length(const Range* range) {
+    if (range->step > 0 && range->start < range->stop) {
+        return (long)(((unsigned long)range->stop - (unsigned long)range->start - 1) / (unsigned long)range->step + 1);
+    }
+    if (range->step < 0 && range->start > range->stop) {
+        return (long)(((unsigned long)range->start - (unsigned long)range->stop - 1) / (0UL - (unsigned long)range->step) + 1);
+    }
+    return 0;
+}
+
+const char* value_concat_text(Value operand, char* buffer, size_t buffer_size, size_t* length) {
+    switch (operand.type) {
+        case VAL_STRING:
+            *length = string_value_length(operand.as.string_val);
+            return operand.as.string_val;
+        case VAL_INT:
+            *length = (size_t)snprintf(buffer, buffer_size, "%ld", operand.as.integer);
+            return buffer;
+        case VAL_FLOAT:
+            *length = (size_t)snprintf(buffer, buffer_size, "%g", operand.as.floating);
+            return buffer;
+        case VAL_BOOL:
+            *length = operand.as.bool_val ? 4 : 5;
+            return operand.as.bool_val ? "true" : "false";
+        default:
+            return NULL;
+    }
+}
+
+Value value_unshared_copy(Value val) {
+    if (val.type == VAL_ARRAY && val.as.array_val) {
+        Value copy = value_deep_copy(val);
+        value_make_unique(&copy);
+        for (int i = 0; i < copy.as.array_val->count; ++i) {
+            Value element = copy.as.array_val->elements[i];
+            copy.as.array_val->elements[i] = value_unshared_copy(element);
+            free_value_contents(element);
+        }
+        return copy;
+    }
+    if (val.type == VAL_TUPLE && val.as.tuple_val) {
+        Value copy = value_deep_copy(val);
+        value_make_unique(&copy);
+        for (int i = 0; i < copy.as.tuple_val->count; ++i) {
+            Value element = copy.as.tuple_val->elements[i];
+            copy.as.tuple_val->elements[i] = value_unshared_copy(element);
+            free_value_contents(element);
+        }
+        return copy;
+    }
+    if (val.type == VAL_DICT && val.as.dict_val) {
+        Value copy = value_deep_copy(val);
+        value_make_unique(&copy);
+        Dictionary* dict = copy.as.dict_val;
+        for (int i = 0; i < dict->count; ++i) {
+            Value element = dict->entries[i].value;
+            dict->entries[i].value = value_unshared_copy(element);
+            free_value_contents(element);
+        }
+        return copy;
+    }
+    if (val.type == VAL_PACKED_ARRAY && val.as.packed_array_val) {
+        Value copy = value_deep_copy(val);
+        value_make_unique(&copy);
+        return copy;
+    }
+    return value_deep_copy(val);
+}
+
+void value_make_unique(Value* slot) {
+    if (slot->type == VAL_ARRAY && slot->as.array_val && slot->as.array_val->ref_count > 1) {
+        Array* shared = slot->as.array_val;
+        Array* clone = malloc(sizeof(Array));
+        if (!clone) report_error("System", "Failed to allocate memory for array copy", NULL);
+        clone->count = shared->count;
+        clone->capacity = shared->capacity > 0 ? shared->capacity : 1;
+        clone->ref_count = 1;
+        clone->elements = malloc(clone->capacity * sizeof(Value));
+        if (!clone->elements) { free(clone); report_error("System", "Failed to allocate memory for copied array elements", NULL); }
+        for (int i = 0; i < shared->count; ++i) {
+            clone->elements[i] = value_deep_copy(shared->elements[i]); // Nested containers stay shared
+        }
+        shared->ref_count--;
+        slot->as.array_val = clone;
+    } else if (slot->type == VAL_DICT && slot->as.dict_val && slot->as.dict_val->ref_count > 1) {
+        Dictionary* shared = slot->as.dict_val;
+        Dictionary* clone = dictionary_copy(shared, NULL);
+        shared->ref_count--;
+        slot->as.dict_val = clone;
+    } else if (slot->type == VAL_TUPLE && slot->as.tuple_val && slot->as.tuple_val->ref_count > 1) {
+        // Tuples are immutable themselves, but may hold a container being mutated through them.
+        Tuple* shared = slot->as.tuple_val;
+        Tuple* clone = malloc(sizeof(Tuple));
+        if (!clone) report_error("System", "Failed to allocate memory for tuple copy", NULL);
+        clone->count = shared->count;
+        clone->ref_count = 1;
+        clone->elements = NULL;
+        if (shared->count > 0) {
+            clone->elements = malloc(shared->count * sizeof(Value));
+            if (!clone->elements) { free(clone); report_error("System", "Failed to allocate memory for copied tuple elements", NULL); }
+            for (int i = 0; i < shared->count; ++i) {
+                clone->elements[i] = value_deep_copy(shared->elements[i]);
+            }
+        }
+        shared->ref_count--;
+        slot->as.tuple_val = clone;
+    } else if (slot->type == VAL_PACKED_ARRAY && slot->as.packed_array_val && slot->as.packed_array_val->ref_count > 1) {
+        PackedArray* shared = slot->as.packed_array_val;
+        slot->as.packed_array_val = packed_array_clone(shared);
+        shared->ref_count--;
+    }
+}
+
+Value* value_make_path_unique(Value* root, const Value* indices, int index_count) {
+    value_make_unique(root);
+    Value* current = root;
+    for (int i = 0; i < index_count; ++i) {
+        if (current->type == VAL_ARRAY && indices[i].type == VAL_INT) {
+            Array* arr = current->as.array_val;
+            long idx = indices[i].as.integer;
+            if (idx < 0) idx += arr->count;
+            if (idx < 0 || idx >= arr->count) return NULL;
+            current = &arr->elements[idx];
+        } else if (current->type == VAL_DICT && indices[i].type == VAL_STRING) {
+            current = dictionary_try_get_value_ptr_hashed(current->as.dict_val, indices[i].as.string_val, string_value_hash(indices[i].as.string_val));
+            if (!current) return NULL;
+        } else {
+            return NULL;
+        }
+        value_make_unique(current);
+    }
+    return current;
+}
+
+Value* value_make_slots_unique(Value** slots, int slot_count) {
+    for (int i = 0; i < slot_count; ++i) {
+        Value* slot = slots[i];
+        Array* old_array = slot->type == VAL_ARRAY ? slot->as.array_val : NULL;
+        Tuple* old_tuple = slot->type == VAL_TUPLE ? slot->as.tuple_val : NULL;
+        Dictionary* old_dict = slot->type == VAL_DICT ? slot->as.dict_val : NULL;
+        value_make_unique(slot);
+        if (i + 1 == slot_count) break;
+        // The next slot pointed into the old container; find its counterpart in the clone.
+        if (old_array && slot->as.array_val != old_array) {
+            slots[i + 1] = &slot->as.array_val->elements[slots[i + 1] - old_array->elements];
+        } else if (old_tuple && slot->as.tuple_val != old_tuple) {
+            slots[i + 1] = &slot->as.tuple_val->elements[slots[i + 1] - old_tuple->elements];
+        } else if (old_dict && slot->as.dict_val != old_dict) {
+            // Copies keep entry positions, so the entry index carries over.
+            DictEntry* entry = (DictEntry*)((char*)slots[i + 1] - offsetof(DictEntry, value));
+            slots[i + 1] = &slot->as.dict_val->entries[entry - old_dict->entries].value;
+        }
+    }
+    return slot_count > 0 ? slots[slot_count - 1] : NULL;
+}
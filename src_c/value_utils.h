@@ -16,23 +16,52 @@ char* ds_finalize(DynamicString* ds);
 void ds_free(DynamicString* ds);
 // --- End DynamicString Helper ---
 
+#define MAX_REPR_DEPTH 8 // Nesting at which value_to_string_representation abbreviates containers
+
 // Converts a Value to its string representation.
 // The caller is responsible for freeing the returned string.
 char* value_to_string_representation(Value val, Interpreter* interpreter, Token* error_token_context);
 
 // Evaluates a string literal that may contain %{variable} interpolations.
+// Literals from a source unit are compiled into a template once and cached on their token.
 // Returns a new VAL_STRING Value. The caller is responsible for its contents.
 Value evaluate_interpolated_string(Interpreter* interpreter, const char* raw_string, Token* string_token_for_errors);
 
+// Number of integers a range yields (0 when empty).
+long range_length(const Range* range);
+
+// The text '+' concatenates for 'operand': a string's own characters, "true"/"false"
+// for a bool as in interpolation, or an int (%ld) or float (%g) formatted into 'buffer'.
+// Stores its length in '*length'. Returns NULL for any other type.
+const char* value_concat_text(Value operand, char* buffer, size_t buffer_size, size_t* length);
+
 void coroutine_decref_and_free_if_zero(Coroutine* coro);
 
 // Increments coroutine ref_count.
 void coroutine_incref(Coroutine* coro);
 
-// Deep copies a Value. For container types (Array, Dict, etc.),
-// new memory is allocated for the container and its elements are deep-copied.
-// For reference-counted types like Coroutine, the ref_count is incremented.
+// Copies a Value with value semantics. Functions are duplicated; strings, arrays,
+// tuples, dicts, objects and coroutines are shared by incrementing their ref_count
+// (containers are un-shared on mutation, see value_make_unique, and strings on append).
 // The caller is responsible for freeing the returned Value's contents.
 Value value_deep_copy(Value val);
 
+// Copies 'val' without sharing any array, tuple or dict at any depth.
+Value value_unshared_copy(Value val);
+
+// Copy-on-write: if the array, tuple or dict held in 'slot' is shared, replaces it with a
+// private shallow copy (elements are shared one level down) and drops one reference
+// to the original. Must be called on every container a mutation writes into.
+void value_make_unique(Value* slot);
+
+// Makes 'root' unique, then follows 'indices' (ints into arrays, string keys into dicts)
+// making each container on the way unique. Returns the last container reached, or NULL
+// if an index no longer resolves.
+Value* value_make_path_unique(Value* root, const Value* indices, int index_count);
+
+// Like value_make_path_unique for a chain of slot pointers, where slots[i + 1] lies
+// inside the container held in slots[i]. Re-points each slot into the copies made
+// along the way and returns the final one.
+Value* value_make_slots_unique(Value** slots, int slot_count);
+
 #endif // ECHOC_VALUE_UTILS_H
\ No newline at end of file